@@ -96,6 +96,9 @@ Adafruit_BusIO_Register::Adafruit_BusIO_Register(
  * uncheckable)
  */
 bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  if (buffer != _buffer) {
+    _cache_valid = false; // raw data, _cached no longer matches
+  }
 
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
@@ -158,7 +161,9 @@ bool Adafruit_BusIO_Register::write(uint32_t value, uint8_t numbytes) {
     }
     value >>= 8;
   }
-  return write(_buffer, numbytes);
+  bool ok = write(_buffer, numbytes);
+  _cache_valid = ok && (numbytes == _width);
+  return ok;
 }
 
 /*!
@@ -167,6 +172,9 @@ bool Adafruit_BusIO_Register::write(uint32_t value, uint8_t numbytes) {
  *    @return Returns 0xFFFFFFFF on failure, value otherwise
  */
 uint32_t Adafruit_BusIO_Register::read(void) {
+  if (_cache_enabled && _cache_valid) {
+    return _cached;
+  }
   if (!read(_buffer, _width)) {
     return -1;
   }
@@ -182,6 +190,10 @@ uint32_t Adafruit_BusIO_Register::read(void) {
     }
   }
 
+  if (_cache_enabled) {
+    _cached = value;
+    _cache_valid = true;
+  }
   return value;
 }
 
@@ -191,6 +203,22 @@ uint32_t Adafruit_BusIO_Register::read(void) {
  */
 uint32_t Adafruit_BusIO_Register::readCached(void) { return _cached; }
 
+/*!
+ *    @brief  Let read() answer from the value last written or read, so a
+ *    read-modify-write (e.g. Adafruit_BusIO_RegisterBits::write()) costs
+ *    one bus write. Only for registers nothing but the host changes.
+ *    @param  enable True to use the cache, false to always read the device
+ */
+void Adafruit_BusIO_Register::enableCache(bool enable) {
+  _cache_enabled = enable;
+}
+
+/*!
+ *    @brief  Forget the cached value, e.g. after the device was reset. The
+ *    next read() goes to the device.
+ */
+void Adafruit_BusIO_Register::invalidate(void) { _cache_valid = false; }
+
 /*!
  *    @brief  Read a buffer of data from the register location
  *    @param  buffer Pointer to data to read into
@@ -62,6 +62,8 @@ public:
   bool read(uint16_t *value);
   uint32_t read(void);
   uint32_t readCached(void);
+  void enableCache(bool enable = true);
+  void invalidate(void);
   bool write(uint8_t *buffer, uint8_t len);
   bool write(uint32_t value, uint8_t numbytes = 0);
 
@@ -83,6 +85,8 @@ private:
   uint8_t _buffer[4]; // we won't support anything larger than uint32 for
                       // non-buffered read
   uint32_t _cached = 0;
+  bool _cache_enabled = false; ///< read() may answer from _cached
+  bool _cache_valid = false;   ///< _cached holds the register's value
 };
 
 /*!
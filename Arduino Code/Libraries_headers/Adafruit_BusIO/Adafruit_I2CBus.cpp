@@ -0,0 +1,306 @@
+#include "Adafruit_I2CBus.h"
+#include "Adafruit_I2CDevice.h"
+
+Adafruit_I2CBus *Adafruit_I2CBus::_first = NULL;
+
+/*!
+ *    @brief  Create the arbiter for one I2C bus. Once begin() is called,
+ *    every Adafruit_I2CDevice on the same TwoWire that is begun afterwards
+ *    routes its transactions through it:
+ *
+ *    - each device runs at the clock it asked for with setSpeed() (or the
+ *      bus default), and SCL is only reprogrammed when the device changes
+ *    - long transfers (display flushes) call preempt() between chunks, so
+ *      a waiting higher priority device (the keypad) gets the bus within
+ *      one chunk instead of after the whole frame
+ *    - on ESP32, transactions from several tasks are serialized, and a
+ *      waiting task of higher priority is served first
+ *
+ *    Example:
+ *
+ *        Adafruit_I2CBus bus(&Wire);
+ *        bus.begin();                       // before the devices
+ *        bus.setPriority(0x34, I2CBUS_PRIORITY_INPUT);  // keypad
+ *        display.begin(0x3C);
+ *        keypad.begin(0x34, &Wire);
+ *
+ *    @param  theWire The TwoWire the devices are on
+ *    @param  clock SCL frequency for devices that never call setSpeed()
+ */
+Adafruit_I2CBus::Adafruit_I2CBus(TwoWire *theWire, uint32_t clock) {
+  _wire = theWire;
+  _next = NULL;
+  _default_clock = _clock = clock;
+  _switches = _preemptions = 0;
+  _device = NULL;
+  _holder_priority = I2CBUS_PRIORITY_NORMAL;
+  _depth = 0;
+  _prio_count = 0;
+  _service = NULL;
+  _service_arg = NULL;
+  _service_pending = false;
+#ifdef I2CBUS_HAS_RTOS
+  _lock = NULL;
+  _owner = NULL;
+  _service_task = NULL;
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+  for (uint8_t p = 0; p < I2CBUS_PRIORITIES; p++) {
+    _waiting[p] = 0;
+  }
+#endif
+}
+
+/*!
+ *    @brief  Stop arbitrating. Devices already begun keep a pointer to
+ *    the bus, so only destroy it after them.
+ */
+Adafruit_I2CBus::~Adafruit_I2CBus(void) {
+  for (Adafruit_I2CBus **b = &_first; *b; b = &(*b)->_next) {
+    if (*b == this) {
+      *b = _next;
+      break;
+    }
+  }
+#ifdef I2CBUS_HAS_RTOS
+  if (_lock) {
+    vSemaphoreDelete(_lock);
+  }
+#endif
+}
+
+/*!
+ *    @brief  Start the bus at the default clock and make it the arbiter
+ *    for its TwoWire
+ *    @return False if the bus lock could not be allocated
+ */
+bool Adafruit_I2CBus::begin(void) {
+#ifdef I2CBUS_HAS_RTOS
+  if (!_lock && !(_lock = xSemaphoreCreateMutex())) {
+    return false;
+  }
+#endif
+  if (!find(_wire)) {
+    _next = _first;
+    _first = this;
+  }
+  _wire->begin();
+#if (ARDUINO >= 157) && !defined(ARDUINO_STM32_FEATHER) && !defined(TinyWireM_h)
+  _wire->setClock(_default_clock);
+#endif
+  _clock = _default_clock;
+  _device = NULL;
+  _switches = _preemptions = 0;
+  return true;
+}
+
+/*!
+ *    @brief  Set how urgently a device's transactions are served
+ *    @param  addr 7-bit address of the device
+ *    @param  priority One of the I2CBUS_PRIORITY_ levels
+ *    @return False if the priority table is full
+ */
+bool Adafruit_I2CBus::setPriority(uint8_t addr, uint8_t priority) {
+  if (priority >= I2CBUS_PRIORITIES) {
+    priority = I2CBUS_PRIORITIES - 1;
+  }
+  for (uint8_t i = 0; i < _prio_count; i++) {
+    if (_prio_addr[i] == addr) {
+      _prio_level[i] = priority;
+      return true;
+    }
+  }
+  if (_prio_count == I2CBUS_MAX_PRIORITIES) {
+    return false;
+  }
+  _prio_addr[_prio_count] = addr;
+  _prio_level[_prio_count++] = priority;
+  return true;
+}
+
+/*!
+ *    @brief  Look up a device's priority
+ *    @param  addr 7-bit address of the device
+ *    @return The level set with setPriority(), I2CBUS_PRIORITY_NORMAL if
+ *            none was
+ */
+uint8_t Adafruit_I2CBus::priority(uint8_t addr) {
+  for (uint8_t i = 0; i < _prio_count; i++) {
+    if (_prio_addr[i] == addr) {
+      return _prio_level[i];
+    }
+  }
+  return I2CBUS_PRIORITY_NORMAL;
+}
+
+/*!
+ *    @brief  Take the bus for a device at its own priority
+ *    @param  dev The device about to transfer
+ *    @return True once the bus is held
+ */
+bool Adafruit_I2CBus::acquire(Adafruit_I2CDevice *dev) {
+  return acquire(dev, priority(dev->address()));
+}
+
+/*!
+ *    @brief  Take the bus, waiting while it is held by another task or
+ *    while a task of higher priority is waiting for it, and switch SCL to
+ *    the device's clock. Calls nest: the bus is let go by the matching
+ *    number of release() calls.
+ *    @param  dev The device about to transfer
+ *    @param  priority I2CBUS_PRIORITY_ level to wait at, and to hold the
+ *            bus at for preempt()
+ *    @return True once the bus is held
+ */
+bool Adafruit_I2CBus::acquire(Adafruit_I2CDevice *dev, uint8_t priority) {
+  if (priority >= I2CBUS_PRIORITIES) {
+    priority = I2CBUS_PRIORITIES - 1;
+  }
+#ifdef I2CBUS_HAS_RTOS
+  TaskHandle_t me = xTaskGetCurrentTaskHandle();
+  if (_owner != me) {
+    portENTER_CRITICAL(&_mux);
+    _waiting[priority]++;
+    portEXIT_CRITICAL(&_mux);
+    for (;;) {
+      xSemaphoreTake(_lock, portMAX_DELAY);
+      if (!_higherWaiting(priority)) {
+        break;
+      }
+      // let the more urgent task have it first
+      xSemaphoreGive(_lock);
+      vTaskDelay(1);
+    }
+    portENTER_CRITICAL(&_mux);
+    _waiting[priority]--;
+    portEXIT_CRITICAL(&_mux);
+    _owner = me;
+  }
+#endif
+  if (!_depth++) {
+    _holder_priority = priority;
+  }
+  _select(dev);
+  return true;
+}
+
+/*!
+ *    @brief  Let go of the bus taken by acquire()
+ */
+void Adafruit_I2CBus::release(void) {
+  if (!_depth || --_depth) {
+    return;
+  }
+#ifdef I2CBUS_HAS_RTOS
+  _owner = NULL;
+  xSemaphoreGive(_lock);
+#endif
+}
+
+/*!
+ *    @brief  Called by the holder of the bus between the chunks of a long
+ *    transfer. Runs the service handler if requestService() was called
+ *    and the holder is the task that set it, and on ESP32 hands the bus to any task waiting at a higher priority,
+ *    then takes it back and restores the holder's clock.
+ *    @return True if anything else used the bus
+ */
+bool Adafruit_I2CBus::preempt(void) {
+  if (!_depth) {
+    return false;
+  }
+  Adafruit_I2CDevice *dev = _device;
+  uint8_t priority = _holder_priority;
+  uint8_t depth = _depth;
+  bool preempted = false;
+
+  bool service = _service_pending && _service &&
+                 (priority < I2CBUS_PRIORITY_INPUT);
+#ifdef I2CBUS_HAS_RTOS
+  // a flush running in its own task leaves the request to the owner
+  service = service && (xTaskGetCurrentTaskHandle() == _service_task);
+#endif
+  if (service) {
+    _service_pending = false;
+    _service(_service_arg); // its devices nest inside our hold
+    preempted = true;
+  }
+
+#ifdef I2CBUS_HAS_RTOS
+  if (_higherWaiting(priority)) {
+    _depth = 0;
+    _owner = NULL;
+    xSemaphoreGive(_lock);
+    acquire(dev, priority); // queues behind the more urgent task
+    preempted = true;
+  }
+#endif
+
+  if (preempted) {
+    _preemptions++;
+    _depth = depth;
+    _holder_priority = priority;
+    _select(dev);
+  }
+  return preempted;
+}
+
+/*!
+ *    @brief  Set the function preempt() runs when requestService() was
+ *    called, e.g. one that drains the keypad FIFO. This is how a single
+ *    threaded sketch gets input served in the middle of a display flush.
+ *    On ESP32 the handler only runs when the bus is held by the task that
+ *    set it, so a flush in another task (enableAsyncDisplay()) never
+ *    drains the keypad behind the back of loop().
+ *    @param  handler Function to call, NULL for none
+ *    @param  arg Passed to the handler
+ */
+void Adafruit_I2CBus::setServiceHandler(void (*handler)(void *), void *arg) {
+  _service = handler;
+  _service_arg = arg;
+#ifdef I2CBUS_HAS_RTOS
+  _service_task = xTaskGetCurrentTaskHandle();
+#endif
+}
+
+/*!
+ *    @brief  Ask for the service handler to run at the next preemption
+ *    point. Safe to call from an interrupt handler.
+ */
+void Adafruit_I2CBus::requestService(void) { _service_pending = true; }
+
+/*!
+ *    @brief  Find the arbiter of a TwoWire
+ *    @param  theWire The bus
+ *    @return The Adafruit_I2CBus begun on it, or NULL if there is none
+ */
+Adafruit_I2CBus *Adafruit_I2CBus::find(TwoWire *theWire) {
+  for (Adafruit_I2CBus *b = _first; b; b = b->_next) {
+    if (b->_wire == theWire) {
+      return b;
+    }
+  }
+  return NULL;
+}
+
+void Adafruit_I2CBus::_select(Adafruit_I2CDevice *dev) {
+  _device = dev;
+  uint32_t clock = (dev && dev->speed()) ? dev->speed() : _default_clock;
+  if (clock == _clock) {
+    return;
+  }
+#if (ARDUINO >= 157) && !defined(ARDUINO_STM32_FEATHER) && !defined(TinyWireM_h)
+  _wire->setClock(clock);
+#endif
+  _clock = clock;
+  _switches++;
+}
+
+#ifdef I2CBUS_HAS_RTOS
+bool Adafruit_I2CBus::_higherWaiting(uint8_t priority) {
+  for (uint8_t p = priority + 1; p < I2CBUS_PRIORITIES; p++) {
+    if (_waiting[p]) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif
@@ -0,0 +1,85 @@
+#ifndef Adafruit_I2CBus_h
+#define Adafruit_I2CBus_h
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define I2CBUS_HAS_RTOS ///< Transactions from several tasks are arbitrated
+#endif
+
+#define I2CBUS_PRIORITY_BULK 0   ///< Long transfers, e.g. display data
+#define I2CBUS_PRIORITY_NORMAL 1 ///< Default for every device
+#define I2CBUS_PRIORITY_INPUT 2  ///< Latency sensitive, e.g. keypad events
+#define I2CBUS_PRIORITIES 3      ///< Number of priority levels
+
+/// Devices one bus can hold a priority for
+#define I2CBUS_MAX_PRIORITIES 8
+
+class Adafruit_I2CDevice;
+
+///< Owner of one TwoWire that every Adafruit_I2CDevice on it goes through
+class Adafruit_I2CBus {
+public:
+  Adafruit_I2CBus(TwoWire *theWire = &Wire, uint32_t clock = 100000);
+  ~Adafruit_I2CBus(void);
+
+  bool begin(void);
+  bool setPriority(uint8_t addr, uint8_t priority);
+  uint8_t priority(uint8_t addr);
+
+  bool acquire(Adafruit_I2CDevice *dev, uint8_t priority);
+  bool acquire(Adafruit_I2CDevice *dev);
+  void release(void);
+  bool preempt(void);
+
+  void setServiceHandler(void (*handler)(void *), void *arg = NULL);
+  void requestService(void);
+
+  /*!   @brief  How often the SCL clock was actually changed
+   *    @return Clock switches since begin() */
+  uint32_t clockSwitches(void) { return _switches; }
+
+  /*!   @brief  How often a bulk holder gave the bus away between chunks
+   *    @return Preemptions since begin() */
+  uint32_t preemptions(void) { return _preemptions; }
+
+  static Adafruit_I2CBus *find(TwoWire *theWire);
+
+private:
+  void _select(Adafruit_I2CDevice *dev);
+
+  TwoWire *_wire;
+  Adafruit_I2CBus *_next;
+  uint32_t _default_clock, _clock;
+  uint32_t _switches, _preemptions;
+
+  Adafruit_I2CDevice *_device; ///< Device whose clock is on the bus
+  uint8_t _holder_priority;
+  uint8_t _depth; ///< Nested acquire() calls of the current holder
+
+  uint8_t _prio_count;
+  uint8_t _prio_addr[I2CBUS_MAX_PRIORITIES];
+  uint8_t _prio_level[I2CBUS_MAX_PRIORITIES];
+
+  void (*_service)(void *);
+  void *_service_arg;
+  volatile bool _service_pending;
+
+#ifdef I2CBUS_HAS_RTOS
+  bool _higherWaiting(uint8_t priority);
+
+  SemaphoreHandle_t _lock;
+  TaskHandle_t _owner;
+  TaskHandle_t _service_task; ///< Task that set the service handler
+  portMUX_TYPE _mux;
+  volatile uint8_t _waiting[I2CBUS_PRIORITIES];
+#endif
+
+  static Adafruit_I2CBus *_first;
+};
+
+#endif // Adafruit_I2CBus_h
@@ -1,4 +1,5 @@
 #include "Adafruit_I2CDevice.h"
+#include "Adafruit_I2CBus.h"
 
 //#define DEBUG_SERIAL Serial
 
@@ -11,6 +12,8 @@ Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
   _addr = addr;
   _wire = theWire;
   _begun = false;
+  _bus = NULL;
+  _speed = 0;
 #ifdef ARDUINO_ARCH_SAMD
   _maxBufferSize = 250; // as defined in Wire.h's RingBuffer
 #else
@@ -19,14 +22,19 @@ Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
 }
 
 /*!
- *    @brief  Initializes and does basic address detection
+ *    @brief  Initializes and does basic address detection. If an
+ *    Adafruit_I2CBus was begun on the same TwoWire, all transfers from
+ *    here on go through it.
  *    @param  addr_detect Whether we should attempt to detect the I2C address
  * with a scan. 99% of sensors/devices don't mind but once in a while, they spaz
  * on a scan!
  *    @return True if I2C initialized and a device with the addr found
  */
 bool Adafruit_I2CDevice::begin(bool addr_detect) {
-  _wire->begin();
+  _bus = Adafruit_I2CBus::find(_wire);
+  if (!_bus) {
+    _wire->begin();
+  }
   _begun = true;
 
   if (addr_detect) {
@@ -64,8 +72,15 @@ bool Adafruit_I2CDevice::detected(void) {
   }
 
   // A basic scanner, see if it ACK's
+  if (_bus) {
+    _bus->acquire(this);
+  }
   _wire->beginTransmission(_addr);
-  if (_wire->endTransmission() == 0) {
+  uint8_t status = _wire->endTransmission();
+  if (_bus) {
+    _bus->release();
+  }
+  if (status == 0) {
 #ifdef DEBUG_SERIAL
     DEBUG_SERIAL.println(F("Detected"));
 #endif
@@ -93,6 +108,18 @@ bool Adafruit_I2CDevice::detected(void) {
 bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
                                const uint8_t *prefix_buffer,
                                size_t prefix_len) {
+  if (!_bus) {
+    return _write(buffer, len, stop, prefix_buffer, prefix_len);
+  }
+  _bus->acquire(this);
+  bool ok = _write(buffer, len, stop, prefix_buffer, prefix_len);
+  _bus->release();
+  return ok;
+}
+
+bool Adafruit_I2CDevice::_write(const uint8_t *buffer, size_t len, bool stop,
+                                const uint8_t *prefix_buffer,
+                                size_t prefix_len) {
   if ((len + prefix_len) > maxBufferSize()) {
     // currently not guaranteed to work if more than 32 bytes!
     // we will need to find out if some platforms have larger
@@ -172,16 +199,22 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
  *    @return True if read was successful, otherwise false.
  */
 bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  if (_bus) {
+    _bus->acquire(this);
+  }
   size_t pos = 0;
   while (pos < len) {
     size_t read_len =
         ((len - pos) > maxBufferSize()) ? maxBufferSize() : (len - pos);
     bool read_stop = (pos < (len - read_len)) ? false : stop;
     if (!_read(buffer + pos, read_len, read_stop))
-      return false;
+      break;
     pos += read_len;
   }
-  return true;
+  if (_bus) {
+    _bus->release();
+  }
+  return pos >= len;
 }
 
 bool Adafruit_I2CDevice::_read(uint8_t *buffer, size_t len, bool stop) {
@@ -236,11 +269,14 @@ bool Adafruit_I2CDevice::_read(uint8_t *buffer, size_t len, bool stop) {
 bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
                                          size_t write_len, uint8_t *read_buffer,
                                          size_t read_len, bool stop) {
-  if (!write(write_buffer, write_len, stop)) {
-    return false;
+  if (_bus) {
+    _bus->acquire(this); // no other device between write and read
   }
-
-  return read(read_buffer, read_len);
+  bool ok = write(write_buffer, write_len, stop) && read(read_buffer, read_len);
+  if (_bus) {
+    _bus->release();
+  }
+  return ok;
 }
 
 /*!
@@ -251,12 +287,17 @@ uint8_t Adafruit_I2CDevice::address(void) { return _addr; }
 
 /*!
  *    @brief  Change the I2C clock speed to desired (relies on
- *    underlying Wire support!
+ *    underlying Wire support! On an Adafruit_I2CBus the speed only
+ *    applies to this device, and is switched to when it next transfers.
  *    @param desiredclk The desired I2C SCL frequency
  *    @return True if this platform supports changing I2C speed.
  *    Not necessarily that the speed was achieved!
  */
 bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
+  _speed = desiredclk;
+  if (_bus) {
+    return true;
+  }
 #if (ARDUINO >= 157) && !defined(ARDUINO_STM32_FEATHER) && !defined(TinyWireM_h)
   _wire->setClock(desiredclk);
   return true;
@@ -265,3 +306,333 @@ bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
   return false;
 #endif
 }
+
+/*!
+ *    @brief  Start an empty list of register accesses for a device. Writes
+ *    and reads are queued, then execute() sends them all in one go: a write
+ *    or read that continues where the previous one of the same kind left
+ *    off is merged into it and sent as one auto-increment burst, and a
+ *    burst bigger than the Wire buffer is split, re-addressing each piece.
+ *    @param  dev The device whose registers are accessed, must be begun
+ *    @param  auto_increment Whether the device steps its register address
+ *            after each byte, so contiguous registers can be burst. If not,
+ *            every register is its own access.
+ */
+Adafruit_I2CTransaction::Adafruit_I2CTransaction(Adafruit_I2CDevice *dev,
+                                                 bool auto_increment) {
+  _dev = dev;
+  _auto_increment = auto_increment;
+  clear();
+}
+
+/*!
+ *    @brief  Forget everything queued and any earlier failure
+ */
+void Adafruit_I2CTransaction::clear(void) {
+  _count = 0;
+  _used = 0;
+  _ok = true;
+}
+
+/*!
+ *    @brief  Queue a write of one register
+ *    @param  reg Register address
+ *    @param  value Byte to write
+ *    @return False if the queue was full and running it early failed
+ */
+bool Adafruit_I2CTransaction::writeRegister(uint8_t reg, uint8_t value) {
+  return writeRegisters(reg, &value, 1);
+}
+
+/*!
+ *    @brief  Queue a write of consecutive registers
+ *    @param  reg First register address
+ *    @param  data Bytes to write, copied into the transaction
+ *    @param  len Number of registers
+ *    @return False if the queue was full and running it early failed
+ */
+bool Adafruit_I2CTransaction::writeRegisters(uint8_t reg, const uint8_t *data,
+                                             uint8_t len) {
+  return _queue(reg, NULL, data, len);
+}
+
+/*!
+ *    @brief  Queue a read of one register
+ *    @param  reg Register address
+ *    @param  value Where to store the byte, valid after execute()
+ *    @return False if the queue was full and running it early failed
+ */
+bool Adafruit_I2CTransaction::readRegister(uint8_t reg, uint8_t *value) {
+  return readRegisters(reg, value, 1);
+}
+
+/*!
+ *    @brief  Queue a read of consecutive registers
+ *    @param  reg First register address
+ *    @param  buffer Where to store the bytes, valid after execute()
+ *    @param  len Number of registers
+ *    @return False if the queue was full and running it early failed
+ */
+bool Adafruit_I2CTransaction::readRegisters(uint8_t reg, uint8_t *buffer,
+                                            uint8_t len) {
+  return _queue(reg, buffer, NULL, len);
+}
+
+/*!
+ *    @brief  Run everything queued, in order, and empty the queue
+ *    @param  chain If true, operations are joined by repeated starts with a
+ *            single STOP at the end. Only for cores whose Wire can start a
+ *            new write after endTransmission(false) (AVR, SAMD); the ESP32
+ *            core only supports a repeated start before a read, which is
+ *            what every read uses anyway.
+ *    @return True if every access since the last clear() or execute() was
+ *            acknowledged
+ */
+bool Adafruit_I2CTransaction::execute(bool chain) {
+  Adafruit_I2CBus *bus = _dev->bus();
+  if (bus) {
+    bus->acquire(_dev);
+  }
+  bool ok = _ok;
+  for (uint8_t i = 0; (i < _count) && ok; i++) {
+    ok = _run(_ops[i], !chain || (i == _count - 1), chain);
+  }
+  if (bus) {
+    bus->release();
+  }
+  clear();
+  return ok;
+}
+
+bool Adafruit_I2CTransaction::_queue(uint8_t reg, uint8_t *dest,
+                                     const uint8_t *data, uint8_t len) {
+  while (len) {
+    // One register at a time without auto-increment, and never more write
+    // data than fits in the pool
+    uint8_t n = _auto_increment ? len : 1;
+    if (!dest && (n > I2C_TRANSACTION_DATA)) {
+      n = I2C_TRANSACTION_DATA;
+    }
+
+    Adafruit_I2COp *last = _count ? &_ops[_count - 1] : NULL;
+    bool follows = _auto_increment && last && (last->reg + last->len == reg) &&
+                   (last->len + n <= 255);
+    if (dest) {
+      follows = follows && last->dest && (last->dest + last->len == dest);
+    } else {
+      follows = follows && !last->dest && (last->offset + last->len == _used);
+    }
+
+    if (!follows && (_count == I2C_TRANSACTION_OPS)) {
+      _ok = execute(); // Queue full: send what we have
+      continue;
+    }
+    if (!dest && (_used + n > I2C_TRANSACTION_DATA)) {
+      _ok = execute(); // Data pool full
+      continue;
+    }
+
+    if (follows) {
+      last->len += n;
+    } else {
+      Adafruit_I2COp &op = _ops[_count++];
+      op.dest = dest;
+      op.reg = reg;
+      op.len = n;
+      op.offset = _used;
+    }
+    if (!dest) {
+      memcpy(_data + _used, data, n);
+      _used += n;
+      data += n;
+    } else {
+      dest += n;
+    }
+    reg += n;
+    len -= n;
+  }
+  return _ok;
+}
+
+bool Adafruit_I2CTransaction::_run(const Adafruit_I2COp &op, bool stop,
+                                   bool chain) {
+  // Each piece is readdressed, so it fits the Wire buffer with its register
+  size_t piece = _dev->maxBufferSize() - (op.dest ? 0 : 1);
+  for (size_t pos = 0; pos < op.len; pos += piece) {
+    size_t n = min((size_t)(op.len - pos), piece);
+    uint8_t reg = op.reg + pos;
+    bool piece_stop = (pos + n < op.len) ? !chain : stop;
+    if (op.dest) {
+      if (!_dev->write(&reg, 1, false) || !_dev->read(op.dest + pos, n, piece_stop))
+        return false;
+    } else if (!_dev->write(_data + op.offset + pos, n, piece_stop, &reg, 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Create a shadow of a range of registers. Reads of a shadowed
+ *    register go to the bus once and are answered from the copy after that;
+ *    writes go to the device and the copy, so a read-modify-write costs a
+ *    single bus write. Only for registers nothing but the host changes
+ *    (configuration, output latches) -- never status registers or FIFOs.
+ *    @param  dev The device the registers belong to
+ *    @param  first First register of the range
+ *    @param  count Number of registers in the range
+ */
+Adafruit_I2CRegisterShadow::Adafruit_I2CRegisterShadow(Adafruit_I2CDevice *dev,
+                                                       uint8_t first,
+                                                       uint8_t count) {
+  _dev = dev;
+  _first = first;
+  _count = count;
+  _values = NULL;
+  _valid = NULL;
+}
+
+/*!
+ *    @brief  Free the copy
+ */
+Adafruit_I2CRegisterShadow::~Adafruit_I2CRegisterShadow(void) {
+  free(_values);
+  free(_valid);
+}
+
+/*!
+ *    @brief  Allocate the copy, initially empty
+ *    @return False if memory could not be allocated
+ */
+bool Adafruit_I2CRegisterShadow::begin(void) {
+  if (!_values) {
+    _values = (uint8_t *)malloc(_count);
+    _valid = (uint8_t *)malloc((_count + 7) / 8);
+    if (!_values || !_valid) {
+      free(_values);
+      free(_valid);
+      _values = _valid = NULL;
+      return false;
+    }
+  }
+  invalidate();
+  return true;
+}
+
+/*!
+ *    @brief  Check whether a register is in the shadowed range
+ *    @param  reg Register address
+ *    @return True if read() and write() keep a copy of it
+ */
+bool Adafruit_I2CRegisterShadow::covers(uint8_t reg) {
+  return _values && (reg >= _first) && (reg - _first < _count);
+}
+
+/*!
+ *    @brief  Read a register, from the copy if it holds it
+ *    @param  reg Register address
+ *    @param  value Where to store the register value
+ *    @return False if the register had to be read and the read failed
+ */
+bool Adafruit_I2CRegisterShadow::read(uint8_t reg, uint8_t *value) {
+  if (!covers(reg)) {
+    return _dev->write_then_read(&reg, 1, value, 1);
+  }
+  uint8_t i = reg - _first;
+  if (!_isValid(i)) {
+    if (!_dev->write_then_read(&reg, 1, &_values[i], 1)) {
+      return false;
+    }
+    _valid[i >> 3] |= 1 << (i & 7);
+  }
+  *value = _values[i];
+  return true;
+}
+
+/*!
+ *    @brief  Write a register on the device and in the copy
+ *    @param  reg Register address
+ *    @param  value Byte to write
+ *    @return False if the write failed, the copy then forgets the register
+ */
+bool Adafruit_I2CRegisterShadow::write(uint8_t reg, uint8_t value) {
+  uint8_t buffer[2] = {reg, value};
+  bool ok = _dev->write(buffer, 2);
+  if (covers(reg)) {
+    if (ok) {
+      store(reg, &value, 1);
+    } else {
+      uint8_t i = reg - _first;
+      _valid[i >> 3] &= ~(1 << (i & 7));
+    }
+  }
+  return ok;
+}
+
+/*!
+ *    @brief  Change some bits of a register
+ *    @param  reg Register address
+ *    @param  mask Bits to change
+ *    @param  value New state of those bits
+ *    @return False if reading or writing the register failed
+ */
+bool Adafruit_I2CRegisterShadow::update(uint8_t reg, uint8_t mask,
+                                        uint8_t value) {
+  uint8_t old;
+  if (!read(reg, &old)) {
+    return false;
+  }
+  return write(reg, (old & ~mask) | (value & mask));
+}
+
+/*!
+ *    @brief  Record values written to the device some other way, such as
+ *    an Adafruit_I2CTransaction burst
+ *    @param  reg First register written
+ *    @param  data Bytes written
+ *    @param  len Number of registers
+ */
+void Adafruit_I2CRegisterShadow::store(uint8_t reg, const uint8_t *data,
+                                       uint8_t len) {
+  for (uint8_t n = 0; n < len; n++, reg++) {
+    if (covers(reg)) {
+      uint8_t i = reg - _first;
+      _values[i] = data[n];
+      _valid[i >> 3] |= 1 << (i & 7);
+    }
+  }
+}
+
+/*!
+ *    @brief  Forget every register, the next read of each goes to the bus
+ */
+void Adafruit_I2CRegisterShadow::invalidate(void) {
+  if (_valid) {
+    memset(_valid, 0, (_count + 7) / 8);
+  }
+}
+
+/*!
+ *    @brief  Re-read every register the copy holds from the device, e.g.
+ *    after the device was reset behind the host's back. Registers never
+ *    read or written are left alone, so no status register is touched.
+ *    @param  auto_increment Whether the device can burst-read contiguous
+ *            registers, see Adafruit_I2CTransaction
+ *    @return False if a read failed, the copy is then empty
+ */
+bool Adafruit_I2CRegisterShadow::sync(bool auto_increment) {
+  if (!_values) {
+    return false;
+  }
+  Adafruit_I2CTransaction txn(_dev, auto_increment);
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_isValid(i)) {
+      txn.readRegister(_first + i, &_values[i]); // runs merge into bursts
+    }
+  }
+  if (!txn.execute()) {
+    invalidate();
+    return false;
+  }
+  return true;
+}
@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+class Adafruit_I2CBus;
+
 ///< The class which defines how we will talk to this device over I2C
 class Adafruit_I2CDevice {
 public:
@@ -25,12 +27,90 @@ public:
    *    @return The size of the Wire receive/transmit buffer */
   size_t maxBufferSize() { return _maxBufferSize; }
 
+  /*!   @brief  The arbiter this device's transfers go through
+   *    @return The Adafruit_I2CBus found by begin(), or NULL */
+  Adafruit_I2CBus *bus() { return _bus; }
+
+  /*!   @brief  The clock this device asked for
+   *    @return The last setSpeed() value, 0 if never set */
+  uint32_t speed() { return _speed; }
+
 private:
   uint8_t _addr;
   TwoWire *_wire;
   bool _begun;
   size_t _maxBufferSize;
+  Adafruit_I2CBus *_bus;
+  uint32_t _speed;
   bool _read(uint8_t *buffer, size_t len, bool stop);
+  bool _write(const uint8_t *buffer, size_t len, bool stop,
+              const uint8_t *prefix_buffer, size_t prefix_len);
+};
+
+/// Operations one Adafruit_I2CTransaction holds before it runs them early
+#define I2C_TRANSACTION_OPS 8
+/// Bytes of queued write data one Adafruit_I2CTransaction can hold
+#define I2C_TRANSACTION_DATA 32
+
+/// One queued register burst of an Adafruit_I2CTransaction
+typedef struct {
+  uint8_t *dest;  ///< Where a read goes, NULL for a write
+  uint8_t reg;    ///< First register
+  uint8_t len;    ///< Registers written or read
+  uint8_t offset; ///< Write data, index into the transaction's pool
+} Adafruit_I2COp;
+
+///< A list of register writes and reads run back to back on one device
+class Adafruit_I2CTransaction {
+public:
+  Adafruit_I2CTransaction(Adafruit_I2CDevice *dev, bool auto_increment = true);
+
+  bool writeRegister(uint8_t reg, uint8_t value);
+  bool writeRegisters(uint8_t reg, const uint8_t *data, uint8_t len);
+  bool readRegister(uint8_t reg, uint8_t *value);
+  bool readRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  bool execute(bool chain = false);
+  void clear(void);
+
+  /*!   @brief  How many bursts are queued
+   *    @return Number of operations execute() would run */
+  uint8_t operations(void) { return _count; }
+
+private:
+  bool _queue(uint8_t reg, uint8_t *dest, const uint8_t *data, uint8_t len);
+  bool _run(const Adafruit_I2COp &op, bool stop, bool chain);
+
+  Adafruit_I2CDevice *_dev;
+  bool _auto_increment;
+  bool _ok;
+  uint8_t _count, _used;
+  Adafruit_I2COp _ops[I2C_TRANSACTION_OPS];
+  uint8_t _data[I2C_TRANSACTION_DATA];
+};
+
+///< Host-side copy of a device's configuration registers
+class Adafruit_I2CRegisterShadow {
+public:
+  Adafruit_I2CRegisterShadow(Adafruit_I2CDevice *dev, uint8_t first,
+                             uint8_t count);
+  ~Adafruit_I2CRegisterShadow(void);
+
+  bool begin(void);
+  bool covers(uint8_t reg);
+  bool read(uint8_t reg, uint8_t *value);
+  bool write(uint8_t reg, uint8_t value);
+  bool update(uint8_t reg, uint8_t mask, uint8_t value);
+  void store(uint8_t reg, const uint8_t *data, uint8_t len);
+  void invalidate(void);
+  bool sync(bool auto_increment = false);
+
+private:
+  bool _isValid(uint8_t i) { return _valid[i >> 3] & (1 << (i & 7)); }
+
+  Adafruit_I2CDevice *_dev;
+  uint8_t _first, _count;
+  uint8_t *_values;
+  uint8_t *_valid; ///< One bit per register, set once _values holds it
 };
 
 #endif // Adafruit_I2CDevice_h
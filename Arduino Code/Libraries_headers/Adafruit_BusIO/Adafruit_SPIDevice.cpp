@@ -5,6 +5,18 @@
 
 //#define DEBUG_SERIAL Serial
 
+#ifdef BUSIO_USE_FAST_PINIO
+#if defined(ESP32)
+// The ESP32 has write-1-to-set and write-1-to-clear registers right after
+// each output register, which flip one pin without a read-modify-write
+#define BUSIO_PIN_HIGH(port, mask) (*((port) + 1) = (mask))
+#define BUSIO_PIN_LOW(port, mask) (*((port) + 2) = (mask))
+#else
+#define BUSIO_PIN_HIGH(port, mask) (*(port) |= (mask))
+#define BUSIO_PIN_LOW(port, mask) (*(port) &= ~(mask))
+#endif
+#endif
+
 /*!
  *    @brief  Create an SPI device with the given CS pin and settings
  *    @param  cspin The arduino pin number to use for chip select
@@ -21,6 +33,7 @@ Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
   _sck = _mosi = _miso = -1;
   _spi = theSPI;
   _begun = false;
+  _batch = 0;
   _spiSetting = new SPISettings(freq, dataOrder, dataMode);
   _freq = freq;
   _dataOrder = dataOrder;
@@ -68,6 +81,7 @@ Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sckpin,
   _dataOrder = dataOrder;
   _dataMode = dataMode;
   _begun = false;
+  _batch = 0;
   _spiSetting = new SPISettings(freq, dataOrder, dataMode);
   _spi = nullptr;
 }
@@ -296,22 +310,132 @@ void Adafruit_SPIDevice::setChipSelect(int value) {
  *    @brief  Write a buffer or two to the SPI device, with transaction
  * management.
  *    @brief  Manually begin a transaction (calls beginTransaction if hardware
- *            SPI) with asserting the CS pin
+ *            SPI) with asserting the CS pin. Does nothing inside a batch,
+ *            which already holds both.
  */
 void Adafruit_SPIDevice::beginTransactionWithAssertingCS() {
+  if (_batch) {
+    return;
+  }
   beginTransaction();
   setChipSelect(LOW);
 }
 
 /*!
  *    @brief  Manually end a transaction (calls endTransaction if hardware SPI)
- *            with deasserting the CS pin
+ *            with deasserting the CS pin. Does nothing inside a batch.
  */
 void Adafruit_SPIDevice::endTransactionWithDeassertingCS() {
+  if (_batch) {
+    return;
+  }
   setChipSelect(HIGH);
   endTransaction();
 }
 
+/*!
+ *    @brief  Start a batch: the transaction is begun and CS asserted once,
+ *            and every read/write until the matching endBatch() goes out
+ *            inside it instead of toggling CS and re-taking the bus each
+ *            call. Meant for long runs of writes to one device, e.g. all
+ *            the page commands and data of a display frame. Batches nest.
+ */
+void Adafruit_SPIDevice::beginBatch(void) {
+  beginTransactionWithAssertingCS();
+  _batch++;
+}
+
+/*!
+ *    @brief  End a batch started by beginBatch(), deasserting CS and ending
+ *            the transaction when it is the outermost one
+ */
+void Adafruit_SPIDevice::endBatch(void) {
+  if (!_batch) {
+    return;
+  }
+  _batch--;
+  endTransactionWithDeassertingCS();
+}
+
+/*!
+ *    @brief  Send a buffer, discarding whatever comes back, without
+ *            transaction management
+ *    @param  buffer Pointer to buffer of data to write
+ *    @param  len Number of bytes from buffer to write
+ */
+void Adafruit_SPIDevice::_write(const uint8_t *buffer, size_t len) {
+  if (!_spi) {
+    _softWrite(buffer, len);
+    return;
+  }
+#if defined(ARDUINO_ARCH_ESP32)
+  // fills the 64 byte hardware FIFO per round and never reads it back
+  _spi->writeBytes(buffer, len);
+#else
+  // transfer() overwrites what it sends, so go through a copy; one bulk
+  // transfer per chunk is still far cheaper than one call per byte
+  uint8_t chunk[32];
+  while (len) {
+    size_t n = (len < sizeof(chunk)) ? len : sizeof(chunk);
+    memcpy(chunk, buffer, n);
+    transfer(chunk, n);
+    buffer += n;
+    len -= n;
+  }
+#endif
+}
+
+/*!
+ *    @brief  Bit-bang a buffer out over software SPI. Mode 0 at full speed
+ *            (no bit delay, the usual case for displays) gets a loop that
+ *            only drives MOSI and SCK, changes MOSI only when the bit does
+ *            and goes straight to the port registers where it can; anything
+ *            else goes through transfer() one byte at a time.
+ *    @param  buffer Pointer to buffer of data to write
+ *    @param  len Number of bytes from buffer to write
+ */
+void Adafruit_SPIDevice::_softWrite(const uint8_t *buffer, size_t len) {
+  if ((_dataMode != SPI_MODE0) || (_mosi == -1) || ((1000000 / _freq) / 2)) {
+    for (size_t i = 0; i < len; i++) {
+      transfer(buffer[i]);
+    }
+    return;
+  }
+
+  bool lsbfirst = (_dataOrder == SPI_BITORDER_LSBFIRST);
+  uint8_t lastmosi = 0x01; // matches no bit, so the first one is written
+
+  for (size_t i = 0; i < len; i++) {
+    uint8_t send = buffer[i];
+    if (lsbfirst) {
+      send = (send & 0xF0) >> 4 | (send & 0x0F) << 4;
+      send = (send & 0xCC) >> 2 | (send & 0x33) << 2;
+      send = (send & 0xAA) >> 1 | (send & 0x55) << 1;
+    }
+    for (uint8_t b = 0; b < 8; b++, send <<= 1) {
+      uint8_t towrite = send & 0x80;
+      if (towrite != lastmosi) {
+#ifdef BUSIO_USE_FAST_PINIO
+        if (towrite)
+          BUSIO_PIN_HIGH(mosiPort, mosiPinMask);
+        else
+          BUSIO_PIN_LOW(mosiPort, mosiPinMask);
+#else
+        digitalWrite(_mosi, towrite ? HIGH : LOW);
+#endif
+        lastmosi = towrite;
+      }
+#ifdef BUSIO_USE_FAST_PINIO
+      BUSIO_PIN_HIGH(clkPort, clkPinMask); // data is sampled on this edge
+      BUSIO_PIN_LOW(clkPort, clkPinMask);
+#else
+      digitalWrite(_sck, HIGH);
+      digitalWrite(_sck, LOW);
+#endif
+    }
+  }
+}
+
 /*!
  *    @brief  Write a buffer or two to the SPI device, with transaction
  * management.
@@ -329,23 +453,11 @@ bool Adafruit_SPIDevice::write(const uint8_t *buffer, size_t len,
   beginTransactionWithAssertingCS();
 
   // do the writing
-#if defined(ARDUINO_ARCH_ESP32)
-  if (_spi) {
-    if (prefix_len > 0) {
-      _spi->transferBytes(prefix_buffer, nullptr, prefix_len);
-    }
-    if (len > 0) {
-      _spi->transferBytes(buffer, nullptr, len);
-    }
-  } else
-#endif
-  {
-    for (size_t i = 0; i < prefix_len; i++) {
-      transfer(prefix_buffer[i]);
-    }
-    for (size_t i = 0; i < len; i++) {
-      transfer(buffer[i]);
-    }
+  if (prefix_len > 0) {
+    _write(prefix_buffer, prefix_len);
+  }
+  if (len > 0) {
+    _write(buffer, len);
   }
   endTransactionWithDeassertingCS();
 
@@ -423,17 +535,8 @@ bool Adafruit_SPIDevice::write_then_read(const uint8_t *write_buffer,
                                          size_t read_len, uint8_t sendvalue) {
   beginTransactionWithAssertingCS();
   // do the writing
-#if defined(ARDUINO_ARCH_ESP32)
-  if (_spi) {
-    if (write_len > 0) {
-      _spi->transferBytes(write_buffer, nullptr, write_len);
-    }
-  } else
-#endif
-  {
-    for (size_t i = 0; i < write_len; i++) {
-      transfer(write_buffer[i]);
-    }
+  if (write_len > 0) {
+    _write(write_buffer, write_len);
   }
 
 #ifdef DEBUG_SERIAL
@@ -102,8 +102,13 @@ public:
   void endTransaction(void);
   void beginTransactionWithAssertingCS();
   void endTransactionWithDeassertingCS();
+  void beginBatch(void);
+  void endBatch(void);
 
 private:
+  void _write(const uint8_t *buffer, size_t len);
+  void _softWrite(const uint8_t *buffer, size_t len);
+
   SPIClass *_spi;
   SPISettings *_spiSetting;
   uint32_t _freq;
@@ -117,6 +122,7 @@ private:
   BusIO_PortMask mosiPinMask, misoPinMask, clkPinMask, csPinMask;
 #endif
   bool _begun;
+  uint8_t _batch; ///< Nested beginBatch() calls holding the transaction
 };
 
 #endif // has SPI defined
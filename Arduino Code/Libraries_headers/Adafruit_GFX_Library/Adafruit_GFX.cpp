@@ -117,8 +117,21 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  for (uint8_t i = 0; i < GFX_METRICS_FONTS; i++) {
+    _metrics[i] = NULL;
+    _metrics_font[i] = NULL;
+  }
+  _bounds = NULL;
+  _bounds_count = 0;
 }
 
+/**************************************************************************/
+/*!
+   @brief    Destructor, frees the text metrics cache if enabled
+*/
+/**************************************************************************/
+Adafruit_GFX::~Adafruit_GFX(void) { enableTextMetrics(false); }
+
 /**************************************************************************/
 /*!
    @brief    Write a line.  Bresenham's algorithm - thx wikpedia
@@ -716,22 +729,7 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                               int16_t w, int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
-  endWrite();
+  drawMonoBitmap(x, y, bitmap, w, h, color, color, GFX_BITMAP_PROGMEM);
 }
 
 /**************************************************************************/
@@ -751,21 +749,8 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                               int16_t w, int16_t h, uint16_t color,
                               uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
-    }
-  }
-  endWrite();
+  drawMonoBitmap(x, y, bitmap, w, h, color, bg,
+                 GFX_BITMAP_PROGMEM | GFX_BITMAP_OPAQUE);
 }
 
 /**************************************************************************/
@@ -782,22 +767,7 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
-  endWrite();
+  drawMonoBitmap(x, y, bitmap, w, h, color, color, 0);
 }
 
 /**************************************************************************/
@@ -816,21 +786,7 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color, uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
-    }
-  }
-  endWrite();
+  drawMonoBitmap(x, y, bitmap, w, h, color, bg, GFX_BITMAP_OPAQUE);
 }
 
 /**************************************************************************/
@@ -850,21 +806,50 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                                int16_t w, int16_t h, uint16_t color) {
+  drawMonoBitmap(x, y, bitmap, w, h, color, color,
+                 GFX_BITMAP_PROGMEM | GFX_BITMAP_XBM);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a 1-bit image. Every drawBitmap() and drawXBitmap() variant
+   ends up here, so a display with a better way to place 1-bit data (a
+   page-format framebuffer, say) only has to override this one function.
+   This version draws pixel by pixel with writePixel().
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  Byte array, rows of (w + 7) / 8 bytes
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    color   Color to draw set bits with
+    @param    bg      Color to draw clear bits with if GFX_BITMAP_OPAQUE
+    @param    flags   GFX_BITMAP_PROGMEM if bitmap is in flash,
+                      GFX_BITMAP_XBM for LSB-first rows, GFX_BITMAP_OPAQUE
+                      to draw clear bits in bg instead of skipping them
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                                  int16_t w, int16_t h, uint16_t color,
+                                  uint16_t bg, uint8_t flags) {
 
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
+  bool xbm = flags & GFX_BITMAP_XBM;
+  uint8_t first = xbm ? 0x01 : 0x80;
 
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
-        byte >>= 1;
-      else
+        byte = xbm ? (byte >> 1) : (byte << 1);
+      else if (flags & GFX_BITMAP_PROGMEM)
         byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      // Nearly identical to drawBitmap(), only the bit order
-      // is reversed here (left-to-right = LSB to MSB):
-      if (byte & 0x01)
+      else
+        byte = bitmap[j * byteWidth + i / 8];
+      if (byte & first)
         writePixel(x + i, y, color);
+      else if (flags & GFX_BITMAP_OPAQUE)
+        writePixel(x + i, y, bg);
     }
   }
   endWrite();
@@ -1213,6 +1198,29 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     // implemented this yet.
 
     startWrite();
+    if (pgm_read_byte(&gfxFont->rle)) { // Compressed: draw whole runs
+      GFXglyphSpans spans;
+      uint16_t start, len;
+      glyphSpansBegin(c + (uint8_t)pgm_read_byte(&gfxFont->first), &spans);
+      while (glyphSpan(&spans, &start, &len)) {
+        xx = start % w;
+        yy = start / w;
+        while (len) { // Split runs that continue on the next row
+          uint8_t n = min((uint16_t)(w - xx), len);
+          if (size_x == 1 && size_y == 1) {
+            writeFastHLine(x + xo + xx, y + yo + yy, n, color);
+          } else {
+            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
+                          n * size_x, size_y, color);
+          }
+          len -= n;
+          xx = 0;
+          yy++;
+        }
+      }
+      endWrite();
+      return;
+    }
     for (yy = 0; yy < h; yy++) {
       for (xx = 0; xx < w; xx++) {
         if (!(bit++ & 7)) {
@@ -1378,15 +1386,10 @@ void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
       *x = 0;        // Reset x to zero, advance y by one line
       *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
     } else if (c != '\r') { // Not a carriage return; is normal char
-      uint8_t first = pgm_read_byte(&gfxFont->first),
-              last = pgm_read_byte(&gfxFont->last);
-      if ((c >= first) && (c <= last)) { // Char present in this font?
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
-        uint8_t gw = pgm_read_byte(&glyph->width),
-                gh = pgm_read_byte(&glyph->height),
-                xa = pgm_read_byte(&glyph->xAdvance);
-        int8_t xo = pgm_read_byte(&glyph->xOffset),
-               yo = pgm_read_byte(&glyph->yOffset);
+      GFXmetrics *m = glyphMetrics(c);
+      if (m) { // Char present in this font?
+        uint8_t gw = m->width, gh = m->height, xa = m->xAdvance;
+        int8_t xo = m->xOffset, yo = m->yOffset;
         if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
           *x = 0; // Reset x to zero, advance y by one line
           *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
@@ -1432,6 +1435,327 @@ void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Get the unscaled bitmap box of a character in the current font,
+            relative to the cursor. Lets subclasses pre-render glyphs into
+            their own memory layout without knowing how fonts are stored.
+    @param  c   The character, as passed to drawChar()
+    @param  xo  Returns the X offset from the cursor to the box
+    @param  yo  Returns the Y offset from the cursor to the box
+    @param  w   Returns the box width in pixels
+    @param  h   Returns the box height in pixels
+    @note   The classic font box is the 5x8 glyph, not the 6x8 cell.
+*/
+/**************************************************************************/
+void Adafruit_GFX::glyphBox(unsigned char c, int8_t *xo, int8_t *yo,
+                            uint8_t *w, uint8_t *h) {
+  if (!gfxFont) {
+    *xo = *yo = 0;
+    *w = 5;
+    *h = 8;
+    return;
+  }
+  c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+  *w = pgm_read_byte(&glyph->width);
+  *h = pgm_read_byte(&glyph->height);
+  *xo = pgm_read_byte(&glyph->xOffset);
+  *yo = pgm_read_byte(&glyph->yOffset);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Test one pixel of a character bitmap in the current font.
+    @param  c   The character, as passed to drawChar()
+    @param  gx  Column within the glyphBox()
+    @param  gy  Row within the glyphBox()
+    @return true if the pixel is set (drawn in the text color)
+*/
+/**************************************************************************/
+bool Adafruit_GFX::glyphPixel(unsigned char c, uint8_t gx, uint8_t gy) {
+  if (!gfxFont) {
+    if (!_cp437 && (c >= 176))
+      c++; // Handle 'classic' charset behavior
+    return (pgm_read_byte(&font[c * 5 + gx]) >> gy) & 1;
+  }
+  if (pgm_read_byte(&gfxFont->rle)) { // Walk the runs up to the pixel
+    GFXglyphSpans spans;
+    uint16_t start, len;
+    int8_t xo, yo;
+    uint8_t w, h;
+    glyphBox(c, &xo, &yo, &w, &h);
+    glyphSpansBegin(c, &spans);
+    uint16_t bit = gy * w + gx;
+    while (glyphSpan(&spans, &start, &len)) {
+      if (bit < start)
+        return false;
+      if (bit < start + len)
+        return true;
+    }
+    return false;
+  }
+  c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+  uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+  uint16_t bit = gy * pgm_read_byte(&glyph->width) + gx;
+  uint8_t bits = pgm_read_byte(&bitmap[pgm_read_word(&glyph->bitmapOffset) +
+                                       bit / 8]);
+  return (bits << (bit & 7)) & 0x80;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start walking the set pixels of a character in the current
+            custom font with glyphSpan(). Works for plain and run-length
+            encoded (see fontconvert/fontcompress.py) fonts alike.
+    @param  c  The character, as passed to drawChar()
+    @param  s  Walk state to initialize
+*/
+/**************************************************************************/
+void Adafruit_GFX::glyphSpansBegin(unsigned char c, GFXglyphSpans *s) {
+  c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+  s->data = pgm_read_bitmap_ptr(gfxFont) + pgm_read_word(&glyph->bitmapOffset);
+  s->pos = 0;
+  s->total = (uint16_t)pgm_read_byte(&glyph->width) *
+             (uint8_t)pgm_read_byte(&glyph->height);
+  s->bits = 0;
+  s->left = 0;
+  s->rle = pgm_read_byte(&gfxFont->rle);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the next run of set pixels of a glyph.
+    @param  s      Walk state from glyphSpansBegin()
+    @param  start  Returns the run's first pixel, counted row-major from the
+                   top left of the glyph bitmap (x = start % width)
+    @param  len    Returns the run length; runs may continue onto the
+                   following rows
+    @return false once the whole glyph has been walked
+*/
+/**************************************************************************/
+bool Adafruit_GFX::glyphSpan(GFXglyphSpans *s, uint16_t *start,
+                             uint16_t *len) {
+  if (s->rle) { // Pairs of (clear, set) run lengths, b0 and b1 bits wide
+    uint8_t width[2] = {(uint8_t)(s->rle >> 4), (uint8_t)(s->rle & 15)};
+    while (s->pos < s->total) {
+      uint8_t run[2] = {0, 0};
+      for (uint8_t i = 0; i < 2; i++) {
+        for (uint8_t b = 0; b < width[i]; b++) {
+          if (!s->left) {
+            s->bits = pgm_read_byte(s->data++);
+            s->left = 8;
+          }
+          run[i] = (run[i] << 1) | (s->bits >> 7);
+          s->bits <<= 1;
+          s->left--;
+        }
+      }
+      s->pos += run[0];
+      if (run[1]) {
+        *start = s->pos;
+        *len = run[1];
+        s->pos += run[1];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Plain bitmap: skip clear bits, then count set ones
+  *len = 0;
+  while (s->pos < s->total) {
+    if (!s->left) {
+      s->bits = pgm_read_byte(s->data++);
+      s->left = 8;
+    }
+    bool set = s->bits & 0x80;
+    if (!set && *len)
+      return true;
+    if (set && !(*len)++)
+      *start = s->pos;
+    s->bits <<= 1;
+    s->left--;
+    s->pos++;
+  }
+  return *len;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the metrics of a character in the current custom font, from
+            the RAM copy made by enableTextMetrics() if there is one.
+    @param  c  The character
+    @return Pointer to the metrics, or NULL if the font has no such
+            character. Without a RAM copy this points to a single static
+            entry that the next call overwrites.
+    @note   Each font is copied once and kept until the cache is disabled,
+            so switching between a few fonts every frame never reloads
+            them. Fonts beyond the first GFX_METRICS_FONTS are read from
+            PROGMEM each time.
+*/
+/**************************************************************************/
+GFXmetrics *Adafruit_GFX::glyphMetrics(unsigned char c) {
+  static GFXmetrics scratch;
+  uint8_t first = pgm_read_byte(&gfxFont->first),
+          last = pgm_read_byte(&gfxFont->last);
+  if ((c < first) || (c > last))
+    return NULL;
+
+  if (_bounds) {
+    uint8_t slot = 0;
+    while ((slot < GFX_METRICS_FONTS) && _metrics_font[slot] &&
+           (_metrics_font[slot] != gfxFont))
+      slot++;
+    if ((slot < GFX_METRICS_FONTS) && !_metrics_font[slot]) { // First use
+      GFXmetrics *m =
+          (GFXmetrics *)malloc((last - first + 1) * sizeof(GFXmetrics));
+      for (uint16_t i = 0; m && (i <= last - first); i++) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, i);
+        m[i].width = pgm_read_byte(&glyph->width);
+        m[i].height = pgm_read_byte(&glyph->height);
+        m[i].xAdvance = pgm_read_byte(&glyph->xAdvance);
+        m[i].xOffset = pgm_read_byte(&glyph->xOffset);
+        m[i].yOffset = pgm_read_byte(&glyph->yOffset);
+      }
+      _metrics[slot] = m;
+      _metrics_font[slot] = m ? gfxFont : NULL;
+    }
+    if ((slot < GFX_METRICS_FONTS) && _metrics[slot])
+      return &_metrics[slot][c - first];
+  }
+
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+  scratch.width = pgm_read_byte(&glyph->width);
+  scratch.height = pgm_read_byte(&glyph->height);
+  scratch.xAdvance = pgm_read_byte(&glyph->xAdvance);
+  scratch.xOffset = pgm_read_byte(&glyph->xOffset);
+  scratch.yOffset = pgm_read_byte(&glyph->yOffset);
+  return &scratch;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Horizontal cursor advance of a character with current font/size.
+    @param  c  The character
+    @return Advance in pixels, 0 for characters the font lacks
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX::charAdvance(unsigned char c) {
+  if (!gfxFont)
+    return textsize_x * 6;
+  GFXmetrics *m = glyphMetrics(c);
+  return m ? m->xAdvance * textsize_x : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Enable (or disable) cached text measurement. Custom font glyph
+            metrics are copied into RAM the first time each font is
+            measured (up to GFX_METRICS_FONTS fonts), and the last
+            GFX_BOUNDS_CACHE results of getTextBounds() are remembered, so
+            measuring the same label again (e.g. to right-align it every
+            frame) skips the glyph walk.
+    @param  enable  true to allocate the caches, false to free them
+    @return true on success, false if memory could not be allocated
+    @note   Results are keyed on a 32-bit hash of the string; a collision
+            between two strings of the same font and size would return the
+            wrong bounds.
+*/
+/**************************************************************************/
+bool Adafruit_GFX::enableTextMetrics(bool enable) {
+  for (uint8_t i = 0; i < GFX_METRICS_FONTS; i++) {
+    free(_metrics[i]);
+    _metrics[i] = NULL;
+    _metrics_font[i] = NULL;
+  }
+  free(_bounds);
+  _bounds = NULL;
+  _bounds_count = 0;
+  if (!enable)
+    return true;
+  _bounds = (GFXboundsEntry *)malloc(GFX_BOUNDS_CACHE * sizeof(GFXboundsEntry));
+  return _bounds != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Break a block of text into lines that fit a given width and
+            align each line, in a single pass over the string. Lines break
+            at '\n', and at the last space before a word that would not fit
+            (or mid-word if a single word is wider than the box).
+    @param  str        The text
+    @param  x          Left edge of the box
+    @param  y          Cursor Y of the first line
+    @param  w          Width of the box in pixels
+    @param  align      GFX_ALIGN_LEFT, GFX_ALIGN_CENTER or GFX_ALIGN_RIGHT
+    @param  lines      Returns the lines; print str[start..start+length) at
+                       (x, y) of each to draw the block
+    @param  max_lines  Size of the lines array
+    @return Number of lines filled in; text past max_lines is dropped
+*/
+/**************************************************************************/
+uint8_t Adafruit_GFX::layoutText(const char *str, int16_t x, int16_t y,
+                                 uint16_t w, uint8_t align, GFXtextLine *lines,
+                                 uint8_t max_lines) {
+  int16_t line_h = gfxFont
+                       ? textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance)
+                       : textsize_y * 8;
+  uint8_t n = 0;
+  uint16_t i = 0;
+
+  while (str[i] && (n < max_lines)) {
+    uint16_t start = i, brk = 0, brk_w = 0;
+    uint16_t line_w = 0;
+    bool have_brk = false;
+
+    while (str[i] && (str[i] != '\n')) {
+      int16_t adv = charAdvance(str[i]);
+      if ((line_w + adv > w) && (i > start)) { // Doesn't fit
+        if (str[i] == ' ') {
+          have_brk = true; // Break right here
+          brk = i;
+          brk_w = line_w;
+        }
+        break;
+      }
+      if (str[i] == ' ') {
+        have_brk = true; // Remember last break opportunity
+        brk = i;
+        brk_w = line_w;
+      }
+      line_w += adv;
+      i++;
+    }
+
+    bool wrapped = str[i] && (str[i] != '\n');
+    if (wrapped && have_brk) { // Go back to the last space
+      i = brk;
+      line_w = brk_w;
+    }
+    lines[n].start = start;
+    lines[n].length = i - start;
+    lines[n].width = line_w;
+    lines[n].y = y + n * line_h;
+    lines[n].x = x;
+    if (align == GFX_ALIGN_CENTER)
+      lines[n].x += ((int16_t)w - (int16_t)line_w) / 2;
+    else if (align == GFX_ALIGN_RIGHT)
+      lines[n].x += (int16_t)w - (int16_t)line_w;
+    n++;
+
+    if (str[i] == '\n') {
+      i++;
+    } else if (wrapped) {
+      while (str[i] == ' ') // Spaces at a wrap are not carried over
+        i++;
+    }
+  }
+  return n;
+}
+
 /**************************************************************************/
 /*!
     @brief  Helper to determine size of a string with current font/size.
@@ -1452,12 +1776,73 @@ void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
   uint8_t c; // Current character
   int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
   // Bound rect is intentionally initialized inverted, so 1st char sets it
+  int16_t x0 = x, y0 = y;
+  uint32_t hash = 2166136261UL; // FNV-1a
+  GFXboundsEntry *e = NULL;
+
+  if (_bounds) {
+    // Bounds move with the cursor, except that newlines and wrapping
+    // return to X = 0, so then the cursor X is part of the key
+    bool absolute = wrap;
+    for (const char *p = str; *p; p++) {
+      hash = (hash ^ (uint8_t)*p) * 16777619UL;
+      absolute |= (*p == '\n');
+    }
+    if (absolute)
+      hash = (hash ^ (uint16_t)x) * 16777619UL;
+    for (uint8_t i = 0; i < _bounds_count; i++) {
+      GFXboundsEntry hit = _bounds[i];
+      if ((hit.hash == hash) && (hit.font == gfxFont) &&
+          (hit.size_x == textsize_x) && (hit.size_y == textsize_y) &&
+          (hit.wrap == wrap) && (hit.width == _width)) {
+        memmove(&_bounds[1], &_bounds[0], i * sizeof(GFXboundsEntry));
+        e = &_bounds[0]; // Move to front
+        *e = hit;
+        break;
+      }
+    }
+    if (e) {
+      if (e->x2 >= e->x1) {
+        minx = x0 + e->x1;
+        miny = y0 + e->y1;
+        maxx = x0 + e->x2;
+        maxy = y0 + e->y2;
+      }
+    } else {
+      maxx = maxy = -0x7FFF; // Unclamped, so the result can be moved
+      while ((c = *str++))
+        charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+
+      if (_bounds_count < GFX_BOUNDS_CACHE)
+        _bounds_count++;
+      memmove(&_bounds[1], &_bounds[0],
+              (_bounds_count - 1) * sizeof(GFXboundsEntry));
+      e = &_bounds[0]; // Insert at front, dropping the least recently used
+      e->hash = hash;
+      e->font = gfxFont;
+      e->width = _width;
+      e->size_x = textsize_x;
+      e->size_y = textsize_y;
+      e->wrap = wrap;
+      e->x1 = e->y1 = 0;
+      e->x2 = e->y2 = -1;
+      if (maxx >= minx) {
+        e->x1 = minx - x0;
+        e->y1 = miny - y0;
+        e->x2 = maxx - x0;
+        e->y2 = maxy - y0;
+      }
+    }
+    // Same result as the walk below, whose max starts at -1
+    maxx = max(maxx, (int16_t)-1);
+    maxy = max(maxy, (int16_t)-1);
+  }
 
-  *x1 = x; // Initial position is value passed in
-  *y1 = y;
+  *x1 = x0; // Initial position is value passed in
+  *y1 = y0;
   *w = *h = 0; // Initial size is zero
 
-  while ((c = *str++)) {
+  while (!e && (c = *str++)) {
     // charBounds() modifies x/y to advance for each character,
     // and min/max x/y are updated to incrementally build bounding rect.
     charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
@@ -1823,6 +2208,73 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Draw a line to the canvas framebuffer. The rotation is resolved
+            once here and the pixels are set by a loop specialised for it,
+            so rotated canvases draw lines as fast as unrotated ones.
+    @param  x0    Start point x coordinate
+    @param  y0    Start point y coordinate
+    @param  x1    End point x coordinate
+    @param  y1    End point y coordinate
+    @param  color Binary (on or off) color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas1::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (!buffer)
+    return;
+  switch (rotation) {
+  case 0:
+    writeRawLine<0>(x0, y0, x1, y1, color);
+    break;
+  case 1:
+    writeRawLine<1>(x0, y0, x1, y1, color);
+    break;
+  case 2:
+    writeRawLine<2>(x0, y0, x1, y1, color);
+    break;
+  case 3:
+    writeRawLine<3>(x0, y0, x1, y1, color);
+    break;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Line inner loop for one rotation, see writeLine()
+    @param  x0    Start point x coordinate
+    @param  y0    Start point y coordinate
+    @param  x1    End point x coordinate
+    @param  y1    End point y coordinate
+    @param  color Binary (on or off) color to draw with
+*/
+/**************************************************************************/
+template <uint8_t R>
+void GFXcanvas1::writeRawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              uint16_t color) {
+  uint8_t *buf = buffer;
+  int16_t stride = (WIDTH + 7) / 8;
+  auto plot = [=](int16_t x, int16_t y) {
+    uint8_t *ptr = &buf[(x / 8) + y * stride];
+#ifdef __AVR__
+    if (color)
+      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
+    else
+      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    if (color)
+      *ptr |= 0x80 >> (x & 7);
+    else
+      *ptr &= ~(0x80 >> (x & 7));
+#endif
+  };
+  rasterLine<R>(x0, y0, x1, y1, plot);
+}
+
 /**********************************************************************/
 /*!
         @brief    Get the pixel color value at a given coordinate
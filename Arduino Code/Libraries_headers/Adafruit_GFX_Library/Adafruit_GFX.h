@@ -9,6 +9,59 @@
 #endif
 #include "gfxfont.h"
 
+#define GFX_BOUNDS_CACHE 8 ///< getTextBounds() results kept by the LRU
+#define GFX_METRICS_FONTS 4 ///< Fonts whose glyph metrics are kept in RAM
+
+#define GFX_BITMAP_PROGMEM 0x01 ///< drawMonoBitmap(): bitmap is in PROGMEM
+#define GFX_BITMAP_XBM 0x02     ///< drawMonoBitmap(): rows are LSB-first
+#define GFX_BITMAP_OPAQUE 0x04  ///< drawMonoBitmap(): clear bits drawn in bg
+
+#define GFX_ALIGN_LEFT 0   ///< layoutText(): lines start at the box's left
+#define GFX_ALIGN_CENTER 1 ///< layoutText(): lines centered in the box
+#define GFX_ALIGN_RIGHT 2  ///< layoutText(): lines end at the box's right
+
+/// Glyph metrics copied out of PROGMEM by enableTextMetrics()
+typedef struct {
+  uint8_t width;    ///< Bitmap dimensions in pixels
+  uint8_t height;   ///< Bitmap dimensions in pixels
+  uint8_t xAdvance; ///< Distance to advance cursor (x axis)
+  int8_t xOffset;   ///< X dist from cursor pos to UL corner
+  int8_t yOffset;   ///< Y dist from cursor pos to UL corner
+} GFXmetrics;
+
+/// One remembered getTextBounds() result, relative to the cursor
+typedef struct {
+  uint32_t hash;        ///< Hash of the string (and cursor X if it matters)
+  const GFXfont *font;  ///< Font it was measured in, NULL for classic
+  int16_t x1;           ///< Left edge relative to the cursor
+  int16_t y1;           ///< Top edge relative to the cursor
+  int16_t x2;           ///< Right edge relative to the cursor, < x1 if empty
+  int16_t y2;           ///< Bottom edge relative to the cursor
+  uint16_t width;       ///< Display width it was measured against
+  uint8_t size_x;       ///< Text magnification it was measured at
+  uint8_t size_y;       ///< Text magnification it was measured at
+  bool wrap;            ///< Wrap setting it was measured with
+} GFXboundsEntry;
+
+/// Position while walking the set pixels of a custom font glyph
+typedef struct {
+  const uint8_t *data; ///< Next byte of glyph bitmap or run stream
+  uint16_t pos;        ///< Pixels (row-major) walked so far
+  uint16_t total;      ///< Pixels in the glyph, width * height
+  uint8_t bits;        ///< Byte being read, MSB first
+  uint8_t left;        ///< Unread bits in it
+  uint8_t rle;         ///< The font's GFXfont::rle
+} GFXglyphSpans;
+
+/// One line of a text block laid out by layoutText()
+typedef struct {
+  uint16_t start;  ///< Index of the line's first character in the string
+  uint16_t length; ///< Characters on the line, excluding the break
+  int16_t x;       ///< Cursor X to print the line at, after alignment
+  int16_t y;       ///< Cursor Y to print the line at
+  uint16_t width;  ///< Advance width of the line in pixels
+} GFXtextLine;
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -16,6 +69,7 @@ class Adafruit_GFX : public Print {
 
 public:
   Adafruit_GFX(int16_t w, int16_t h); // Constructor
+  ~Adafruit_GFX(void);
 
   /**********************************************************************/
   /*!
@@ -106,14 +160,17 @@ public:
                      int16_t w, int16_t h);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                 uint16_t bg, uint8_t size);
-  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-                uint16_t bg, uint8_t size_x, uint8_t size_y);
+  virtual void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                        uint16_t bg, uint8_t size_x, uint8_t size_y);
   void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
                      int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
+  bool enableTextMetrics(bool enable = true);
+  uint8_t layoutText(const char *str, int16_t x, int16_t y, uint16_t w,
+                     uint8_t align, GFXtextLine *lines, uint8_t max_lines);
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
@@ -229,6 +286,84 @@ public:
 protected:
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  void glyphBox(unsigned char c, int8_t *xo, int8_t *yo, uint8_t *w,
+                uint8_t *h);
+  bool glyphPixel(unsigned char c, uint8_t gx, uint8_t gy);
+  void glyphSpansBegin(unsigned char c, GFXglyphSpans *s);
+  bool glyphSpan(GFXglyphSpans *s, uint16_t *start, uint16_t *len);
+  GFXmetrics *glyphMetrics(unsigned char c);
+  int16_t charAdvance(unsigned char c);
+  virtual void drawMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg, uint8_t flags);
+
+  /**********************************************************************/
+  /*!
+    @brief  Map a rotated (logical) coordinate to the unrotated buffer
+            coordinate. The rotation is a template argument so the mapping
+            compiles down to plain arithmetic inside a raster loop.
+    @param  x  Logical column in, raw column out
+    @param  y  Logical row in, raw row out
+  */
+  /**********************************************************************/
+  template <uint8_t R> void rawCoords(int16_t &x, int16_t &y) const {
+    int16_t t;
+    if (R == 1) {
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+    } else if (R == 2) {
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+    } else if (R == 3) {
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Walk a line with the same Bresenham steps as writeLine(),
+            clipping each point to the rotated screen and handing it to
+            plot(x, y) in raw buffer coordinates. Subclasses dispatch on
+            the rotation once per line and get a switch-free inner loop.
+    @param  x0    Start point x coordinate
+    @param  y0    Start point y coordinate
+    @param  x1    End point x coordinate
+    @param  y1    End point y coordinate
+    @param  plot  Callable taking (int16_t x, int16_t y)
+  */
+  /**********************************************************************/
+  template <uint8_t R, class P>
+  void rasterLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, P &plot) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t t;
+    if (steep) {
+      t = x0, x0 = y0, y0 = t;
+      t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1) {
+      t = x0, x0 = x1, x1 = t;
+      t = y0, y0 = y1, y1 = t;
+    }
+    int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2, ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+      int16_t px = steep ? y0 : x0, py = steep ? x0 : y0;
+      if ((px >= 0) && (py >= 0) && (px < _width) && (py < _height)) {
+        rawCoords<R>(px, py);
+        plot(px, py);
+      }
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -243,6 +378,12 @@ protected:
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+
+private:
+  GFXmetrics *_metrics[GFX_METRICS_FONTS]; ///< RAM copies of glyph metrics
+  const GFXfont *_metrics_font[GFX_METRICS_FONTS]; ///< Font of each copy
+  GFXboundsEntry *_bounds;      ///< Recent bounds, most recently used first
+  uint8_t _bounds_count;        ///< Entries of _bounds in use
 };
 
 /// A simple drawn button UI element
@@ -312,6 +453,8 @@ public:
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
   bool getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -322,6 +465,9 @@ public:
   uint8_t *getBuffer(void) const { return buffer; }
 
 protected:
+  template <uint8_t R>
+  void writeRawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    uint16_t color);
   bool getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -19,12 +19,100 @@
 
 #include "Adafruit_GrayOLED.h"
 #include <Adafruit_GFX.h>
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#elif defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#endif
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
 
 // SOME DEFINES AND STATIC VARIABLES USED INTERNALLY -----------------------
 
 #define grayoled_swap(a, b)                                                    \
   (((a) ^= (b)), ((b) ^= (a)), ((a) ^= (b))) ///< No-temp-var swap operation
 
+/*!
+    @brief  Reverse the bit order of a byte.
+    @param  b  Byte to reverse.
+    @return b with bit 0 swapped with bit 7, 1 with 6 and so on.
+*/
+static uint8_t grayoled_reverse(uint8_t b) {
+  b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+  b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+  return ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+}
+
+/*!
+    @brief  Transpose an 8x8 block of bits with shifts and masks, turning 8
+            rows of pixels into 8 columns (Hacker's Delight, 7-3).
+    @param  in   8 bytes; bit m of in[k] is pixel (m, k).
+    @param  out  8 bytes; bit k of out[m] becomes pixel (m, k).
+*/
+static void grayoled_transpose(const uint8_t in[8], uint8_t out[8]) {
+  uint32_t x = ((uint32_t)in[7] << 24) | ((uint32_t)in[6] << 16) |
+               ((uint32_t)in[5] << 8) | in[4];
+  uint32_t y = ((uint32_t)in[3] << 24) | ((uint32_t)in[2] << 16) |
+               ((uint32_t)in[1] << 8) | in[0];
+  uint32_t t;
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+
+  out[7] = t >> 24;
+  out[6] = t >> 16;
+  out[5] = t >> 8;
+  out[4] = t;
+  out[3] = y >> 24;
+  out[2] = y >> 16;
+  out[1] = y >> 8;
+  out[0] = y;
+}
+
+/*!
+    @brief  Read 8 consecutive pixels of one line of a 1-bit bitmap.
+    @param  line    First byte of the line.
+    @param  stride  Distance between successive bytes of the line (1 for
+                    row-major bitmaps, the width for page format).
+    @param  len     Line length in pixels.
+    @param  p0      First pixel wanted, may be negative.
+    @param  flags   GFX_BITMAP_PROGMEM, GFX_BITMAP_XBM, GRAYOLED_BLIT_PAGES.
+    @return Pixels p0 to p0 + 7 in bits 0 to 7; pixels outside the line
+            read as clear.
+*/
+static uint8_t grayoled_run(const uint8_t *line, int16_t stride, int16_t len,
+                            int16_t p0, uint8_t flags) {
+  int16_t lo = max((int16_t)0, (int16_t)-p0);
+  int16_t hi = min((int16_t)7, (int16_t)(len - 1 - p0));
+  if (lo > hi) {
+    return 0;
+  }
+  int16_t b = (p0 >= 0) ? (p0 / 8) : -((7 - p0) / 8); // floor(p0 / 8)
+  uint8_t shift = p0 - b * 8;
+  bool lsb = flags & (GFX_BITMAP_XBM | GRAYOLED_BLIT_PAGES);
+  uint16_t bits = 0;
+
+  for (uint8_t n = 0; n < (shift ? 2 : 1); n++, b++) {
+    if ((b < 0) || (b >= (len + 7) / 8)) {
+      continue;
+    }
+    const uint8_t *ptr = line + (int32_t)b * stride;
+    uint8_t v = (flags & GFX_BITMAP_PROGMEM) ? pgm_read_byte(ptr) : *ptr;
+    bits |= (uint16_t)(lsb ? v : grayoled_reverse(v)) << (n * 8);
+  }
+  return (bits >> shift) & (0xFF << lo) & (0xFF >> (7 - hi));
+}
+
 // CONSTRUCTORS, DESTRUCTOR ------------------------------------------------
 
 /*!
@@ -151,6 +239,19 @@ Adafruit_GrayOLED::~Adafruit_GrayOLED(void) {
     free(buffer);
     buffer = NULL;
   }
+  if (shadow) {
+    free(shadow);
+    shadow = NULL;
+  }
+  enableGlyphCache(0, 0);
+  if (page_x1) {
+    free(page_x1);
+    page_x1 = NULL;
+  }
+  if (page_x2) {
+    free(page_x2);
+    page_x2 = NULL;
+  }
   if (spi_dev)
     delete spi_dev;
   if (i2c_dev)
@@ -228,6 +329,17 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
     return false;
   }
 
+  // monochrome displays also track a dirty column span for each 8-row page
+  if (_bpp == 1) {
+    uint8_t pages = (HEIGHT + 7) / 8;
+    if ((!page_x1) && !(page_x1 = (int16_t *)malloc(pages * sizeof(int16_t)))) {
+      return false;
+    }
+    if ((!page_x2) && !(page_x2 = (int16_t *)malloc(pages * sizeof(int16_t)))) {
+      return false;
+    }
+  }
+
   // Reset OLED if requested and reset pin specified in constructor
   if (reset && (rstPin >= 0)) {
     pinMode(rstPin, OUTPUT);
@@ -253,17 +365,136 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
     pinMode(dcPin, OUTPUT); // Set data/command pin as output
   }
 
+  _clearDirty();
+  _invalidateShadow(); // panel contents are unknown after reset
   clearDisplay();
 
-  // set max dirty window
-  window_x1 = 0;
-  window_y1 = 0;
-  window_x2 = WIDTH - 1;
-  window_y2 = HEIGHT - 1;
-
   return true; // Success
 }
 
+// DIRTY TRACKING ----------------------------------------------------------
+
+/*!
+    @brief  Grow the dirty window (and, on 1bpp displays, the per-page dirty
+            spans) to include a rectangle of display memory.
+    @param  x1  Left column, in unrotated display coordinates.
+    @param  y1  Top row, in unrotated display coordinates.
+    @param  x2  Right column (inclusive), in unrotated display coordinates.
+    @param  y2  Bottom row (inclusive), in unrotated display coordinates.
+    @note   Coordinates must already be clipped to the display.
+*/
+void Adafruit_GrayOLED::_markDirty(int16_t x1, int16_t y1, int16_t x2,
+                                   int16_t y2) {
+  window_x1 = min(window_x1, x1);
+  window_y1 = min(window_y1, y1);
+  window_x2 = max(window_x2, x2);
+  window_y2 = max(window_y2, y2);
+
+  if (page_x1 && page_x2) {
+    for (int16_t p = y1 / 8; p <= y2 / 8; p++) {
+      page_x1[p] = min(page_x1[p], x1);
+      page_x2[p] = max(page_x2[p], x2);
+    }
+  }
+}
+
+/*!
+    @brief  Reset the dirty window and per-page spans to 'nothing changed'.
+            Called by subclasses once display() has pushed the buffer.
+*/
+void Adafruit_GrayOLED::_clearDirty(void) {
+  window_x1 = 1024;
+  window_y1 = 1024;
+  window_x2 = -1;
+  window_y2 = -1;
+
+  if (page_x1 && page_x2) {
+    for (uint8_t p = 0; p < (HEIGHT + 7) / 8; p++) {
+      page_x1[p] = 1024;
+      page_x2[p] = -1;
+    }
+  }
+
+  // whatever was dirty has been sent and copied, so the shadow is current
+  _shadow_valid = (shadow != NULL);
+}
+
+/*!
+    @brief  Forget what the panel is showing. The whole screen is marked
+            dirty and the next display() sends it in full, refilling the
+            shadow buffer (if one is enabled) as it goes.
+*/
+void Adafruit_GrayOLED::_invalidateShadow(void) {
+  _shadow_valid = false;
+  _markDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+}
+
+/*!
+    @brief  Find the next run of bytes in a page that must be sent to the
+            panel, and record it as sent in the shadow buffer.
+    @param  page    Page (group of 8 rows) to search.
+    @param  from    First column to consider.
+    @param  to      Last column to consider (inclusive).
+    @param  run_x1  Set to the first column of the run.
+    @param  run_x2  Set to the last column of the run (inclusive).
+    @return true if a run was found, false if [from, to] needs no update.
+    @note   Without a valid shadow buffer the whole of [from, to] is one
+            run. Otherwise only bytes that differ from the shadow are
+            returned, with runs separated by fewer than
+            GRAYOLED_SHADOW_MERGE_GAP unchanged bytes merged together.
+            Callers loop, passing run_x2 + 1 as the next 'from'.
+*/
+bool Adafruit_GrayOLED::_nextChangedRun(uint8_t page, int16_t from, int16_t to,
+                                        int16_t *run_x1, int16_t *run_x2) {
+  if (from > to) {
+    return false;
+  }
+  uint8_t *cur = buffer + (uint16_t)page * WIDTH;
+
+  if (!shadow || !_shadow_valid) {
+    *run_x1 = from;
+    *run_x2 = to;
+    if (shadow) {
+      memcpy(shadow + (uint16_t)page * WIDTH + from, cur + from, to - from + 1);
+    }
+    return true;
+  }
+
+  uint8_t *old = shadow + (uint16_t)page * WIDTH;
+  int16_t x = from;
+
+  // skip unchanged bytes a word at a time, then finish byte-wise
+  while (x + 4 <= to + 1) {
+    uint32_t a, b;
+    memcpy(&a, cur + x, 4);
+    memcpy(&b, old + x, 4);
+    if (a != b) {
+      break;
+    }
+    x += 4;
+  }
+  while ((x <= to) && (cur[x] == old[x])) {
+    x++;
+  }
+  if (x > to) {
+    return false; // dirty, but redrawn with identical contents
+  }
+
+  // extend the run until a long enough stretch of unchanged bytes
+  int16_t last = x;
+  for (int16_t i = x + 1; (i <= to) && (i - last <= GRAYOLED_SHADOW_MERGE_GAP);
+       i++) {
+    if (cur[i] != old[i]) {
+      last = i;
+    }
+  }
+
+  *run_x1 = x;
+  *run_x2 = last;
+  memcpy(old + x, cur + x, last - x + 1);
+  return true;
+}
+
 // DRAWING FUNCTIONS -------------------------------------------------------
 
 /*!
@@ -306,6 +537,11 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
     window_y2 = max(window_y2, y);
 
     if (_bpp == 1) {
+      // adjust dirty span of this page
+      uint8_t p = y / 8;
+      page_x1[p] = min(page_x1[p], x);
+      page_x2[p] = max(page_x2[p], x);
+
       switch (color) {
       case MONOOLED_WHITE:
         buffer[x + (y / 8) * WIDTH] |= (1 << (y & 7));
@@ -334,6 +570,736 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
   }
 }
 
+/*!
+    @brief  Draw a horizontal line. On monochrome displays this sets whole
+            columns of a page at once instead of going pixel by pixel.
+    @param  x      Leftmost column.
+    @param  y      Row.
+    @param  w      Width in pixels.
+    @param  color  Line color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                      uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/*!
+    @brief  Draw a vertical line. On monochrome displays this writes one
+            masked byte per page instead of one pixel at a time.
+    @param  x      Column.
+    @param  y      Topmost row.
+    @param  h      Height in pixels.
+    @param  color  Line color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                      uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/*!
+    @brief  Draw a sloped line. On monochrome displays the rotation is
+            resolved once per line and the pixels are set by a loop
+            specialised for it; the dirty spans are grown once per page
+            the line crosses rather than once per pixel.
+    @param  x0     Start point x coordinate.
+    @param  y0     Start point y coordinate.
+    @param  x1     End point x coordinate.
+    @param  y1     End point y coordinate.
+    @param  color  Line color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::writeLine(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, uint16_t color) {
+  if (_bpp != 1) {
+    Adafruit_GFX::writeLine(x0, y0, x1, y1, color);
+    return;
+  }
+#if defined(ESP8266)
+  yield();
+#endif
+  switch (getRotation()) {
+  case 0:
+    writeRawLine<0>(x0, y0, x1, y1, color);
+    break;
+  case 1:
+    writeRawLine<1>(x0, y0, x1, y1, color);
+    break;
+  case 2:
+    writeRawLine<2>(x0, y0, x1, y1, color);
+    break;
+  case 3:
+    writeRawLine<3>(x0, y0, x1, y1, color);
+    break;
+  }
+}
+
+/*!
+    @brief  Line inner loop for one rotation of a monochrome buffer, see
+            writeLine().
+    @param  x0     Start point x coordinate.
+    @param  y0     Start point y coordinate.
+    @param  x1     End point x coordinate.
+    @param  y1     End point y coordinate.
+    @param  color  Line color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+template <uint8_t R>
+void Adafruit_GrayOLED::writeRawLine(int16_t x0, int16_t y0, int16_t x1,
+                                     int16_t y1, uint16_t color) {
+  // Bresenham is monotonic, so each page is entered once: collect the
+  // columns and rows touched in it and mark them dirty on the way out.
+  int16_t page = -1, sx1 = 0, sx2 = 0, sy1 = 0, sy2 = 0;
+  auto plot = [&](int16_t x, int16_t y) {
+    int16_t p = y / 8;
+    if (p != page) {
+      if (page >= 0)
+        _markDirty(sx1, sy1, sx2, sy2);
+      page = p;
+      sx1 = sx2 = x;
+      sy1 = sy2 = y;
+    } else {
+      sx1 = min(sx1, x);
+      sx2 = max(sx2, x);
+      sy1 = min(sy1, y);
+      sy2 = max(sy2, y);
+    }
+    uint8_t *ptr = &buffer[x + p * WIDTH];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+    case MONOOLED_WHITE:
+      *ptr |= bit;
+      break;
+    case MONOOLED_BLACK:
+      *ptr &= ~bit;
+      break;
+    case MONOOLED_INVERSE:
+      *ptr ^= bit;
+      break;
+    }
+  };
+  rasterLine<R>(x0, y0, x1, y1, plot);
+  if (page >= 0)
+    _markDirty(sx1, sy1, sx2, sy2);
+}
+
+/*!
+    @brief  Fill a rectangle. On monochrome displays the rectangle is
+            clipped and rotated once, then filled a page at a time with
+            byte masks, and the dirty window is updated once.
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  Fill color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  if (_bpp != 1) {
+    Adafruit_GFX::fillRect(x, y, w, h, color);
+    return;
+  }
+
+  if (w < 0) { // Convert negative sizes to positive equivalent
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+
+  // Clip to the (rotated) screen
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > width()) {
+    w = width() - x;
+  }
+  if (y + h > height()) {
+    h = height() - y;
+  }
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  // Rotate the whole rectangle into raw display coordinates
+  switch (getRotation()) {
+  case 1:
+    fillRawRect(WIDTH - y - h, x, h, w, color);
+    break;
+  case 2:
+    fillRawRect(WIDTH - x - w, HEIGHT - y - h, w, h, color);
+    break;
+  case 3:
+    fillRawRect(y, HEIGHT - x - w, h, w, color);
+    break;
+  default:
+    fillRawRect(x, y, w, h, color);
+    break;
+  }
+}
+
+/*!
+    @brief  Fill the whole buffer with one color.
+    @param  color  Fill color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::fillScreen(uint16_t color) {
+  if ((_bpp == 1) && (color != MONOOLED_INVERSE)) {
+    memset(buffer, (color == MONOOLED_WHITE) ? 0xFF : 0x00,
+           WIDTH * ((HEIGHT + 7) / 8));
+    _markDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+    return;
+  }
+  fillRect(0, 0, width(), height(), color);
+}
+
+/*!
+    @brief  Fill a rectangle of a monochrome buffer, already clipped and in
+            raw (rotation 0) coordinates.
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  w      Width in pixels, at least 1.
+    @param  h      Height in pixels, at least 1.
+    @param  color  Fill color, one of: MONOOLED_BLACK, MONOOLED_WHITE or
+                   MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::fillRawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    uint16_t color) {
+  int16_t y2 = y + h - 1;
+  uint8_t first_page = y / 8, last_page = y2 / 8;
+
+  _markDirty(x, y, x + w - 1, y2);
+
+  for (uint8_t p = first_page; p <= last_page; p++) {
+    // rows of this page covered by the rectangle
+    uint8_t mask = 0xFF;
+    if (p == first_page) {
+      mask &= 0xFF << (y & 7);
+    }
+    if (p == last_page) {
+      mask &= 0xFF >> (7 - (y2 & 7));
+    }
+
+    uint8_t *ptr = buffer + (uint16_t)p * WIDTH + x;
+    switch (color) {
+    case MONOOLED_WHITE:
+      if (mask == 0xFF) {
+        memset(ptr, 0xFF, w);
+      } else {
+        for (int16_t i = 0; i < w; i++) {
+          ptr[i] |= mask;
+        }
+      }
+      break;
+    case MONOOLED_BLACK:
+      if (mask == 0xFF) {
+        memset(ptr, 0x00, w);
+      } else {
+        for (int16_t i = 0; i < w; i++) {
+          ptr[i] &= ~mask;
+        }
+      }
+      break;
+    case MONOOLED_INVERSE:
+      for (int16_t i = 0; i < w; i++) {
+        ptr[i] ^= mask;
+      }
+      break;
+    }
+  }
+}
+
+/*!
+    @brief  Copy a page-format bitmap (columns of 8 vertical pixels, LSB on
+            top, like the display buffer itself) into the buffer a byte at
+            a time, shifting it to any row and clipping to the display.
+    @param  src    Bitmap, (h + 7) / 8 rows of w bytes. Bits below row h
+                   of the last row of bytes are ignored.
+    @param  x      Left column, in raw (unrotated) display coordinates.
+    @param  y      Top row, in raw (unrotated) display coordinates.
+    @param  w      Bitmap width in pixels.
+    @param  h      Bitmap height in pixels.
+    @param  color  Color for set bits, one of: MONOOLED_BLACK, MONOOLED_WHITE
+                   or MONOOLED_INVERSE.
+    @param  bg     Color for clear bits inside the w x h box. If the same as
+                   color, clear bits are left untouched (transparent);
+                   otherwise color and bg must be black and white.
+*/
+void Adafruit_GrayOLED::blitPages(const uint8_t *src, int16_t x, int16_t y,
+                                  int16_t w, int16_t h, uint16_t color,
+                                  uint16_t bg) {
+  int16_t c0 = max((int16_t)0, (int16_t)-x);
+  int16_t c1 = min(w, (int16_t)(WIDTH - x));
+  int16_t y2 = y + h - 1;
+  if ((c0 >= c1) || (y >= HEIGHT) || (y2 < 0)) {
+    return; // entirely off screen
+  }
+  _markDirty(x + c0, max((int16_t)0, y), x + c1 - 1,
+             min((int16_t)(HEIGHT - 1), y2));
+
+  int16_t pages = (HEIGHT + 7) / 8;
+  int16_t base = (y >= 0) ? (y / 8) : -((7 - y) / 8); // floor(y / 8)
+  uint8_t shift = y - base * 8;
+  bool opaque = (bg != color);
+
+  for (int16_t sp = 0; sp < (h + 7) / 8; sp++) {
+    int16_t dp = base + sp; // destination page of the low byte
+    uint8_t rows = min((int16_t)8, (int16_t)(h - sp * 8));
+    uint16_t box = (uint16_t)(0xFF >> (8 - rows)) << shift;
+    bool lo = (dp >= 0) && (dp < pages);
+    bool hi = shift && (dp + 1 >= 0) && (dp + 1 < pages);
+    uint8_t *dst = buffer + (int32_t)dp * WIDTH + x;
+    const uint8_t *row = src + sp * w;
+
+    for (int16_t i = c0; i < c1; i++) {
+      uint16_t bits = ((uint16_t)row[i] << shift) & box;
+      uint16_t out, keep;
+      if (opaque) { // whole box is written: set bits in color, rest in bg
+        keep = box;
+        out = (color == MONOOLED_WHITE) ? bits : (box & ~bits);
+      } else if (color == MONOOLED_WHITE) {
+        keep = bits;
+        out = bits;
+      } else if (color == MONOOLED_BLACK) {
+        keep = bits;
+        out = 0;
+      } else { // MONOOLED_INVERSE
+        if (lo)
+          dst[i] ^= bits;
+        if (hi)
+          dst[i + WIDTH] ^= bits >> 8;
+        continue;
+      }
+      if (lo)
+        dst[i] = (dst[i] & ~keep) | out;
+      if (hi)
+        dst[i + WIDTH] = (dst[i + WIDTH] & ~(keep >> 8)) | (out >> 8);
+    }
+  }
+}
+
+/*!
+    @brief  Draw a 1-bit bitmap in logical (rotated) coordinates through
+            blitPages(). The rotation is resolved once; the bitmap is then
+            converted to page format GRAYOLED_BLIT_CHUNK columns at a time,
+            8 pixels per read, with an 8x8 bit transpose where the rotated
+            bitmap's bytes run across the pages instead of down them.
+    @param  src    Bitmap, row-major ((w + 7) / 8 bytes per row) or, with
+                   GRAYOLED_BLIT_PAGES, page format ((h + 7) / 8 rows of w
+                   bytes).
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  Color for set bits, see blitPages().
+    @param  bg     Color for clear bits, see blitPages().
+    @param  flags  GFX_BITMAP_PROGMEM, GFX_BITMAP_XBM, GRAYOLED_BLIT_PAGES.
+*/
+void Adafruit_GrayOLED::blitBits(const uint8_t *src, int16_t x, int16_t y,
+                                 int16_t w, int16_t h, uint16_t color,
+                                 uint16_t bg, uint8_t flags) {
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+  // Raw rectangle covered, and how its columns (u) and rows (v) walk the
+  // bitmap: v runs along bitmap rows in rotations 1 and 3, down its
+  // columns in 0 and 2; either may run backwards.
+  int16_t rx, ry, rw, rh;
+  bool v_is_x, u_rev, v_rev;
+  switch (getRotation()) {
+  case 0:
+  default:
+    rx = x, ry = y, rw = w, rh = h;
+    v_is_x = false, u_rev = false, v_rev = false;
+    break;
+  case 1:
+    rx = WIDTH - y - h, ry = x, rw = h, rh = w;
+    v_is_x = true, u_rev = true, v_rev = false;
+    break;
+  case 2:
+    rx = WIDTH - x - w, ry = HEIGHT - y - h, rw = w, rh = h;
+    v_is_x = false, u_rev = true, v_rev = true;
+    break;
+  case 3:
+    rx = y, ry = HEIGHT - x - w, rw = h, rh = w;
+    v_is_x = true, u_rev = false, v_rev = true;
+    break;
+  }
+
+  // Lines of the source are rows (bytes along x) or, for page format,
+  // columns (bytes down y)
+  bool pages = flags & GRAYOLED_BLIT_PAGES;
+  int16_t stride = pages ? w : 1;
+  int16_t span = pages ? 1 : (w + 7) / 8; // from one line to the next
+  int16_t len = pages ? h : w;
+  bool v_along = (v_is_x != pages); // v runs along the source lines
+
+  uint8_t tmp[GRAYOLED_BLIT_CHUNK];
+  for (int16_t v0 = 0; v0 < rh; v0 += 8) {
+    int16_t rows = min((int16_t)8, (int16_t)(rh - v0));
+    if ((ry + v0 >= HEIGHT) || (ry + v0 + rows <= 0)) {
+      continue;
+    }
+    for (int16_t u0 = 0; u0 < rw; u0 += GRAYOLED_BLIT_CHUNK) {
+      int16_t n = min((int16_t)GRAYOLED_BLIT_CHUNK, (int16_t)(rw - u0));
+      if ((rx + u0 >= WIDTH) || (rx + u0 + n <= 0)) {
+        continue;
+      }
+      if (v_along) { // each output byte is one 8-pixel read
+        int16_t p0 = v_rev ? (rh - 8 - v0) : v0;
+        for (int16_t k = 0; k < n; k++) {
+          int16_t l = u_rev ? (rw - 1 - u0 - k) : (u0 + k);
+          uint8_t b = grayoled_run(src + (int32_t)l * span, stride, len, p0,
+                                   flags);
+          tmp[k] = v_rev ? grayoled_reverse(b) : b;
+        }
+      } else { // read 8 lines across, transpose into 8 output bytes
+        for (int16_t c = 0; c < n; c += 8) {
+          int16_t p0 = u_rev ? (rw - 8 - u0 - c) : (u0 + c);
+          uint8_t in[8], out[8];
+          for (uint8_t k = 0; k < 8; k++) {
+            int16_t l = v_rev ? (rh - 1 - v0 - k) : (v0 + k);
+            uint8_t b = 0;
+            if ((l >= 0) && (l < rh)) {
+              b = grayoled_run(src + (int32_t)l * span, stride, len, p0,
+                               flags);
+            }
+            in[k] = u_rev ? grayoled_reverse(b) : b;
+          }
+          grayoled_transpose(in, out);
+          memcpy(tmp + c, out, min((int16_t)8, (int16_t)(n - c)));
+        }
+      }
+      blitPages(tmp, rx + u0, ry + v0, n, rows, color, bg);
+    }
+  }
+}
+
+/*!
+    @brief  Draw a 1-bit bitmap; every drawBitmap() and drawXBitmap()
+            variant lands here. On monochrome displays it goes through
+            blitBits() a byte at a time instead of pixel by pixel.
+    @param  x       Left column.
+    @param  y       Top row.
+    @param  bitmap  Row-major bitmap, (w + 7) / 8 bytes per row.
+    @param  w       Width in pixels.
+    @param  h       Height in pixels.
+    @param  color   Color for set bits.
+    @param  bg      Color for clear bits, if GFX_BITMAP_OPAQUE.
+    @param  flags   GFX_BITMAP_PROGMEM, GFX_BITMAP_XBM, GFX_BITMAP_OPAQUE.
+*/
+void Adafruit_GrayOLED::drawMonoBitmap(int16_t x, int16_t y,
+                                       const uint8_t *bitmap, int16_t w,
+                                       int16_t h, uint16_t color, uint16_t bg,
+                                       uint8_t flags) {
+  bool opaque = flags & GFX_BITMAP_OPAQUE;
+  if ((_bpp == 1) && opaque && (bg == color)) {
+    fillRect(x, y, w, h, color); // every pixel gets the same color
+    return;
+  }
+  bool mono = opaque ? ((color | bg) == MONOOLED_WHITE)
+                     : (color <= MONOOLED_INVERSE);
+  if ((_bpp != 1) || !mono) {
+    Adafruit_GFX::drawMonoBitmap(x, y, bitmap, w, h, color, bg, flags);
+    return;
+  }
+  blitBits(bitmap, x, y, w, h, color, opaque ? bg : color,
+           flags & ~GFX_BITMAP_OPAQUE);
+}
+
+/*!
+    @brief  Draw a page-format icon, leaving its clear pixels untouched.
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  icon   Icon to draw.
+    @param  color  Color for set pixels, one of: MONOOLED_BLACK,
+                   MONOOLED_WHITE or MONOOLED_INVERSE.
+*/
+void Adafruit_GrayOLED::drawIcon(int16_t x, int16_t y,
+                                 const GrayOLED_icon *icon, uint16_t color) {
+  drawIcon(x, y, icon, color, color);
+}
+
+/*!
+    @brief  Draw a page-format icon. Unrotated, on a monochrome display
+            with the icon in addressable memory, this is a straight
+            blitPages() with no conversion at all.
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  icon   Icon to draw.
+    @param  color  Color for set pixels, one of: MONOOLED_BLACK,
+                   MONOOLED_WHITE or MONOOLED_INVERSE.
+    @param  bg     Color for clear pixels. If the same as color they are
+                   left untouched; otherwise color and bg must be black
+                   and white.
+*/
+void Adafruit_GrayOLED::drawIcon(int16_t x, int16_t y,
+                                 const GrayOLED_icon *icon, uint16_t color,
+                                 uint16_t bg) {
+  int16_t w = icon->width, h = icon->height;
+  if (_bpp != 1) {
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t i = 0; i < w; i++) {
+        uint8_t b = pgm_read_byte(&icon->bitmap[(j / 8) * w + i]);
+        if (b & (1 << (j & 7))) {
+          drawPixel(x + i, y + j, color);
+        } else if (bg != color) {
+          drawPixel(x + i, y + j, bg);
+        }
+      }
+    }
+    return;
+  }
+#if !defined(__AVR__)
+  if (getRotation() == 0) { // PROGMEM is plain memory here
+    blitPages(icon->bitmap, x, y, w, h, color, bg);
+    return;
+  }
+#endif
+  blitBits(icon->bitmap, x, y, w, h, color, bg,
+           GFX_BITMAP_PROGMEM | GRAYOLED_BLIT_PAGES);
+}
+
+/*!
+    @brief  Draw a single character. On monochrome displays with the glyph
+            cache enabled, each character is rendered once (for the current
+            font, size, rotation and cp437() setting) into page format and
+            then copied into the buffer with blitPages(), instead of pixel
+            by pixel.
+    @param  x       Left of the character cell (classic font) or cursor X
+                    (custom fonts).
+    @param  y       Top of the character cell (classic font) or baseline
+                    (custom fonts).
+    @param  c       The character.
+    @param  color   Text color.
+    @param  bg      Background color, or the same as color for transparent
+                    text. Custom fonts are always transparent.
+    @param  size_x  Horizontal magnification.
+    @param  size_y  Vertical magnification.
+*/
+void Adafruit_GrayOLED::drawChar(int16_t x, int16_t y, unsigned char c,
+                                 uint16_t color, uint16_t bg, uint8_t size_x,
+                                 uint8_t size_y) {
+  bool opaque = (bg != color) && !gfxFont;
+  GrayOLED_glyph *g = NULL;
+
+  if ((_bpp == 1) && _glyphs && (color <= MONOOLED_INVERSE) &&
+      (!opaque || ((color <= MONOOLED_WHITE) && (bg <= MONOOLED_WHITE)))) {
+    g = cacheGlyph(c, size_x, size_y);
+  }
+  if (!g) {
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+    return;
+  }
+
+  // glyph box in rotated coordinates, then its raw corner
+  int16_t lx = x + g->xo * size_x, ly = y + g->yo * size_y;
+  int16_t lw = (g->rotation & 1) ? g->h : g->w;
+  int16_t lh = (g->rotation & 1) ? g->w : g->h;
+  int16_t rx, ry;
+  switch (g->rotation) {
+  case 1:
+    rx = WIDTH - ly - lh;
+    ry = lx;
+    break;
+  case 2:
+    rx = WIDTH - lx - lw;
+    ry = HEIGHT - ly - lh;
+    break;
+  case 3:
+    rx = ly;
+    ry = HEIGHT - lx - lw;
+    break;
+  default:
+    rx = lx;
+    ry = ly;
+    break;
+  }
+  blitPages(_glyph_arena + g->offset, rx, ry, g->w, g->h, color,
+            opaque ? bg : color);
+}
+
+/*!
+    @brief  Find a character in the glyph cache, rendering it into the cache
+            first if it is not there yet.
+    @param  c       The character, as passed to drawChar().
+    @param  size_x  Horizontal magnification.
+    @param  size_y  Vertical magnification.
+    @return The cache entry, or NULL if the glyph is empty or too big to
+            cache.
+    @note   When the slots or arena run out the whole cache is dropped and
+            refilled, which keeps it free of fragmentation.
+*/
+GrayOLED_glyph *Adafruit_GrayOLED::cacheGlyph(unsigned char c, uint8_t size_x,
+                                              uint8_t size_y) {
+  uint8_t rot = getRotation();
+  bool cp437 = !gfxFont && _cp437; // custom fonts ignore it
+  uint8_t start = (c + size_x * 7 + size_y * 13 + rot * 31 +
+                   ((uintptr_t)gfxFont >> 2)) %
+                  _glyph_slots;
+  uint8_t i = start;
+  bool free_slot = false;
+
+  do {
+    GrayOLED_glyph *g = &_glyphs[i];
+    if (g->rotation == 0xFF) {
+      free_slot = true;
+      break;
+    }
+    if ((g->c == c) && (g->font == gfxFont) && (g->size_x == size_x) &&
+        (g->size_y == size_y) && (g->rotation == rot) &&
+        (g->cp437 == cp437)) {
+      return g;
+    }
+    i = (i + 1) % _glyph_slots;
+  } while (i != start);
+
+  int8_t xo, yo;
+  uint8_t gw, gh;
+  glyphBox(c, &xo, &yo, &gw, &gh);
+
+  // classic glyphs are cached as the full 6-column cell for opaque text
+  uint16_t lw = (gfxFont ? gw : 6) * size_x, lh = gh * size_y;
+  uint16_t rw = (rot & 1) ? lh : lw, rh = (rot & 1) ? lw : lh;
+  uint16_t bytes = rw * ((rh + 7) / 8);
+  if (!bytes || (rw > 255) || (rh > 255) || (bytes > _glyph_arena_size)) {
+    return NULL;
+  }
+  if (!free_slot || (_glyph_arena_used + bytes > _glyph_arena_size)) {
+    clearGlyphCache();
+    i = start;
+  }
+
+  GrayOLED_glyph *g = &_glyphs[i];
+  g->font = gfxFont;
+  g->offset = _glyph_arena_used;
+  g->c = c;
+  g->size_x = size_x;
+  g->size_y = size_y;
+  g->rotation = rot;
+  g->cp437 = cp437;
+  g->w = rw;
+  g->h = rh;
+  g->xo = xo;
+  g->yo = yo;
+  _glyph_arena_used += bytes;
+
+  uint8_t *dst = _glyph_arena + g->offset;
+  memset(dst, 0, bytes);
+
+  // custom font glyphs are walked run by run, which also decodes RLE fonts
+  GFXglyphSpans spans;
+  uint16_t run_start = 0, run_len = 0;
+  bool run = false;
+  if (gfxFont) {
+    glyphSpansBegin(c, &spans);
+    run = glyphSpan(&spans, &run_start, &run_len);
+  }
+  for (uint8_t gy = 0; gy < gh; gy++) {
+    for (uint8_t gx = 0; gx < gw; gx++) {
+      if (gfxFont) {
+        uint16_t i = gy * gw + gx;
+        while (run && (i >= run_start + run_len)) {
+          run = glyphSpan(&spans, &run_start, &run_len);
+        }
+        if (!run || (i < run_start)) {
+          continue;
+        }
+      } else if (!glyphPixel(c, gx, gy)) {
+        continue;
+      }
+      for (uint8_t sy = 0; sy < size_y; sy++) {
+        for (uint8_t sx = 0; sx < size_x; sx++) {
+          // rotate the pixel within the box, as drawPixel() would
+          int16_t px = gx * size_x + sx, py = gy * size_y + sy, bx, by;
+          switch (rot) {
+          case 1:
+            bx = lh - 1 - py;
+            by = px;
+            break;
+          case 2:
+            bx = lw - 1 - px;
+            by = lh - 1 - py;
+            break;
+          case 3:
+            bx = py;
+            by = lw - 1 - px;
+            break;
+          default:
+            bx = px;
+            by = py;
+            break;
+          }
+          dst[(by / 8) * rw + bx] |= 1 << (by & 7);
+        }
+      }
+    }
+  }
+  return g;
+}
+
+/*!
+    @brief  Enable (or resize, or disable) the glyph cache used by
+            drawChar().
+    @param  bytes
+            Size of the arena holding pre-rendered glyphs. A 6x8 classic
+            character takes 6 bytes at size 1, 24 at size 2. Pass 0 to free
+            the cache.
+    @param  slots
+            Most glyphs held at once.
+    @return true on success, false if memory could not be allocated or the
+            display is not monochrome.
+*/
+bool Adafruit_GrayOLED::enableGlyphCache(uint16_t bytes, uint8_t slots) {
+  if (_glyphs) {
+    free(_glyphs);
+    _glyphs = NULL;
+  }
+  if (_glyph_arena) {
+    free(_glyph_arena);
+    _glyph_arena = NULL;
+  }
+  _glyph_slots = 0;
+  _glyph_arena_size = _glyph_arena_used = 0;
+
+  if (!bytes || !slots) {
+    return true;
+  }
+  if (_bpp != 1) {
+    return false;
+  }
+  _glyphs = (GrayOLED_glyph *)malloc(slots * sizeof(GrayOLED_glyph));
+  _glyph_arena = (uint8_t *)malloc(bytes);
+  if (!_glyphs || !_glyph_arena) {
+    enableGlyphCache(0, 0);
+    return false;
+  }
+  _glyph_slots = slots;
+  _glyph_arena_size = bytes;
+  clearGlyphCache();
+  return true;
+}
+
+/*!
+    @brief  Drop every glyph from the cache. Only needed if font data in RAM
+            is changed after it has been drawn.
+*/
+void Adafruit_GrayOLED::clearGlyphCache(void) {
+  for (uint8_t i = 0; i < _glyph_slots; i++) {
+    _glyphs[i].rotation = 0xFF;
+  }
+  _glyph_arena_used = 0;
+}
+
 /*!
     @brief  Clear contents of display buffer (set all pixels to off).
     @note   Changes buffer contents only, no immediate effect on display.
@@ -343,10 +1309,7 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
 void Adafruit_GrayOLED::clearDisplay(void) {
   memset(buffer, 0, _bpp * WIDTH * ((HEIGHT + 7) / 8));
   // set max dirty window
-  window_x1 = 0;
-  window_y1 = 0;
-  window_x2 = WIDTH - 1;
-  window_y2 = HEIGHT - 1;
+  _markDirty(0, 0, WIDTH - 1, HEIGHT - 1);
 }
 
 /*!
@@ -382,6 +1345,114 @@ bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y) {
   return false; // Pixel out of bounds
 }
 
+/*!
+    @brief  Scroll part of the display buffer sideways, e.g. to advance a
+            strip chart by one sample without redrawing it. Columns moved
+            in at the trailing edge are cleared (black). Monochrome only.
+    @param  x   Left edge of the area, in current rotation.
+    @param  y   Top edge of the area, in current rotation.
+    @param  w   Width of the area in pixels.
+    @param  h   Height of the area in pixels.
+    @param  dx  Pixels to move the contents left, negative to move right.
+    @note   In rotations 0 and 2 each page row of the area is moved with
+            byte copies (memmove where whole pages are covered). In
+            rotations 1 and 3 the area's columns run down the pages, so
+            each buffer column is shifted up or down by dx bits, a page
+            byte at a time.
+*/
+void Adafruit_GrayOLED::scrollRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   int16_t dx) {
+  if (_bpp != 1) {
+    return;
+  }
+  // clip to the screen in current rotation
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  w = min(w, (int16_t)(width() - x));
+  h = min(h, (int16_t)(height() - y));
+  if ((w <= 0) || (h <= 0) || !dx) {
+    return;
+  }
+  if (abs(dx) >= w) {
+    fillRect(x, y, w, h, MONOOLED_BLACK);
+    return;
+  }
+
+  uint8_t r = getRotation();
+  if (r & 1) { // columns run across pages: shift each raw column's bits
+    int16_t rx = (r == 1) ? WIDTH - y - h : y;
+    int16_t ry = (r == 1) ? x : HEIGHT - x - w;
+    int16_t up = (r == 1) ? dx : -dx; // rows the contents move up
+    _markDirty(rx, ry, rx + h - 1, ry + w - 1);
+
+    int16_t p0 = ry / 8, pages = (ry + w - 1) / 8 - p0 + 1;
+    int16_t q = abs(up) / 8, b = abs(up) & 7;
+    uint8_t first = 0xFF << (ry & 7), last = 0xFF >> (7 - ((ry + w - 1) & 7));
+    auto mask = [&](int16_t k) -> uint8_t {
+      return ((k == 0) ? first : 0xFF) & ((k == pages - 1) ? last : 0xFF);
+    };
+    for (int16_t c = rx; c < rx + h; c++) {
+      uint8_t *col = buffer + p0 * WIDTH + c;
+      // bits outside the area read as clear, so they are not pulled in
+      auto in = [&](int16_t k) -> uint8_t {
+        return ((k >= 0) && (k < pages)) ? (col[k * WIDTH] & mask(k)) : 0;
+      };
+      // each byte only reads bytes not yet written, so this works in place
+      for (int16_t i = 0; i < pages; i++) {
+        int16_t k = (up > 0) ? i : (pages - 1 - i);
+        uint8_t out = (up > 0) ? ((in(k + q) >> b) | (in(k + q + 1) << (8 - b)))
+                               : ((in(k - q) << b) | (in(k - q - 1) >> (8 - b)));
+        col[k * WIDTH] = (col[k * WIDTH] & ~mask(k)) | (out & mask(k));
+      }
+    }
+    return;
+  }
+  if (r == 2) { // left in rotation 2 is right in the buffer
+    x = WIDTH - x - w;
+    y = HEIGHT - y - h;
+    dx = -dx;
+  }
+
+  _markDirty(x, y, x + w - 1, y + h - 1);
+  int16_t n = abs(dx);
+  for (int16_t p = y / 8; p <= (y + h - 1) / 8; p++) {
+    uint8_t mask = 0xFF;
+    if (p == y / 8) {
+      mask &= 0xFF << (y & 7);
+    }
+    if (p == (y + h - 1) / 8) {
+      mask &= 0xFF >> (7 - ((y + h - 1) & 7));
+    }
+    uint8_t *row = buffer + p * WIDTH + x;
+
+    if (mask == 0xFF) {
+      if (dx > 0) {
+        memmove(row, row + n, w - n);
+        memset(row + w - n, 0, n);
+      } else {
+        memmove(row + n, row, w - n);
+        memset(row, 0, n);
+      }
+    } else if (dx > 0) {
+      for (int16_t i = 0; i < w; i++) {
+        uint8_t src = (i + n < w) ? row[i + n] : 0;
+        row[i] = (row[i] & ~mask) | (src & mask);
+      }
+    } else {
+      for (int16_t i = w - 1; i >= 0; i--) {
+        uint8_t src = (i >= n) ? row[i - n] : 0;
+        row[i] = (row[i] & ~mask) | (src & mask);
+      }
+    }
+  }
+}
+
 /*!
     @brief  Get base address of display buffer for direct reading or writing.
     @return Pointer to an unsigned 8-bit array, column-major, columns padded
@@ -389,6 +1460,38 @@ bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y) {
 */
 uint8_t *Adafruit_GrayOLED::getBuffer(void) { return buffer; }
 
+/*!
+    @brief  Enable or disable the shadow framebuffer. With it enabled,
+            display() compares dirty areas against a copy of what the panel
+            last received and only sends bytes that actually changed, so
+            redrawing a whole screen with mostly the same content is cheap.
+    @param  enable
+            true to allocate the shadow buffer, false to free it.
+    @return true on success, false if the buffer could not be allocated or
+            the display is not monochrome.
+    @note   Costs a second framebuffer's worth of RAM. The next display()
+            after enabling sends the full screen.
+*/
+bool Adafruit_GrayOLED::enableShadowBuffer(bool enable) {
+  if (!enable) {
+    if (shadow) {
+      free(shadow);
+      shadow = NULL;
+    }
+    _shadow_valid = false;
+    return true;
+  }
+
+  if (_bpp != 1) {
+    return false;
+  }
+  if ((!shadow) && !(shadow = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8)))) {
+    return false;
+  }
+  _invalidateShadow();
+  return true;
+}
+
 // OTHER HARDWARE SETTINGS -------------------------------------------------
 
 /*!
@@ -40,6 +40,38 @@
 #define MONOOLED_WHITE 1   ///< Default white 'color' for monochrome OLEDS
 #define MONOOLED_INVERSE 2 ///< Default inversion command for monochrome OLEDS
 
+/// Changed byte runs closer than this are sent as one, since a new run costs
+/// a page/column address command anyway
+#define GRAYOLED_SHADOW_MERGE_GAP 6
+
+/// Columns converted per blitPages() call when drawing row-major bitmaps
+#define GRAYOLED_BLIT_CHUNK 32
+/// blitBits() flag: source is page format rather than row-major
+#define GRAYOLED_BLIT_PAGES 0x80
+
+/// A 1-bit image already in the display's page format, for drawIcon()
+typedef struct {
+  const uint8_t *bitmap; ///< PROGMEM, (height + 7) / 8 rows of width bytes,
+                         ///< each byte 8 vertical pixels with LSB on top
+  uint8_t width;         ///< Width in pixels
+  uint8_t height;        ///< Height in pixels
+} GrayOLED_icon;
+
+/// One pre-rendered glyph held in the GrayOLED glyph cache
+typedef struct {
+  const GFXfont *font; ///< Font it was rendered from, NULL for classic
+  uint16_t offset;     ///< Start of its page-format bitmap in the arena
+  unsigned char c;     ///< Character, as passed to drawChar()
+  uint8_t size_x;      ///< Horizontal magnification
+  uint8_t size_y;      ///< Vertical magnification
+  uint8_t rotation;    ///< Rotation it was rendered for, 0xFF if slot free
+  bool cp437;          ///< Classic font with cp437() set, which moves c >= 176
+  uint8_t w;           ///< Bitmap width in raw (unrotated) pixels
+  uint8_t h;           ///< Bitmap height in raw (unrotated) pixels
+  int8_t xo;           ///< Unscaled X offset from cursor to glyph box
+  int8_t yo;           ///< Unscaled Y offset from cursor to glyph box
+} GrayOLED_glyph;
+
 /*!
     @brief  Class that stores state and functions for interacting with
             generic grayscale OLED displays.
@@ -67,31 +99,76 @@ public:
   void invertDisplay(bool i);
   void setContrast(uint8_t contrastlevel);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  using Adafruit_GFX::drawChar;
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void drawIcon(int16_t x, int16_t y, const GrayOLED_icon *icon,
+                uint16_t color);
+  void drawIcon(int16_t x, int16_t y, const GrayOLED_icon *icon,
+                uint16_t color, uint16_t bg);
+  bool enableGlyphCache(uint16_t bytes = 1024, uint8_t slots = 48);
+  void clearGlyphCache(void);
   bool getPixel(int16_t x, int16_t y);
+  void scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx);
   uint8_t *getBuffer(void);
+  bool enableShadowBuffer(bool enable = true);
 
   void oled_command(uint8_t c);
   bool oled_commandList(const uint8_t *c, uint8_t n);
 
 protected:
   bool _init(uint8_t i2caddr = 0x3C, bool reset = true);
+  void fillRawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t color);
+  template <uint8_t R>
+  void writeRawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    uint16_t color);
+  void blitPages(const uint8_t *src, int16_t x, int16_t y, int16_t w,
+                 int16_t h, uint16_t color, uint16_t bg);
+  void blitBits(const uint8_t *src, int16_t x, int16_t y, int16_t w,
+                int16_t h, uint16_t color, uint16_t bg, uint8_t flags);
+  void drawMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                      int16_t h, uint16_t color, uint16_t bg, uint8_t flags);
+  GrayOLED_glyph *cacheGlyph(unsigned char c, uint8_t size_x, uint8_t size_y);
+  void _markDirty(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+  void _clearDirty(void);
+  void _invalidateShadow(void);
+  bool _nextChangedRun(uint8_t page, int16_t from, int16_t to, int16_t *run_x1,
+                       int16_t *run_x2);
 
   Adafruit_SPIDevice *spi_dev = NULL; ///< The SPI interface BusIO device
   Adafruit_I2CDevice *i2c_dev = NULL; ///< The I2C interface BusIO device
   int32_t i2c_preclk = 400000,        ///< Configurable 'high speed' I2C rate
       i2c_postclk = 100000;           ///< Configurable 'low speed' I2C rate
   uint8_t *buffer = NULL; ///< Internal 1:1 framebuffer of display mem
+  uint8_t *shadow = NULL; ///< Optional copy of what the panel last received
+  bool _shadow_valid = false; ///< True once shadow matches the panel
 
   int16_t window_x1, ///< Dirty tracking window minimum x
       window_y1,     ///< Dirty tracking window minimum y
       window_x2,     ///< Dirty tracking window maximum x
       window_y2;     ///< Dirty tracking window maximum y
 
+  int16_t *page_x1 = NULL, ///< Per-page (8 rows) dirty minimum x, 1bpp only
+      *page_x2 = NULL;     ///< Per-page (8 rows) dirty maximum x, 1bpp only
+
   int dcPin,  ///< The Arduino pin connected to D/C (for SPI)
       csPin,  ///< The Arduino pin connected to CS (for SPI)
       rstPin; ///< The Arduino pin connected to reset (-1 if unused)
 
   uint8_t _bpp = 1; ///< Bits per pixel color for this display
+
+  GrayOLED_glyph *_glyphs = NULL; ///< Glyph cache slots (hashed by char)
+  uint8_t *_glyph_arena = NULL;   ///< Page-format bitmaps of cached glyphs
+  uint16_t _glyph_arena_size = 0; ///< Size of _glyph_arena in bytes
+  uint16_t _glyph_arena_used = 0; ///< Bytes of _glyph_arena handed out
+  uint8_t _glyph_slots = 0;       ///< Number of entries in _glyphs
 private:
   TwoWire *_theWire = NULL; ///< The underlying hardware I2C
 };
@@ -221,6 +221,6 @@ const GFXglyph FreeMono12pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeMono12pt7b PROGMEM = {(uint8_t *)FreeMono12pt7bBitmaps,
                                         (GFXglyph *)FreeMono12pt7bGlyphs, 0x20,
-                                        0x7E, 24};
+                                        0x7E, 24, 0};
 
 // Approx. 2132 bytes
@@ -736,6 +736,6 @@ const GFXglyph FreeMonoBoldOblique24pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeMonoBoldOblique24pt7b PROGMEM = {
     (uint8_t *)FreeMonoBoldOblique24pt7bBitmaps,
-    (GFXglyph *)FreeMonoBoldOblique24pt7bGlyphs, 0x20, 0x7E, 47};
+    (GFXglyph *)FreeMonoBoldOblique24pt7bGlyphs, 0x20, 0x7E, 47, 0};
 
 // Approx. 8307 bytes
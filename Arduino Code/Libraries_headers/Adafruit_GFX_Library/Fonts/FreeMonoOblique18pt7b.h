@@ -392,6 +392,6 @@ const GFXglyph FreeMonoOblique18pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeMonoOblique18pt7b PROGMEM = {
     (uint8_t *)FreeMonoOblique18pt7bBitmaps,
-    (GFXglyph *)FreeMonoOblique18pt7bGlyphs, 0x20, 0x7E, 35};
+    (GFXglyph *)FreeMonoOblique18pt7bGlyphs, 0x20, 0x7E, 35, 0};
 
 // Approx. 4186 bytes
@@ -181,6 +181,6 @@ const GFXglyph FreeMonoOblique9pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeMonoOblique9pt7b PROGMEM = {
     (uint8_t *)FreeMonoOblique9pt7bBitmaps,
-    (GFXglyph *)FreeMonoOblique9pt7bGlyphs, 0x20, 0x7E, 18};
+    (GFXglyph *)FreeMonoOblique9pt7bGlyphs, 0x20, 0x7E, 18, 0};
 
 // Approx. 1654 bytes
@@ -887,6 +887,6 @@ const GFXglyph FreeSansBoldOblique24pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeSansBoldOblique24pt7b PROGMEM = {
     (uint8_t *)FreeSansBoldOblique24pt7bBitmaps,
-    (GFXglyph *)FreeSansBoldOblique24pt7bGlyphs, 0x20, 0x7E, 56};
+    (GFXglyph *)FreeSansBoldOblique24pt7bGlyphs, 0x20, 0x7E, 56, 0};
 
 // Approx. 10119 bytes
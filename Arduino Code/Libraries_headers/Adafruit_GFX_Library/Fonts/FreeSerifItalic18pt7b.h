@@ -444,6 +444,6 @@ const GFXglyph FreeSerifItalic18pt7bGlyphs[] PROGMEM = {
 
 const GFXfont FreeSerifItalic18pt7b PROGMEM = {
     (uint8_t *)FreeSerifItalic18pt7bBitmaps,
-    (GFXglyph *)FreeSerifItalic18pt7bGlyphs, 0x20, 0x7E, 42};
+    (GFXglyph *)FreeSerifItalic18pt7bGlyphs, 0x20, 0x7E, 42, 0};
 
 // Approx. 4805 bytes
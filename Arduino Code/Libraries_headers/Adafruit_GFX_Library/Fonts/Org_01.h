@@ -123,6 +123,6 @@ const GFXglyph Org_01Glyphs[] PROGMEM = {{0, 0, 0, 6, 0, 1},     // 0x20 ' '
                                          {269, 5, 3, 6, 0, -3}}; // 0x7E '~'
 
 const GFXfont Org_01 PROGMEM = {(uint8_t *)Org_01Bitmaps,
-                                (GFXglyph *)Org_01Glyphs, 0x20, 0x7E, 7};
+                                (GFXglyph *)Org_01Glyphs, 0x20, 0x7E, 7, 0};
 
 // Approx. 943 bytes
@@ -125,6 +125,6 @@ const GFXglyph Tiny3x3a2pt7bGlyphs[] PROGMEM = {
 
 const GFXfont Tiny3x3a2pt7b PROGMEM = {(uint8_t *)Tiny3x3a2pt7bBitmaps,
                                        (GFXglyph *)Tiny3x3a2pt7bGlyphs, 0x20,
-                                       0x7E, 4};
+                                       0x7E, 4, 0};
 
 // Approx. 814 bytes
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+
+# Run-length compress an Adafruit_GFX font header for smaller firmware.
+#
+# Usage: fontcompress.py <Fonts/SomeFont.h> [out.h]
+#        fontcompress.py --stats Fonts/*.h
+#
+# Reads a font header as written by fontconvert (bitmap array, glyph array
+# and GFXfont struct) and writes the same font with every glyph bitmap
+# run-length encoded. The output declares a font named <name>RLE and can be
+# used with setFont() just like the original; Adafruit_GFX decodes it while
+# drawing. Glyph metrics are unchanged, each glyph's bitmapOffset points at
+# its own (byte aligned) run stream.
+#
+# Encoding: a glyph's w * h pixels, in the usual row-major order, are coded
+# as pairs of runs: n0 clear pixels (b0 bits) followed by n1 set pixels
+# (b1 bits), MSB first. Runs too long for their field are split into
+# several pairs with a zero-length run in between. b0 and b1 (1 to 8) are
+# picked per font to give the smallest output and stored in GFXfont.rle as
+# (b0 << 4) | b1; rle == 0 means a plain bitmap font.
+
+import re
+import sys
+
+
+def parse_font(text):
+    """Return (name, bitmap bytes, glyph tuples, first, last, yAdvance)."""
+    text = re.sub(r"/\*.*?\*/|//[^\n]*", "", text, flags=re.S)
+    bmp = re.search(r"(\w+)Bitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", text, re.S)
+    gly = re.search(r"Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*)\};", text, re.S)
+    fnt = re.search(r"const GFXfont (\w+) PROGMEM\s*=\s*\{(.*?)\};", text, re.S)
+    if not (bmp and gly and fnt):
+        raise ValueError("not an Adafruit_GFX font header")
+    bitmap = [int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", bmp.group(2))]
+    glyphs = [tuple(int(v) for v in g.split(","))
+              for g in re.findall(r"\{\s*(-?\d+\s*(?:,\s*-?\d+\s*){5})\}",
+                                  gly.group(1))]
+    fields = [f.strip() for f in fnt.group(2).split(",")]
+    if len(fields) > 5 and int(fields[5], 0):
+        raise ValueError("already run-length encoded")
+    first, last = int(fields[2], 0), int(fields[3], 0)
+    # Glyphs past 'last' (e.g. optional extended sets) are never drawn
+    return (fnt.group(1), bitmap, glyphs[:last - first + 1], first, last,
+            int(fields[4], 0))
+
+
+def glyph_pixels(bitmap, offset, w, h):
+    return [(bitmap[offset + i // 8] >> (7 - i % 8)) & 1
+            for i in range(w * h)]
+
+
+def runs(pixels):
+    """Split pixels into (clear, set) run pairs."""
+    pairs, i = [], 0
+    while i < len(pixels):
+        n0 = 0
+        while i < len(pixels) and not pixels[i]:
+            n0, i = n0 + 1, i + 1
+        n1 = 0
+        while i < len(pixels) and pixels[i]:
+            n1, i = n1 + 1, i + 1
+        pairs.append((n0, n1))
+    return pairs
+
+
+def encode(pairs, b0, b1):
+    """Bit-pack run pairs, splitting runs that do not fit their field."""
+    m0, m1 = (1 << b0) - 1, (1 << b1) - 1
+    fields = []
+    for n0, n1 in pairs:
+        while n0 > m0:
+            fields += [(m0, b0), (0, b1)]
+            n0 -= m0
+        while n1 > m1:
+            fields += [(n0, b0), (m1, b1)]
+            n0, n1 = 0, n1 - m1
+        fields += [(n0, b0), (n1, b1)]
+    out, acc, nbits = [], 0, 0
+    for value, width in fields:
+        acc, nbits = (acc << width) | value, nbits + width
+        while nbits >= 8:
+            nbits -= 8
+            out.append((acc >> nbits) & 0xFF)
+    if nbits:
+        out.append((acc << (8 - nbits)) & 0xFF)
+    return out
+
+
+def compress(bitmap, glyphs):
+    """Return (b0, b1, stream, glyphs) with the smallest stream."""
+    all_pairs = [runs(glyph_pixels(bitmap, g[0], g[1], g[2])) for g in glyphs]
+    best = None
+    for b0 in range(1, 9):
+        for b1 in range(1, 9):
+            size = sum(len(encode(p, b0, b1)) for p in all_pairs)
+            if best is None or size < best[0]:
+                best = (size, b0, b1)
+    _, b0, b1 = best
+    stream, out_glyphs = [], []
+    for g, p in zip(glyphs, all_pairs):
+        out_glyphs.append((len(stream),) + g[1:])
+        stream += encode(p, b0, b1)
+    return b0, b1, stream, out_glyphs
+
+
+def write_font(out, name, b0, b1, stream, glyphs, first, last, y_advance):
+    rle = name + "RLE"
+    out.write("// %s, run-length encoded by fontcompress.py\n\n" % name)
+    out.write("const uint8_t %sBitmaps[] PROGMEM = {" % rle)
+    for i, v in enumerate(stream):
+        out.write(("\n    " if i % 12 == 0 else " ") + "0x%02X," % v)
+    out.write("};\n\n")
+    out.write("const GFXglyph %sGlyphs[] PROGMEM = {\n" % rle)
+    for i, g in enumerate(glyphs):
+        c = first + i
+        label = chr(c) if 32 <= c < 127 and chr(c) not in "\\" else " "
+        out.write("    {%d, %d, %d, %d, %d, %d}, // 0x%02X '%s'\n" %
+                  (g + (c, label)))
+    out.write("};\n\n")
+    out.write("const GFXfont %s PROGMEM = {(uint8_t *)%sBitmaps,\n" % (rle, rle))
+    out.write("    (GFXglyph *)%sGlyphs, 0x%02X, 0x%02X, %d, 0x%02X};\n\n" %
+              (rle, first, last, y_advance, (b0 << 4) | b1))
+    out.write("// Approx. %d bytes\n" %
+              (len(stream) + len(glyphs) * 7 + 7))
+
+
+def main(args):
+    if args and args[0] == "--stats":
+        total_raw = total_rle = 0
+        for path in args[1:]:
+            name, bitmap, glyphs, first, last, ya = parse_font(open(path).read())
+            b0, b1, stream, _ = compress(bitmap, glyphs)
+            total_raw += len(bitmap)
+            total_rle += len(stream)
+            print("%-24s %6d -> %6d bytes (b0=%d b1=%d)" %
+                  (name, len(bitmap), len(stream), b0, b1))
+        print("%-24s %6d -> %6d bytes" % ("total bitmaps", total_raw,
+                                          total_rle))
+        return
+    if len(args) not in (1, 2):
+        sys.exit(__doc__ or "usage: fontcompress.py <font.h> [out.h]")
+    name, bitmap, glyphs, first, last, ya = parse_font(open(args[0]).read())
+    b0, b1, stream, out_glyphs = compress(bitmap, glyphs)
+    out = open(args[1], "w") if len(args) == 2 else sys.stdout
+    write_font(out, name, b0, b1, stream, out_glyphs, first, last, ya)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+
+# Convert 1-bit images to page-format GrayOLED_icon declarations.
+#
+# Usage: iconconvert.py <image> [image ...] > Icons.h
+#
+# Each image becomes a PROGMEM bitmap plus a GrayOLED_icon named after the
+# file (wifi.pbm -> wifiIcon), ready for Adafruit_GrayOLED::drawIcon().
+# Accepted inputs are PBM (P1 or P4, as saved by the SH110X hostbench),
+# XBM, or plain text where '#' (or 'X', '1') is a set pixel and anything
+# else on the line is clear.
+#
+# Page format is the SH110X/SSD1306 framebuffer layout: (height + 7) / 8
+# rows of width bytes, each byte 8 vertical pixels with the LSB on top, so
+# an unrotated drawIcon() copies bytes straight into the display buffer.
+
+import os
+import re
+import sys
+
+
+def read_pbm(data):
+    """Return rows of 0/1 from a P1 or P4 PBM."""
+    tokens = []
+    pos = 0
+    # header: magic, width, height, separated by whitespace and comments
+    while len(tokens) < 3:
+        m = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        tokens.append(m.group(2))
+        pos = m.end()
+    magic, w, h = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b"P4":
+        pos += 1  # single whitespace before the raster
+        stride = (w + 7) // 8
+        return [[(data[pos + y * stride + x // 8] >> (7 - x % 8)) & 1
+                 for x in range(w)] for y in range(h)]
+    if magic == b"P1":
+        bits = re.findall(rb"[01]", re.sub(rb"#[^\n]*", b"", data[pos:]))
+        return [[int(bits[y * w + x]) for x in range(w)] for y in range(h)]
+    raise ValueError("not a P1/P4 PBM")
+
+
+def read_xbm(text):
+    """Return rows of 0/1 from an XBM (LSB-first rows)."""
+    w = int(re.search(r"_width\s+(\d+)", text).group(1))
+    h = int(re.search(r"_height\s+(\d+)", text).group(1))
+    body = text[text.index("{") + 1:text.rindex("}")]
+    data = [int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", body)]
+    stride = (w + 7) // 8
+    return [[(data[y * stride + x // 8] >> (x % 8)) & 1 for x in range(w)]
+            for y in range(h)]
+
+
+def read_text(text):
+    """Return rows of 0/1 from '#'/'.' art, padded to the widest line."""
+    lines = [l.rstrip() for l in text.splitlines()]
+    while lines and not lines[-1]:
+        lines.pop()
+    w = max(len(l) for l in lines)
+    return [[1 if c in "#X1" else 0 for c in l.ljust(w)] for l in lines]
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:2] in (b"P1", b"P4"):
+        return read_pbm(data)
+    text = data.decode("ascii")
+    if "_width" in text:
+        return read_xbm(text)
+    return read_text(text)
+
+
+def to_pages(rows):
+    """Return page-format bytes of a 0/1 image."""
+    h, w = len(rows), len(rows[0])
+    out = []
+    for page in range((h + 7) // 8):
+        for x in range(w):
+            b = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < h and rows[y][x]:
+                    b |= 1 << bit
+            out.append(b)
+    return out
+
+
+def emit(name, rows):
+    h, w = len(rows), len(rows[0])
+    if w > 255 or h > 255:
+        raise ValueError(name + ": icons are limited to 255x255")
+    data = to_pages(rows)
+    out = ["// %s: %dx%d" % (name, w, h)]
+    out += ["//   " + "".join("#" if p else "." for p in r) for r in rows]
+    out.append("const uint8_t %sBitmap[] PROGMEM = {" % name)
+    for i in range(0, len(data), 12):
+        out.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 12])
+                   + ",")
+    out.append("};")
+    out.append("const GrayOLED_icon %sIcon = {%sBitmap, %d, %d};" %
+               (name, name, w, h))
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write("usage: iconconvert.py <image> [image ...]\n")
+        return 1
+    for path in argv[1:]:
+        name = re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0])
+        sys.stdout.write(emit(name, read_image(path)) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -24,6 +24,7 @@ typedef struct {
   uint16_t first;   ///< ASCII extents (first char)
   uint16_t last;    ///< ASCII extents (last char)
   uint8_t yAdvance; ///< Newline distance (y axis)
+  uint8_t rle;      ///< Run-length bit widths, (b0 << 4) | b1, 0 = plain
 } GFXfont;
 
 #endif // _GFXFONT_H_
@@ -37,8 +37,16 @@
  */
 
 #include "Adafruit_SH110X.h"
+#include <Adafruit_I2CBus.h>
 #include "splash.h"
 
+// display() shows up as the "oled" phase when built with LOOP_PROFILE
+#ifdef LOOP_PROFILE
+#include <LoopProfiler.h>
+#else
+#define LOOP_PROFILE_SCOPE(name)
+#endif
+
 // CONSTRUCTORS, DESTRUCTOR ------------------------------------------------
 
 /*!
@@ -142,7 +150,7 @@ Adafruit_SH110X::Adafruit_SH110X(uint16_t w, uint16_t h, SPIClass *spi,
 /*!
     @brief  Destructor for Adafruit_SH110X object.
 */
-Adafruit_SH110X::~Adafruit_SH110X(void) {}
+Adafruit_SH110X::~Adafruit_SH110X(void) { enableAsyncDisplay(false); }
 
 // REFRESH DISPLAY ---------------------------------------------------------
 
@@ -151,8 +159,12 @@ Adafruit_SH110X::~Adafruit_SH110X(void) {}
     @note   Drawing operations are not visible until this function is
             called. Call after each graphics command, or after a whole set
             of graphics commands, as best needed by one's own application.
+            With enableAsyncDisplay() active this only snapshots the
+            changed areas and returns; the transfer finishes in the
+            background while drawing carries on.
 */
 void Adafruit_SH110X::display(void) {
+  LOOP_PROFILE_SCOPE("oled");
   // ESP8266 needs a periodic yield() call to avoid watchdog reset.
   // With the limited size of SH110X displays, and the fast bitrate
   // being used (1 MHz or more), I think one yield() immediately before
@@ -161,90 +173,309 @@ void Adafruit_SH110X::display(void) {
   // 32-byte transfer condition below.
   yield();
 
-  // uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
-  uint8_t *ptr = buffer;
-  uint8_t dc_byte = 0x40;
+#if defined(SH110X_ASYNC_THREAD)
+  if (_async_thread.joinable()) {
+    // span list and snapshot are reused, so let the last flush finish
+    waitForDisplay();
+  }
+#elif defined(SH110X_HAS_ASYNC)
+  if (_async_task) {
+    // span list and snapshot are reused, so let the last flush finish
+    xSemaphoreTake(_async_idle, portMAX_DELAY);
+  }
+#endif
+
   uint8_t pages = ((HEIGHT + 7) / 8);
 
-  uint8_t bytes_per_page = WIDTH;
-
-  /*
-  Serial.print("Window: (");
-  Serial.print(window_x1);
-  Serial.print(", ");
-  Serial.print(window_y1);
-  Serial.print(" -> (");
-  Serial.print(window_x2);
-  Serial.print(", ");
-  Serial.print(window_y2);
-  Serial.println(")");
-  */
-
-  uint8_t first_page = window_y1 / 8;
-  //  uint8_t last_page = (window_y2 + 7) / 8;
-  uint8_t page_start = min(bytes_per_page, (uint8_t)window_x1);
-  uint8_t page_end = (uint8_t)max((int)0, (int)window_x2);
-  /*
-  Serial.print("Pages: ");
-  Serial.print(first_page);
-  Serial.print(" -> ");
-  Serial.println(last_page);
-  pages = min(pages, last_page);
-
-  Serial.print("Page addr: ");
-  Serial.print(page_start);
-  Serial.print(" -> ");
-  Serial.println(page_end);
-  */
-
-  for (uint8_t p = first_page; p < pages; p++) {
-    uint8_t bytes_remaining = bytes_per_page;
-    ptr = buffer + (uint16_t)p * (uint16_t)bytes_per_page;
-    // fast forward to dirty rectangle beginning
-    ptr += page_start;
-    bytes_remaining -= page_start;
-    // cut off end of dirty rectangle
-    bytes_remaining -= (WIDTH - 1) - page_end;
-
-    if (i2c_dev) { // I2C
-      uint16_t maxbuff = i2c_dev->maxBufferSize() - 1;
-
-      uint8_t cmd[] = {
-          0x00, (uint8_t)(SH110X_SETPAGEADDR + p),
-          (uint8_t)(0x10 + ((page_start + _page_start_offset) >> 4)),
-          (uint8_t)((page_start + _page_start_offset) & 0xF)};
-
-      // Set high speed clk
-      i2c_dev->setSpeed(i2c_preclk);
-
-      i2c_dev->write(cmd, 4);
-
-      while (bytes_remaining) {
-        uint8_t to_write = min(bytes_remaining, (uint8_t)maxbuff);
-        i2c_dev->write(ptr, to_write, true, &dc_byte, 1);
-        ptr += to_write;
-        bytes_remaining -= to_write;
-        yield();
+  // Only pages touched since the last refresh are sent, and of those only
+  // the dirty column span -- so a changed digit costs a few bytes, not a
+  // whole screen. With a shadow buffer enabled, the span is further cut
+  // down to the byte runs that really differ from what the panel shows.
+  _span_count = 0;
+  for (uint8_t p = 0; p < pages; p++) {
+    if (page_x2[p] < page_x1[p]) {
+      continue; // nothing drawn on this page
+    }
+    int16_t from = max((int16_t)0, page_x1[p]);
+    int16_t to = min((int16_t)(WIDTH - 1), page_x2[p]);
+    int16_t run_x1, run_x2;
+
+    while (_nextChangedRun(p, from, to, &run_x1, &run_x2)) {
+      // keep a free slot for each page still to come; past that, runs
+      // are merged into this page's last span
+      if (_span_count < SH110X_MAX_SPANS - (pages - 1 - p)) {
+        _spans[_span_count].page = p;
+        _spans[_span_count].x1 = run_x1;
+        _span_count++;
       }
+      _spans[_span_count - 1].x2 = run_x2;
+      from = run_x2 + 1;
+    }
+  }
+  // reset dirty window
+  _clearDirty();
 
-      // Set low speed clk
-      i2c_dev->setSpeed(i2c_postclk);
+#if defined(SH110X_ASYNC_THREAD)
+  if (_async_thread.joinable()) {
+    if (!_span_count) {
+      return;
+    }
+    for (uint8_t i = 0; i < _span_count; i++) {
+      uint16_t offset = (uint16_t)_spans[i].page * WIDTH + _spans[i].x1;
+      memcpy(_async_buffer + offset, buffer + offset,
+             _spans[i].x2 - _spans[i].x1 + 1);
+    }
+    std::lock_guard<std::mutex> lock(_async_lock);
+    _async_busy = true; // thread clears it when done
+    _async_wake.notify_all();
+    return;
+  }
+#elif defined(SH110X_HAS_ASYNC)
+  if (_async_task) {
+    if (!_span_count) {
+      xSemaphoreGive(_async_idle);
+      return;
+    }
+    for (uint8_t i = 0; i < _span_count; i++) {
+      uint16_t offset = (uint16_t)_spans[i].page * WIDTH + _spans[i].x1;
+      memcpy(_async_buffer + offset, buffer + offset,
+             _spans[i].x2 - _spans[i].x1 + 1);
+    }
+    xTaskNotifyGive(_async_task); // task gives _async_idle back when done
+    return;
+  }
+#endif
 
-    } else { // SPI
-      uint8_t cmd[] = {
-          (uint8_t)(SH110X_SETPAGEADDR + p),
-          (uint8_t)(0x10 + ((page_start + _page_start_offset) >> 4)),
-          (uint8_t)((page_start + _page_start_offset) & 0xF)};
+  writeSpans(buffer);
+}
 
-      digitalWrite(dcPin, LOW);
-      spi_dev->write(cmd, 3);
-      digitalWrite(dcPin, HIGH);
-      spi_dev->write(ptr, bytes_remaining);
+/*!
+    @brief  Make display() hand its transfers to a background task, so the
+            main loop is not blocked while the panel is written.
+    @param  enable
+            true to start the transfer task, false to stop it (after any
+            flush in progress completes) and go back to blocking updates.
+    @return true on success, false if this platform has no background
+            transfer support or memory could not be allocated.
+    @note   Costs a second framebuffer, which the task sends from while
+            the main buffer is redrawn. Calling display() again while a
+            flush is still running waits for it to finish first. Only
+            available on ESP32, whose Wire driver serializes access from
+            several tasks, and in host builds, where the task is a
+            std::thread; on other platforms display() stays blocking.
+*/
+bool Adafruit_SH110X::enableAsyncDisplay(bool enable) {
+#if defined(SH110X_ASYNC_THREAD)
+  if (!enable) {
+    if (_async_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(_async_lock);
+        _async_stop = true; // after any flush in progress
+        _async_wake.notify_all();
+      }
+      _async_thread.join();
+      _async_stop = false;
     }
+    if (_async_buffer) {
+      free(_async_buffer);
+      _async_buffer = NULL;
+    }
+    return true;
+  }
+
+  if (_async_thread.joinable()) {
+    return true;
+  }
+  if ((!_async_buffer) &&
+      !(_async_buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8)))) {
+    return false;
+  }
+  _async_thread = std::thread(&Adafruit_SH110X::asyncThread, this);
+  return true;
+#elif defined(SH110X_HAS_ASYNC)
+  if (!enable) {
+    if (_async_task) {
+      xSemaphoreTake(_async_idle, portMAX_DELAY);
+      vTaskDelete(_async_task);
+      _async_task = NULL;
+      vSemaphoreDelete(_async_idle);
+      _async_idle = NULL;
+    }
+    if (_async_buffer) {
+      free(_async_buffer);
+      _async_buffer = NULL;
+    }
+    return true;
+  }
+
+  if (_async_task) {
+    return true;
+  }
+  if ((!_async_buffer) &&
+      !(_async_buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8)))) {
+    return false;
+  }
+  if (!(_async_idle = xSemaphoreCreateBinary())) {
+    return false;
+  }
+  xSemaphoreGive(_async_idle);
+  if (xTaskCreate(asyncTask, "SH110X", 2048, this, tskIDLE_PRIORITY + 1,
+                  &_async_task) != pdPASS) {
+    _async_task = NULL;
+    vSemaphoreDelete(_async_idle);
+    _async_idle = NULL;
+    return false;
+  }
+  return true;
+#else
+  return !enable;
+#endif
+}
+
+/*!
+    @brief  Check whether a background display() transfer is still running.
+    @return true while a flush started by display() is in flight.
+*/
+bool Adafruit_SH110X::displayBusy(void) {
+#if defined(SH110X_ASYNC_THREAD)
+  std::lock_guard<std::mutex> lock(_async_lock);
+  return _async_busy;
+#elif defined(SH110X_HAS_ASYNC)
+  if (_async_task) {
+    return uxSemaphoreGetCount(_async_idle) == 0;
+  }
+#endif
+  return false;
+}
+
+/*!
+    @brief  Block until any background display() transfer has completed.
+*/
+void Adafruit_SH110X::waitForDisplay(void) {
+#if defined(SH110X_ASYNC_THREAD)
+  std::unique_lock<std::mutex> lock(_async_lock);
+  _async_wake.wait(lock, [this] { return !_async_busy; });
+#elif defined(SH110X_HAS_ASYNC)
+  if (_async_task) {
+    xSemaphoreTake(_async_idle, portMAX_DELAY);
+    xSemaphoreGive(_async_idle);
+  }
+#endif
+}
+
+#if defined(SH110X_ASYNC_THREAD)
+/*!
+    @brief  Background thread: waits for display() to queue spans, writes
+            them from the snapshot buffer, then marks the display idle.
+            Exits once enableAsyncDisplay(false) asks it to and it is idle.
+*/
+void Adafruit_SH110X::asyncThread(void) {
+  std::unique_lock<std::mutex> lock(_async_lock);
+  for (;;) {
+    _async_wake.wait(lock, [this] { return _async_busy || _async_stop; });
+    if (!_async_busy) {
+      return;
+    }
+    lock.unlock();
+    writeSpans(_async_buffer);
+    lock.lock();
+    _async_busy = false;
+    _async_wake.notify_all();
+  }
+}
+#elif defined(SH110X_HAS_ASYNC)
+/*!
+    @brief  Background task: waits for display() to queue spans, writes them
+            from the snapshot buffer, then releases the display again.
+    @param  arg  The Adafruit_SH110X instance that owns the task.
+*/
+void Adafruit_SH110X::asyncTask(void *arg) {
+  Adafruit_SH110X *self = (Adafruit_SH110X *)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->writeSpans(self->_async_buffer);
+    xSemaphoreGive(self->_async_idle);
+  }
+}
+#endif
+
+/*!
+    @brief  Write every span queued by display() to the panel.
+    @param  frame  Framebuffer to take the span contents from.
+    @note   The I2C clock is raised once for the whole batch rather than
+            once per page. On an Adafruit_I2CBus the batch holds the bus at
+            bulk priority, other devices get it between chunks, and the
+            clock is left to the bus instead of being dropped afterwards.
+            Over SPI the whole batch is one transaction with CS held low,
+            and D/C only changes between each span's command and data.
+*/
+void Adafruit_SH110X::writeSpans(const uint8_t *frame) {
+  Adafruit_I2CBus *bus = NULL;
+  if (i2c_dev) {
+    // Set high speed clk
+    i2c_dev->setSpeed(i2c_preclk);
+    if ((bus = i2c_dev->bus())) {
+      bus->acquire(i2c_dev, I2CBUS_PRIORITY_BULK);
+    }
+  } else if (_span_count) {
+    spi_dev->beginBatch();
+  }
+
+  for (uint8_t i = 0; i < _span_count; i++) {
+    writePageSpan(frame, _spans[i].page, _spans[i].x1, _spans[i].x2);
+  }
+
+  if (bus) {
+    bus->release();
+  } else if (i2c_dev) {
+    // Set low speed clk
+    i2c_dev->setSpeed(i2c_postclk);
+  } else if (_span_count) {
+    spi_dev->endBatch();
+  }
+}
+
+/*!
+    @brief  Send one column span of one page to the panel.
+    @param  frame  Framebuffer to take the span contents from.
+    @param  page   Page (group of 8 rows) to write.
+    @param  x1     First column of the span.
+    @param  x2     Last column of the span (inclusive).
+*/
+void Adafruit_SH110X::writePageSpan(const uint8_t *frame, uint8_t page,
+                                    uint8_t x1, uint8_t x2) {
+  const uint8_t *ptr = frame + (uint16_t)page * (uint16_t)WIDTH + x1;
+  uint8_t dc_byte = 0x40;
+  uint8_t bytes_remaining = x2 - x1 + 1;
+
+  if (i2c_dev) { // I2C
+    uint16_t maxbuff = i2c_dev->maxBufferSize() - 1;
+
+    uint8_t cmd[] = {0x00, (uint8_t)(SH110X_SETPAGEADDR + page),
+                     (uint8_t)(0x10 + ((x1 + _page_start_offset) >> 4)),
+                     (uint8_t)((x1 + _page_start_offset) & 0xF)};
+
+    i2c_dev->write(cmd, 4);
+
+    while (bytes_remaining) {
+      uint8_t to_write = min(bytes_remaining, (uint8_t)maxbuff);
+      i2c_dev->write(ptr, to_write, true, &dc_byte, 1);
+      ptr += to_write;
+      bytes_remaining -= to_write;
+      yield();
+      if (bytes_remaining && i2c_dev->bus()) {
+        i2c_dev->bus()->preempt(); // let the keypad in between chunks
+      }
+    }
+
+  } else { // SPI
+    uint8_t cmd[] = {(uint8_t)(SH110X_SETPAGEADDR + page),
+                     (uint8_t)(0x10 + ((x1 + _page_start_offset) >> 4)),
+                     (uint8_t)((x1 + _page_start_offset) & 0xF)};
+
+    digitalWrite(dcPin, LOW);
+    spi_dev->write(cmd, 3);
+    digitalWrite(dcPin, HIGH);
+    spi_dev->write(ptr, bytes_remaining);
   }
-  // reset dirty window
-  window_x1 = 1024;
-  window_y1 = 1024;
-  window_x2 = -1;
-  window_y2 = -1;
 }
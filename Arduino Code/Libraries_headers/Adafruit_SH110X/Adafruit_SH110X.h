@@ -26,6 +26,20 @@
 
 #include <Adafruit_GrayOLED.h>
 
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define SH110X_HAS_ASYNC ///< display() can hand transfers to a background task
+#elif !defined(ESP8266) &&                                                     \
+    (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#define SH110X_HAS_ASYNC    ///< display() can hand transfers to a background task
+#define SH110X_ASYNC_THREAD ///< Host build: the transfer task is a std::thread
+#endif
+
 /// fit into the SH110X_ naming scheme
 #define SH110X_BLACK 0   ///< Draw 'off' pixels
 #define SH110X_WHITE 1   ///< Draw 'on' pixels
@@ -66,6 +80,17 @@
 #define SH110X_SETHIGHCOLUMN 0x10 ///< Not currently used
 #define SH110X_SETSTARTLINE 0x40  ///< See datasheet
 
+/// Most page spans queued by one display() call. Further changed runs on
+/// a page are merged into its last span once the list fills up.
+#define SH110X_MAX_SPANS 32
+
+/// One column span of one page, waiting to be written to the panel
+typedef struct {
+  uint8_t page; ///< Page (group of 8 rows)
+  uint8_t x1;   ///< First column
+  uint8_t x2;   ///< Last column (inclusive)
+} SH110X_span;
+
 /*!
     @brief  Class that stores state and functions for interacting with
             SH110X OLED displays. Not instantiatable - use a subclass!
@@ -84,13 +109,38 @@ public:
   virtual ~Adafruit_SH110X(void) = 0;
 
   void display(void);
+  bool enableAsyncDisplay(bool enable = true);
+  bool displayBusy(void);
+  void waitForDisplay(void);
 
 protected:
+  void writeSpans(const uint8_t *frame);
+  void writePageSpan(const uint8_t *frame, uint8_t page, uint8_t x1,
+                     uint8_t x2);
+
+  SH110X_span _spans[SH110X_MAX_SPANS]; ///< Spans queued by display()
+  uint8_t _span_count = 0;              ///< Number of entries in _spans
+
   /*! some displays are 'inset' in memory, so we have to skip some memory to
    * display */
   uint8_t _page_start_offset = 0;
 
 private:
+#ifdef SH110X_HAS_ASYNC
+  uint8_t *_async_buffer = NULL; ///< Snapshot the task sends from
+#endif
+#if defined(SH110X_ASYNC_THREAD)
+  void asyncThread(void);
+  std::thread _async_thread;           ///< Background transfer thread
+  std::mutex _async_lock;              ///< Guards the two flags below
+  std::condition_variable _async_wake; ///< Signalled when a flag changes
+  bool _async_busy = false;            ///< A flush is queued or in flight
+  bool _async_stop = false;            ///< Thread should exit when idle
+#elif defined(SH110X_HAS_ASYNC)
+  static void asyncTask(void *arg);
+  TaskHandle_t _async_task = NULL;      ///< Background transfer task
+  SemaphoreHandle_t _async_idle = NULL; ///< Held while a flush is in flight
+#endif
 };
 
 /*!
@@ -0,0 +1,355 @@
+// FreeSans18pt7b, run-length encoded by fontcompress.py
+
+const uint8_t FreeSans18pt7bRLEBitmaps[] PROGMEM = {
+    0x0E, 0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x82, 0x12, 0x44, 0x8B, 0xF0, 0xA0,
+    0x06, 0x78, 0xF1, 0xE3, 0xC7, 0x8F, 0x1B, 0x12, 0xA4, 0x8A, 0x91, 0x00,
+    0x76, 0x8E, 0x5A, 0x39, 0x4A, 0xE5, 0x2A, 0x96, 0x8E, 0x5A, 0x35, 0xE1,
+    0xC1, 0x97, 0x0E, 0x0C, 0xB8, 0x70, 0x6A, 0xD1, 0xCB, 0x47, 0x2D, 0x1C,
+    0xB4, 0x72, 0x95, 0x2F, 0x0E, 0x10, 0x78, 0x70, 0x83, 0xC3, 0x84, 0x56,
+    0x8E, 0x52, 0xAA, 0x4A, 0xA5, 0xA3, 0x96, 0x8E, 0x5A, 0x39, 0x4A, 0x9C,
+    0x00, 0x65, 0x9A, 0x38, 0x36, 0xE1, 0x12, 0x0A, 0x28, 0x50, 0x91, 0xB2,
+    0x66, 0x91, 0x8B, 0x34, 0x8C, 0x59, 0xA4, 0x62, 0xCD, 0x43, 0x35, 0x10,
+    0x94, 0xC1, 0x53, 0xC0, 0xD7, 0x05, 0x3C, 0x14, 0x21, 0xCE, 0x92, 0x32,
+    0x5C, 0x69, 0x71, 0xA5, 0xC6, 0x97, 0x1A, 0x48, 0x2C, 0x91, 0x52, 0xE1,
+    0x93, 0x84, 0x7F, 0x6B, 0x97, 0x28, 0x00, 0xF0, 0xAA, 0xE5, 0xB9, 0xE0,
+    0x65, 0x4F, 0x06, 0xEE, 0x5A, 0x36, 0x72, 0xD9, 0xAB, 0x95, 0x09, 0x1D,
+    0x28, 0x48, 0xE9, 0xB3, 0x37, 0x8D, 0x21, 0xAD, 0xE0, 0xCD, 0xF7, 0x02,
+    0x8B, 0xC0, 0xE4, 0x7E, 0x2D, 0x34, 0xF0, 0x2D, 0x38, 0x1E, 0x49, 0xC1,
+    0xE3, 0x46, 0x8F, 0x12, 0x36, 0x74, 0xD1, 0x42, 0x96, 0xAA, 0x14, 0xB5,
+    0x6C, 0xE1, 0xBB, 0x47, 0x2D, 0xF8, 0x38, 0x73, 0xC0, 0xCA, 0xC8, 0x80,
+    0x7B, 0xBC, 0x0D, 0xF0, 0x73, 0x12, 0x43, 0x67, 0x0D, 0x9C, 0x36, 0x71,
+    0x12, 0x4B, 0x39, 0x6C, 0x66, 0x7D, 0xBD, 0xEE, 0x14, 0x36, 0x71, 0x21,
+    0x33, 0x6D, 0x05, 0x93, 0x8C, 0x6E, 0x69, 0xB9, 0x88, 0xE9, 0xA4, 0x8A,
+    0x95, 0x38, 0x13, 0xE1, 0x85, 0xA7, 0x06, 0x8D, 0x73, 0x40, 0x0E, 0x1C,
+    0x38, 0x92, 0x22, 0x00, 0x54, 0xC9, 0x53, 0x25, 0x4C, 0x95, 0xAA, 0x56,
+    0xAD, 0x5A, 0xA5, 0x6A, 0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6C, 0x99,
+    0xAB, 0x56, 0xC9, 0x9B, 0x26, 0x4E, 0x99, 0x3A, 0x74, 0x04, 0xE9, 0xD3,
+    0x26, 0x6C, 0x99, 0xB2, 0x66, 0xAD, 0x5B, 0x26, 0x6A, 0xD5, 0xAB, 0x56,
+    0xAD, 0x5A, 0xB5, 0x6A, 0x95, 0xAB, 0x56, 0xA9, 0x5A, 0xA5, 0x6A, 0x99,
+    0x2A, 0x54, 0xC0, 0x45, 0x0A, 0x12, 0x31, 0x43, 0xC3, 0x1C, 0x68, 0xAC,
+    0x51, 0xB2, 0x66, 0x50, 0x90, 0x75, 0xCB, 0x97, 0x2E, 0x5C, 0x9F, 0x87,
+    0x0E, 0x1C, 0x38, 0x70, 0xCE, 0xB9, 0x72, 0xE5, 0xCB, 0x97, 0x27, 0x00,
+    0x0E, 0x14, 0x50, 0xA1, 0x42, 0x45, 0x08, 0x0E, 0x1C, 0x38, 0x30, 0x0E,
+    0x14, 0x85, 0x09, 0xD4, 0x28, 0x4E, 0xA1, 0x42, 0x75, 0x0A, 0x13, 0xA8,
+    0x50, 0xA1, 0x3A, 0x85, 0x09, 0xD4, 0x28, 0x4E, 0xA1, 0x42, 0x75, 0x0A,
+    0x00, 0x5D, 0x3C, 0x13, 0x70, 0x89, 0x12, 0x1C, 0x68, 0x4E, 0x19, 0x38,
+    0x62, 0xEB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xD5, 0xAB, 0x56, 0x98, 0x2E,
+    0x19, 0x38, 0x65, 0x1A, 0x1C, 0x48, 0xBC, 0x1B, 0x70, 0x53, 0x94, 0x00,
+    0x64, 0xC9, 0x5A, 0x42, 0xE1, 0xC3, 0x81, 0x56, 0xAD, 0x5A, 0xB5, 0x6A,
+    0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xD5, 0xAB, 0x56, 0xAC, 0x5D,
+    0x1C, 0x1A, 0xF0, 0xA7, 0x52, 0x93, 0x8E, 0x06, 0x3D, 0x6A, 0x7A, 0xF5,
+    0xE4, 0xB9, 0x72, 0xAC, 0xE9, 0xB3, 0x6A, 0x63, 0xC7, 0xAB, 0x5E, 0xF0,
+    0xE1, 0xC3, 0x87, 0x0E, 0x18, 0x5F, 0x3C, 0x1B, 0x70, 0xA9, 0x16, 0x23,
+    0x78, 0x4E, 0x59, 0x39, 0x64, 0xE5, 0xF3, 0xC9, 0x3E, 0xB5, 0xF0, 0x3D,
+    0x3A, 0x73, 0xED, 0x7A, 0xFD, 0x31, 0x72, 0xCA, 0xAD, 0x3E, 0x19, 0x78,
+    0x48, 0xEA, 0x00, 0xA7, 0xAF, 0x25, 0xDB, 0xB5, 0xA5, 0x8B, 0x94, 0x4E,
+    0x19, 0x37, 0x66, 0xD9, 0xA3, 0x64, 0xAD, 0x5A, 0xB4, 0x6C, 0xD1, 0x3B,
+    0x36, 0xEC, 0xF8, 0x70, 0xE1, 0xC3, 0x87, 0x0D, 0x4F, 0x5E, 0xBD, 0x7A,
+    0xF5, 0x98, 0x3E, 0x19, 0x38, 0x63, 0xE1, 0xCD, 0xF3, 0xE7, 0xCF, 0x9F,
+    0x32, 0xAD, 0xC3, 0x27, 0x0E, 0x75, 0x69, 0x38, 0x9D, 0x39, 0xF3, 0xE7,
+    0xCF, 0xB5, 0x31, 0x92, 0xCA, 0x34, 0x4E, 0x19, 0x78, 0x48, 0xCC, 0x00,
+    0x6B, 0x3C, 0x13, 0x70, 0x89, 0x16, 0x1B, 0x76, 0x4E, 0x19, 0x3D, 0x5A,
+    0xF5, 0x9D, 0x56, 0x3C, 0x11, 0xF0, 0xE5, 0x92, 0x8C, 0x86, 0x32, 0x3D,
+    0x6A, 0xD4, 0xC5, 0x53, 0x17, 0x10, 0x5C, 0x33, 0x89, 0x4F, 0x85, 0x5E,
+    0x0E, 0x32, 0x80, 0x0E, 0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x6A, 0xD7, 0x8F,
+    0x56, 0xBC, 0x7A, 0xB5, 0xEA, 0xD7, 0xAB, 0x5E, 0xBC, 0x7A, 0xF5, 0xE3,
+    0xD7, 0xAF, 0x56, 0xBD, 0x74, 0x00, 0x5F, 0x1C, 0x22, 0xF0, 0xC9, 0x16,
+    0x1C, 0x78, 0x4E, 0x59, 0x39, 0x64, 0xE5, 0x94, 0x78, 0x71, 0x62, 0xF0,
+    0x8F, 0xC1, 0x37, 0x0C, 0x75, 0x69, 0x39, 0x62, 0xEB, 0xDE, 0xBD, 0x7A,
+    0xA0, 0xB9, 0x65, 0x56, 0x9F, 0x0C, 0xBC, 0x24, 0x75, 0x00, 0x5D, 0x1C,
+    0x1A, 0xF0, 0xA7, 0x52, 0x1B, 0x86, 0x32, 0x18, 0xBA, 0x42, 0xEB, 0x56,
+    0xAD, 0x30, 0x5C, 0x41, 0x8B, 0x8B, 0x87, 0x3E, 0x08, 0x5A, 0xD3, 0x7A,
+    0xF5, 0x6B, 0x27, 0x0C, 0x9B, 0xB3, 0x8B, 0x13, 0x84, 0x6E, 0x0A, 0x6B,
+    0x00, 0x0E, 0x17, 0xC7, 0x83, 0xE1, 0x40, 0x0E, 0x17, 0xC7, 0x83, 0xE1,
+    0x45, 0x0A, 0x14, 0x24, 0x50, 0x80, 0xF0, 0x27, 0x65, 0xE9, 0xD1, 0xE3,
+    0x4E, 0x9B, 0x8F, 0xAE, 0xFD, 0xDB, 0xF3, 0xEE, 0xD9, 0xE8, 0x0E, 0x1C,
+    0x38, 0x70, 0xE1, 0xC3, 0x82, 0xF1, 0xE3, 0xC3, 0x70, 0xE1, 0xC3, 0x87,
+    0x0E, 0x1C, 0x10, 0x03, 0xE0, 0x5F, 0x5D, 0xFB, 0xB7, 0xE7, 0xDD, 0xB2,
+    0xF4, 0xE8, 0xF1, 0xA7, 0x4E, 0xB7, 0xC7, 0xC0, 0x80, 0x4C, 0xFC, 0x1A,
+    0x70, 0xA7, 0x12, 0x8C, 0x7F, 0x3A, 0x74, 0xBC, 0x76, 0xEE, 0x4D, 0x9B,
+    0x36, 0x9D, 0xCB, 0x78, 0xF1, 0xF8, 0xF1, 0xE3, 0x1E, 0x3C, 0x78, 0xDC,
+    0x00, 0xDE, 0x07, 0xC3, 0x70, 0xFE, 0x07, 0x87, 0x09, 0xB9, 0xFD, 0xDC,
+    0xB3, 0x3E, 0xBC, 0xF0, 0x71, 0x67, 0x85, 0x87, 0x22, 0xC4, 0x36, 0xFC,
+    0x09, 0x33, 0x65, 0x1A, 0x1E, 0x48, 0x2D, 0x9B, 0x55, 0x62, 0xD6, 0x3C,
+    0x5C, 0xCE, 0x1B, 0x66, 0x70, 0xDB, 0x2B, 0x96, 0xD9, 0x5C, 0x37, 0xCA,
+    0xE1, 0xB3, 0x16, 0xAE, 0x1B, 0x31, 0x6A, 0xDD, 0xB3, 0x28, 0xAD, 0x62,
+    0xC3, 0x6B, 0x0F, 0x1C, 0x48, 0xBC, 0x08, 0xF0, 0x4C, 0xDA, 0xA6, 0x89,
+    0xE3, 0xAF, 0x8D, 0xBE, 0x37, 0xC3, 0xF0, 0x3C, 0x38, 0x2F, 0x07, 0xC3,
+    0xF8, 0x5E, 0x0B, 0x00, 0x8B, 0xE0, 0xAF, 0x82, 0xDF, 0xFD, 0x8B, 0xF6,
+    0x33, 0x61, 0x3D, 0x66, 0xF5, 0x9C, 0xB8, 0x8E, 0xDA, 0xBB, 0x6B, 0x25,
+    0xBB, 0x96, 0xEE, 0x5B, 0xC7, 0xE1, 0xC0, 0xBF, 0x0E, 0x09, 0x78, 0x70,
+    0x6B, 0x29, 0xAB, 0xB8, 0x72, 0xE1, 0xCC, 0x66, 0xF6, 0x0C, 0xD8, 0x33,
+    0x98, 0xBF, 0x80, 0x0E, 0x1D, 0x78, 0x70, 0x47, 0xC3, 0x83, 0x27, 0x50,
+    0x9D, 0xC1, 0x78, 0xC5, 0xE3, 0x17, 0x8C, 0x5E, 0x31, 0x76, 0xC9, 0xD4,
+    0x2E, 0x1C, 0x11, 0xF0, 0xE0, 0x8F, 0x87, 0x06, 0x4E, 0xE0, 0xBC, 0x62,
+    0xF7, 0x6E, 0xDD, 0xBB, 0x76, 0x7B, 0x83, 0xC3, 0x83, 0x2E, 0x1C, 0x11,
+    0xF0, 0xEA, 0x00, 0x8E, 0x07, 0x38, 0x58, 0xE1, 0xC0, 0xB6, 0x6A, 0x96,
+    0xA1, 0xCC, 0x65, 0x36, 0x0B, 0xF6, 0x2F, 0xC1, 0xBF, 0x08, 0xFC, 0x23,
+    0xF0, 0x8F, 0xC2, 0x3F, 0x08, 0xFC, 0x23, 0xF0, 0x8F, 0xC0, 0xB1, 0x7E,
+    0xC5, 0xF4, 0x19, 0xAC, 0xE5, 0xC3, 0xB3, 0x17, 0x35, 0x6E, 0x1C, 0x0C,
+    0xF0, 0xB9, 0xDC, 0x00, 0x0E, 0x19, 0xF8, 0x70, 0x2B, 0xC3, 0x82, 0x47,
+    0x34, 0xDD, 0xC2, 0x78, 0xC9, 0xEB, 0x17, 0xAC, 0x5E, 0xFE, 0xDD, 0xBB,
+    0x76, 0xED, 0xDB, 0xB7, 0x6D, 0xFA, 0xC5, 0xEB, 0x17, 0x90, 0x5D, 0xC2,
+    0x73, 0x4F, 0x87, 0x04, 0x9C, 0x38, 0x15, 0xE1, 0x9C, 0x00, 0x0E, 0x1C,
+    0x18, 0xF0, 0xE0, 0xC7, 0x87, 0x06, 0x2F, 0xDF, 0xBF, 0x7E, 0xFD, 0xFB,
+    0xF7, 0xFC, 0x38, 0x31, 0xE1, 0xC1, 0x8F, 0x0E, 0x0C, 0x5F, 0xBF, 0x7E,
+    0xFD, 0xFB, 0xF7, 0xEF, 0xDF, 0xF0, 0xE1, 0xC3, 0x87, 0x0E, 0x1C, 0x28,
+    0x0E, 0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x85, 0xE7, 0xCF, 0x9F, 0x3E, 0x7C,
+    0xF9, 0xF7, 0x0E, 0x04, 0xB8, 0x70, 0x25, 0xC3, 0x81, 0x27, 0xCF, 0x9F,
+    0x3E, 0x7C, 0xF9, 0xF3, 0xE7, 0xCF, 0x9F, 0x3E, 0x00, 0x9E, 0x07, 0x78,
+    0x6A, 0xE1, 0xC1, 0x3D, 0x7C, 0xB2, 0xE9, 0xCE, 0x65, 0x3E, 0x0B, 0xF0,
+    0x4C, 0x5F, 0x85, 0x7E, 0x19, 0xF8, 0x67, 0xE1, 0x9D, 0xF0, 0xD7, 0xC3,
+    0x5F, 0x0D, 0xE0, 0xFF, 0x82, 0x62, 0xFC, 0x13, 0x17, 0xE0, 0x60, 0xCF,
+    0x85, 0x36, 0x9C, 0xBC, 0x99, 0xA0, 0xB5, 0xE1, 0xC9, 0xB7, 0x0A, 0x8A,
+    0x38, 0x16, 0x40, 0x07, 0xBB, 0x76, 0xED, 0xDB, 0xB7, 0x6E, 0xDD, 0xBB,
+    0x76, 0xF0, 0xE1, 0xC3, 0x87, 0x0E, 0x1C, 0x38, 0x7D, 0xDB, 0xB7, 0x6E,
+    0xDD, 0xBB, 0x76, 0xED, 0xDB, 0xB7, 0x6B, 0x0E, 0x1C, 0x38, 0x70, 0xE1,
+    0xC3, 0x87, 0x0E, 0x1C, 0x38, 0x10, 0xB7, 0x6E, 0xDD, 0xBB, 0x76, 0xED,
+    0xDB, 0xB7, 0x6E, 0xDD, 0xBB, 0x76, 0xED, 0xDB, 0xBD, 0x1A, 0x34, 0x68,
+    0xED, 0x06, 0x24, 0x2E, 0x14, 0xF8, 0x36, 0xC8, 0x00, 0x07, 0x90, 0x5D,
+    0xC2, 0x75, 0x0D, 0xCC, 0x47, 0x11, 0x5B, 0xD5, 0x6D, 0x59, 0xAD, 0x76,
+    0x96, 0x1A, 0x49, 0x67, 0x29, 0x95, 0xA6, 0x3E, 0x71, 0x39, 0xA7, 0x22,
+    0x2C, 0x76, 0xF1, 0x9B, 0xC6, 0x71, 0x15, 0xCC, 0x47, 0x31, 0x1D, 0x43,
+    0x77, 0x09, 0xDC, 0x27, 0x90, 0x5E, 0xC0, 0x07, 0x8F, 0x1E, 0x3C, 0x78,
+    0xF1, 0xE3, 0xC7, 0x8F, 0x1E, 0x3C, 0x78, 0xF1, 0xE3, 0xC7, 0x8F, 0x1E,
+    0x3C, 0x78, 0xF1, 0xE7, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0xC0, 0x0B, 0xDC,
+    0x1F, 0x70, 0x7D, 0xC2, 0x67, 0x0B, 0x9C, 0x2E, 0x70, 0x42, 0xE9, 0x8E,
+    0x17, 0x4C, 0x70, 0xBA, 0x63, 0x89, 0xC3, 0x2C, 0x4E, 0x19, 0x62, 0x70,
+    0xCB, 0x1B, 0x66, 0x78, 0xDB, 0x33, 0xC6, 0xD9, 0x9E, 0x46, 0x8D, 0x32,
+    0x34, 0x69, 0x91, 0xA3, 0x4C, 0xAC, 0x9A, 0xE5, 0x64, 0xD7, 0x2B, 0x26,
+    0xB9, 0xB3, 0x66, 0xCD, 0x9B, 0x36, 0x78, 0xF9, 0xE3, 0xB0, 0x09, 0xBF,
+    0x78, 0x1C, 0xE0, 0xAF, 0x82, 0xBE, 0x0E, 0xB0, 0xC9, 0xC4, 0xE7, 0x14,
+    0x8C, 0x71, 0xF2, 0x37, 0xC9, 0x1B, 0x2B, 0x6C, 0xB1, 0x73, 0x44, 0xCE,
+    0xD3, 0x3C, 0x3D, 0x10, 0xB4, 0xB2, 0xD3, 0x07, 0x57, 0x07, 0x7C, 0x15,
+    0xF0, 0x59, 0xC0, 0xE7, 0x03, 0xB0, 0x9F, 0xFC, 0x35, 0xF0, 0xE0, 0x66,
+    0xBD, 0x79, 0x71, 0x66, 0xC3, 0x9F, 0x09, 0xF8, 0x26, 0x4F, 0xC1, 0x31,
+    0x7E, 0x0F, 0xF8, 0x4D, 0xE1, 0x37, 0x84, 0xDE, 0x13, 0x78, 0x4D, 0xE1,
+    0x37, 0x84, 0x62, 0xFC, 0x13, 0x27, 0xE0, 0x99, 0x4F, 0x87, 0x36, 0x2C,
+    0xB8, 0xF5, 0xEC, 0xF0, 0xE0, 0x6F, 0x86, 0xFF, 0x20, 0x0E, 0x1D, 0x38,
+    0x70, 0x27, 0xC3, 0x82, 0x27, 0x34, 0x5D, 0xFC, 0xD9, 0xB3, 0x66, 0xCD,
+    0x7E, 0xA0, 0xF0, 0xE0, 0x8B, 0x87, 0x02, 0x7C, 0x3A, 0x3F, 0x7E, 0xFD,
+    0xFB, 0xF7, 0xEF, 0xDF, 0xBF, 0x7E, 0xFC, 0x00, 0x9F, 0xFC, 0x35, 0xF0,
+    0xE0, 0x66, 0xBD, 0x79, 0x71, 0x66, 0xC3, 0x9F, 0x09, 0xF8, 0x26, 0x4F,
+    0xC1, 0x31, 0x7E, 0x13, 0x78, 0x4D, 0xE1, 0x37, 0x84, 0xDE, 0x13, 0x78,
+    0x4D, 0xE1, 0x37, 0x83, 0x82, 0xFC, 0x13, 0x27, 0xE0, 0x99, 0x4A, 0x65,
+    0x0E, 0x4F, 0x02, 0xB2, 0x73, 0xD7, 0xD1, 0xC3, 0x84, 0x8E, 0x18, 0x5D,
+    0xF5, 0x7E, 0x21, 0x78, 0x92, 0x20, 0x0E, 0x1C, 0x0A, 0xF0, 0xE0, 0xCF,
+    0x87, 0x08, 0x4E, 0xE1, 0x3C, 0x82, 0xF5, 0x8B, 0xD6, 0x2F, 0x58, 0xBD,
+    0x62, 0xF5, 0x8B, 0xC6, 0x4E, 0xE1, 0x70, 0xE0, 0xCF, 0x87, 0x04, 0x9C,
+    0x38, 0x33, 0x77, 0x09, 0xE4, 0x17, 0xAC, 0x5E, 0xB1, 0x7A, 0xC5, 0xEB,
+    0x17, 0xAC, 0x5E, 0xB1, 0x7A, 0xC5, 0xEF, 0xD8, 0x6E, 0x06, 0xB8, 0x57,
+    0xE1, 0xD6, 0xB5, 0x47, 0x50, 0x9E, 0x32, 0x78, 0xC9, 0xF8, 0x27, 0xE0,
+    0xA7, 0x82, 0xBE, 0x07, 0x81, 0xDE, 0x12, 0xF8, 0x4D, 0xE0, 0xBE, 0xF8,
+    0x29, 0xE0, 0xB7, 0x6E, 0xFA, 0xC6, 0x5B, 0x2B, 0x14, 0xF8, 0x70, 0x4B,
+    0xC3, 0xCF, 0x02, 0xC0, 0x0E, 0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x87, 0x03,
+    0x0F, 0xC0, 0xBF, 0x02, 0xFC, 0x0B, 0xF0, 0x2F, 0xC0, 0xBF, 0x02, 0xFC,
+    0x0B, 0xF0, 0x2F, 0xC0, 0xBF, 0x02, 0xFC, 0x0B, 0xF0, 0x2F, 0xC0, 0xBF,
+    0x02, 0xFC, 0x0B, 0xF0, 0x2F, 0xC0, 0xBF, 0x02, 0xFC, 0x0B, 0xF0, 0x2F,
+    0xC0, 0xBF, 0x02, 0xE0, 0x00, 0x07, 0xBB, 0x76, 0xED, 0xDB, 0xB7, 0x6E,
+    0xDD, 0xBB, 0x76, 0xED, 0xDB, 0xB7, 0x6E, 0xDD, 0xBB, 0x76, 0xED, 0xF7,
+    0x06, 0x4C, 0x2A, 0xF4, 0xF8, 0x70, 0x2B, 0xC2, 0xD7, 0x60, 0x07, 0xDC,
+    0x0E, 0xF0, 0x3A, 0xC9, 0xE4, 0x29, 0x70, 0xA5, 0xB4, 0x75, 0x12, 0x4C,
+    0x57, 0x2D, 0x9C, 0xB6, 0x8E, 0xE1, 0xBB, 0x86, 0xEE, 0x22, 0xBA, 0x6A,
+    0xE9, 0xAB, 0xA8, 0x6F, 0x19, 0xBC, 0x66, 0xF2, 0x0B, 0xE6, 0x2F, 0x98,
+    0xBE, 0xDE, 0x06, 0xF8, 0x1B, 0xE0, 0x9C, 0x80, 0x17, 0x52, 0xA0, 0xBA,
+    0x95, 0x06, 0x4D, 0x98, 0x32, 0x6C, 0xB3, 0x71, 0xA5, 0x9B, 0x8E, 0xF0,
+    0xE3, 0xB1, 0x6F, 0x0E, 0x3B, 0x16, 0xED, 0x5B, 0x32, 0x6E, 0xD5, 0xB3,
+    0x36, 0xB1, 0x5B, 0x33, 0x6B, 0x16, 0x24, 0x36, 0xAD, 0xDA, 0x34, 0x6A,
+    0xDD, 0xA3, 0x56, 0x8D, 0xDA, 0x35, 0x67, 0x1E, 0x14, 0x56, 0x6E, 0x59,
+    0x37, 0x64, 0xE5, 0x93, 0x76, 0x4E, 0x59, 0x37, 0x64, 0xE5, 0x8B, 0x86,
+    0x2E, 0xF4, 0xEB, 0xD3, 0xAF, 0x4E, 0xBB, 0x73, 0x65, 0xCD, 0x97, 0x18,
+    0x00, 0x09, 0xB0, 0x65, 0xC3, 0x94, 0xD2, 0x4C, 0x58, 0xF1, 0xE3, 0x38,
+    0x8B, 0x26, 0x1C, 0xB6, 0x6F, 0x20, 0xCD, 0xFF, 0x7C, 0x0D, 0xF0, 0x37,
+    0xFF, 0x31, 0x7B, 0x06, 0x5C, 0x39, 0x4D, 0x5C, 0xC5, 0x8F, 0x1E, 0x33,
+    0x96, 0xB2, 0x61, 0xCB, 0x84, 0xF2, 0x0C, 0xD8, 0x09, 0xD0, 0xA6, 0xC3,
+    0x97, 0x12, 0x5B, 0x69, 0x31, 0xDC, 0xB8, 0x8F, 0x26, 0x2C, 0xA8, 0xAF,
+    0x21, 0xCD, 0x66, 0xFA, 0x0C, 0xF6, 0x2F, 0xC1, 0x5F, 0x07, 0x7C, 0x23,
+    0xF0, 0xAF, 0xC2, 0xBF, 0x0A, 0xFC, 0x2B, 0xF0, 0xAF, 0xC2, 0xBF, 0x0A,
+    0xFC, 0x2B, 0xF0, 0xAF, 0xC2, 0xBA, 0x00, 0x1E, 0x1C, 0x20, 0xF0, 0xE1,
+    0x07, 0x87, 0x09, 0xF3, 0xA7, 0x5E, 0x9D, 0x3A, 0x74, 0xF9, 0xD3, 0xA7,
+    0x4F, 0x9D, 0x3A, 0x74, 0xEB, 0xD3, 0xA7, 0x4E, 0xBD, 0xC3, 0x87, 0x0E,
+    0x1C, 0x38, 0x70, 0xE0, 0x40, 0x0E, 0x1C, 0x39, 0xB3, 0x66, 0xCD, 0x9B,
+    0x36, 0x6C, 0xD9, 0xB3, 0x66, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x66,
+    0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x67, 0xC3, 0x84, 0x05, 0x0A, 0x54,
+    0x28, 0x52, 0xA1, 0x42, 0x95, 0x0A, 0x14, 0x99, 0x50, 0xA4, 0xCA, 0x85,
+    0x0A, 0x54, 0x28, 0x52, 0xA1, 0x42, 0x95, 0x08, 0x0E, 0x1C, 0x21, 0xB3,
+    0x66, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x66, 0xCD, 0x9B, 0x36, 0x6C,
+    0xD9, 0xB3, 0x66, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x67, 0xC3, 0x87,
+    0x57, 0x32, 0x64, 0x67, 0x62, 0x9D, 0x13, 0x56, 0x69, 0x52, 0x33, 0x68,
+    0xCD, 0xAA, 0x34, 0xCC, 0x5B, 0xA1, 0x50, 0xC0, 0x0E, 0x1C, 0x38, 0x70,
+    0xE1, 0xC0, 0x08, 0x91, 0x1A, 0xB5, 0x60, 0x5F, 0x1C, 0x1B, 0x70, 0xA9,
+    0x1A, 0x1B, 0x87, 0xCF, 0x9F, 0x3A, 0xEB, 0xC2, 0x9F, 0x04, 0x4C, 0xAB,
+    0xB2, 0x90, 0xC9, 0xCB, 0x27, 0x10, 0xA2, 0xE3, 0xE0, 0xC6, 0x97, 0x02,
+    0x70, 0xF2, 0x40, 0x07, 0xAF, 0x5E, 0xBD, 0x7A, 0xF5, 0xEB, 0x3A, 0xAC,
+    0x78, 0x23, 0xE1, 0xCB, 0x25, 0x1A, 0xD0, 0x64, 0x31, 0x73, 0xEB, 0x56,
+    0xAD, 0x5A, 0xB5, 0x78, 0x63, 0x5A, 0x0E, 0x48, 0x4C, 0x78, 0x32, 0x63,
+    0xC1, 0x1B, 0x3A, 0xA0, 0x5E, 0xFC, 0x1A, 0xF0, 0xA9, 0x16, 0x14, 0x76,
+    0x4E, 0x76, 0xBD, 0x7A, 0xF5, 0xEB, 0xD7, 0x4C, 0x5C, 0xB1, 0x8E, 0xCA,
+    0xAC, 0x3E, 0x15, 0x78, 0x38, 0xCA, 0x00, 0xE7, 0xCF, 0x9F, 0x3E, 0x7C,
+    0xF9, 0xAE, 0x36, 0x7C, 0x18, 0xB2, 0xE1, 0xC0, 0x8D, 0x5C, 0x31, 0xE8,
+    0xB9, 0xE0, 0x67, 0xDE, 0xBD, 0x7A, 0xF5, 0xEB, 0x62, 0xE6, 0x0C, 0x7A,
+    0x35, 0x71, 0x70, 0xA2, 0x8F, 0x83, 0x24, 0xB9, 0x10, 0x5D, 0x1C, 0x1A,
+    0xF0, 0xA7, 0x56, 0x13, 0x86, 0x4A, 0x90, 0xBA, 0xE1, 0xC3, 0x87, 0x0E,
+    0x1C, 0x38, 0x5D, 0x7A, 0xF9, 0xCB, 0x18, 0xEC, 0xE2, 0xC3, 0xE1, 0x57,
+    0x83, 0x8C, 0xA0, 0x46, 0x70, 0xA9, 0x34, 0x68, 0xD1, 0x97, 0x0E, 0x1C,
+    0x9A, 0x34, 0x68, 0xD1, 0xA3, 0x46, 0x8D, 0x1A, 0x34, 0x68, 0xD1, 0xA3,
+    0x46, 0x8C, 0x80, 0x5A, 0x6C, 0xF8, 0x21, 0x65, 0xC3, 0x94, 0x4C, 0x31,
+    0xE0, 0xB8, 0xF5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x31, 0x71, 0x06, 0x3C,
+    0x1A, 0x98, 0xB8, 0x31, 0x67, 0xC0, 0x93, 0x5A, 0x6F, 0x5E, 0xBC, 0x64,
+    0xE1, 0x94, 0x68, 0x7C, 0x2A, 0xF0, 0x71, 0x94, 0x00, 0x07, 0x8F, 0x1E,
+    0x3C, 0x78, 0xF1, 0xE3, 0x3C, 0x6C, 0xB8, 0x21, 0x63, 0xC1, 0x8E, 0x4E,
+    0x0D, 0xB8, 0x18, 0xD3, 0xA7, 0x4E, 0x9D, 0x3A, 0x74, 0xE9, 0xD3, 0xA7,
+    0x4E, 0x9D, 0x2C, 0x0E, 0x16, 0x78, 0x70, 0xE1, 0xC3, 0x87, 0x0E, 0x1C,
+    0x08, 0x36, 0x6C, 0xD9, 0xBF, 0x0C, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3,
+    0x66, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x66, 0xCD, 0x9B, 0x36, 0x6C,
+    0xD9, 0xB2, 0xE1, 0xC0, 0x8C, 0x20, 0x07, 0xAF, 0x5E, 0xBD, 0x7A, 0xF5,
+    0xEB, 0x78, 0x4D, 0xA1, 0xB5, 0x88, 0xD2, 0x2B, 0x38, 0xCC, 0xA3, 0xB1,
+    0x90, 0xC6, 0xBF, 0x04, 0xF4, 0x63, 0x43, 0x8A, 0xD5, 0xAB, 0x58, 0x8D,
+    0x9A, 0x36, 0x86, 0xDE, 0x13, 0x86, 0x4E, 0x20, 0xB9, 0x62, 0x00, 0x0E,
+    0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x87, 0x0E, 0x1C, 0x38, 0x10, 0x06, 0x75,
+    0x69, 0xB2, 0xE7, 0xC0, 0x8B, 0x1E, 0x08, 0x78, 0x21, 0xA9, 0xD3, 0x81,
+    0x6A, 0xDD, 0xDB, 0xE8, 0x6F, 0xA1, 0xBE, 0x86, 0xFA, 0x1B, 0xE8, 0x6F,
+    0xA1, 0xBE, 0x86, 0xFA, 0x1B, 0xE8, 0x6F, 0xA1, 0xBE, 0x86, 0xFA, 0x1B,
+    0xE8, 0x6E, 0xC0, 0x06, 0x78, 0xD9, 0x70, 0x42, 0xC7, 0x83, 0x1C, 0x9C,
+    0x1B, 0x70, 0x31, 0xA7, 0x4E, 0x9D, 0x3A, 0x74, 0xE9, 0xD3, 0xA7, 0x4E,
+    0x9D, 0x3A, 0x58, 0x5F, 0x1C, 0x22, 0xF0, 0xC9, 0x16, 0x1C, 0x78, 0x4E,
+    0x58, 0xBA, 0xF7, 0xAF, 0x5E, 0xBD, 0x7A, 0xD8, 0xB9, 0x65, 0x1E, 0x1C,
+    0x58, 0x9C, 0x32, 0xF0, 0x91, 0xD4, 0x00, 0x06, 0x75, 0x59, 0x70, 0x26,
+    0xC7, 0x83, 0x2C, 0x94, 0x6B, 0x41, 0x90, 0xC5, 0xCF, 0xAD, 0x5A, 0xB5,
+    0x6A, 0xD5, 0xE1, 0x8D, 0x68, 0x39, 0x28, 0xF0, 0xE4, 0xC7, 0x82, 0x36,
+    0x75, 0x5E, 0xBD, 0x7A, 0xF5, 0xEB, 0xD0, 0x5C, 0x88, 0xF8, 0x32, 0x45,
+    0xC2, 0x8A, 0x28, 0xB8, 0x63, 0xD1, 0x73, 0xC0, 0xCF, 0xBD, 0x7A, 0xF5,
+    0xEB, 0xD6, 0xC5, 0xCC, 0x18, 0xF4, 0x6A, 0xE2, 0xE1, 0xC0, 0x9F, 0x06,
+    0x2D, 0x71, 0xBE, 0x7C, 0xF9, 0xF3, 0xE7, 0xCC, 0x06, 0x78, 0x78, 0x11,
+    0xE1, 0x0E, 0x2C, 0x56, 0xCD, 0x9B, 0x36, 0x6C, 0xD9, 0xB3, 0x66, 0xCD,
+    0x9B, 0x36, 0x6C, 0x00, 0x4C, 0xDC, 0x12, 0x70, 0x85, 0x16, 0x0B, 0x76,
+    0x2E, 0xDD, 0xCB, 0xF1, 0xC1, 0x3F, 0x05, 0x1E, 0xBC, 0x68, 0xEB, 0x47,
+    0x85, 0x3E, 0x0D, 0x7A, 0x00, 0x26, 0x8D, 0x1A, 0x32, 0xE1, 0xC3, 0x93,
+    0x46, 0x8D, 0x1A, 0x34, 0x68, 0xD1, 0xA3, 0x46, 0x8D, 0x1A, 0x34, 0xA5,
+    0x4E, 0x00, 0x07, 0x3A, 0x74, 0xE9, 0xD3, 0xA7, 0x4E, 0x9D, 0x3A, 0x74,
+    0xE9, 0xD3, 0xA3, 0x81, 0x6E, 0x0D, 0x30, 0xF0, 0x62, 0xC7, 0x82, 0x26,
+    0x78, 0xD8, 0x17, 0x4C, 0x5C, 0xB2, 0x72, 0xCD, 0xC3, 0x36, 0xED, 0x1B,
+    0xB5, 0x6C, 0xD5, 0xAB, 0x66, 0xAD, 0xDA, 0x37, 0x66, 0xE1, 0x9B, 0x96,
+    0x2E, 0x98, 0xBA, 0x62, 0xEE, 0xE5, 0xCB, 0xAD, 0xC0, 0x08, 0xEE, 0x18,
+    0xB6, 0xAD, 0x05, 0xB5, 0x66, 0x4D, 0xAB, 0x32, 0x8B, 0x59, 0x9B, 0x46,
+    0x2D, 0x1A, 0x34, 0x62, 0xD1, 0xA3, 0x46, 0x2D, 0x1A, 0xB3, 0x46, 0x91,
+    0xAB, 0x26, 0x6C, 0x9B, 0x32, 0x66, 0xC9, 0xB3, 0x26, 0x6C, 0x9B, 0xB1,
+    0x4A, 0x89, 0x46, 0x5D, 0x19, 0x74, 0xD5, 0xD3, 0x1E, 0x54, 0x79, 0x51,
+    0xE2, 0x80, 0x17, 0x2C, 0x9B, 0xB3, 0x8A, 0xD5, 0xAB, 0x66, 0x6D, 0xE0,
+    0xB9, 0x62, 0xEA, 0xDC, 0xD7, 0x96, 0xB5, 0x31, 0x70, 0xCA, 0x34, 0x36,
+    0xCD, 0x5A, 0x36, 0x85, 0x1D, 0x93, 0x96, 0x17, 0x2C, 0x9C, 0xB2, 0x72,
+    0xCD, 0xBB, 0x46, 0xED, 0x1B, 0xB5, 0x6A, 0xD9, 0xAB, 0x66, 0x91, 0xD9,
+    0xB8, 0x66, 0xE1, 0x93, 0xA6, 0x2E, 0x98, 0xBA, 0xD9, 0x72, 0xE4, 0xE7,
+    0xCF, 0x5F, 0x3D, 0x9A, 0xEF, 0x5D, 0xC9, 0x60, 0x1E, 0x18, 0xB8, 0x62,
+    0xE1, 0xB1, 0xDB, 0xB7, 0x72, 0xA5, 0x4A, 0x96, 0xED, 0xDC, 0xA9, 0x52,
+    0xA5, 0xF0, 0xE1, 0xC3, 0x87, 0x0E, 0x0C, 0x56, 0x90, 0xE9, 0xB5, 0x6A,
+    0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xD1, 0x9D, 0x36, 0xB5, 0x5B,
+    0x35, 0x6A, 0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xD6, 0xA4, 0x56,
+    0x0E, 0x1C, 0x38, 0x70, 0xE1, 0xC3, 0x87, 0x0E, 0x0C, 0x06, 0xB1, 0x2A,
+    0xB5, 0x6A, 0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xD9, 0xAD, 0x56,
+    0x74, 0xDA, 0x35, 0x6A, 0xD5, 0xAB, 0x56, 0xAD, 0x5A, 0xB5, 0x6A, 0xCE,
+    0x9C, 0x46, 0xA0, 0x27, 0x7A, 0x38, 0x15, 0xA5, 0x4E, 0x2F, 0x03, 0x1A,
+    0xA1, 0x00,};
+
+const GFXglyph FreeSans18pt7bRLEGlyphs[] PROGMEM = {
+    {0, 0, 0, 9, 0, 1}, // 0x20 ' '
+    {0, 3, 26, 12, 4, -25}, // 0x21 '!'
+    {12, 9, 9, 12, 1, -24}, // 0x22 '"'
+    {24, 19, 24, 19, 0, -23}, // 0x23 '#'
+    {73, 16, 30, 19, 2, -26}, // 0x24 '$'
+    {127, 29, 25, 31, 1, -24}, // 0x25 '%'
+    {192, 20, 25, 23, 2, -24}, // 0x26 '&'
+    {238, 3, 9, 7, 2, -24}, // 0x27 '''
+    {244, 8, 33, 12, 3, -25}, // 0x28 '('
+    {273, 8, 33, 12, 1, -25}, // 0x29 ')'
+    {303, 10, 10, 14, 2, -25}, // 0x2A '*'
+    {317, 16, 16, 20, 2, -15}, // 0x2B '+'
+    {336, 3, 9, 10, 3, -3}, // 0x2C ','
+    {343, 8, 3, 12, 2, -10}, // 0x2D '-'
+    {347, 3, 4, 9, 3, -3}, // 0x2E '.'
+    {349, 10, 26, 10, 0, -25}, // 0x2F '/'
+    {373, 16, 25, 19, 2, -24}, // 0x30 '0'
+    {408, 8, 25, 19, 4, -24}, // 0x31 '1'
+    {431, 16, 25, 19, 2, -24}, // 0x32 '2'
+    {461, 17, 25, 19, 1, -24}, // 0x33 '3'
+    {495, 16, 25, 19, 1, -24}, // 0x34 '4'
+    {530, 17, 25, 19, 1, -24}, // 0x35 '5'
+    {564, 16, 25, 19, 2, -24}, // 0x36 '6'
+    {603, 16, 25, 19, 2, -24}, // 0x37 '7'
+    {630, 17, 25, 19, 1, -24}, // 0x38 '8'
+    {670, 16, 25, 19, 1, -24}, // 0x39 '9'
+    {709, 3, 19, 9, 3, -18}, // 0x3A ':'
+    {715, 3, 24, 9, 3, -18}, // 0x3B ';'
+    {726, 17, 17, 20, 2, -16}, // 0x3C '<'
+    {742, 17, 9, 20, 2, -12}, // 0x3D '='
+    {759, 17, 17, 20, 2, -16}, // 0x3E '>'
+    {777, 15, 26, 19, 3, -25}, // 0x3F '?'
+    {805, 32, 31, 36, 1, -25}, // 0x40 '@'
+    {892, 22, 26, 23, 1, -25}, // 0x41 'A'
+    {939, 19, 26, 23, 3, -25}, // 0x42 'B'
+    {987, 22, 26, 25, 1, -25}, // 0x43 'C'
+    {1036, 20, 26, 24, 3, -25}, // 0x44 'D'
+    {1078, 18, 26, 22, 3, -25}, // 0x45 'E'
+    {1116, 17, 26, 21, 3, -25}, // 0x46 'F'
+    {1149, 24, 26, 27, 1, -25}, // 0x47 'G'
+    {1203, 19, 26, 25, 3, -25}, // 0x48 'H'
+    {1231, 3, 26, 10, 4, -25}, // 0x49 'I'
+    {1242, 14, 26, 18, 1, -25}, // 0x4A 'J'
+    {1269, 20, 26, 24, 3, -25}, // 0x4B 'K'
+    {1315, 15, 26, 20, 3, -25}, // 0x4C 'L'
+    {1342, 24, 26, 30, 3, -25}, // 0x4D 'M'
+    {1402, 20, 26, 26, 3, -25}, // 0x4E 'N'
+    {1446, 25, 26, 27, 1, -25}, // 0x4F 'O'
+    {1497, 18, 26, 23, 3, -25}, // 0x50 'P'
+    {1532, 25, 28, 27, 1, -25}, // 0x51 'Q'
+    {1590, 20, 26, 25, 3, -25}, // 0x52 'R'
+    {1640, 20, 26, 23, 1, -25}, // 0x53 'S'
+    {1684, 19, 26, 22, 1, -25}, // 0x54 'T'
+    {1733, 19, 26, 25, 3, -25}, // 0x55 'U'
+    {1762, 21, 26, 23, 1, -25}, // 0x56 'V'
+    {1808, 32, 26, 33, 0, -25}, // 0x57 'W'
+    {1885, 21, 26, 23, 1, -25}, // 0x58 'X'
+    {1928, 23, 26, 24, 0, -25}, // 0x59 'Y'
+    {1975, 19, 26, 22, 1, -25}, // 0x5A 'Z'
+    {2009, 6, 33, 10, 2, -25}, // 0x5B '['
+    {2037, 10, 26, 10, 0, -25}, // 0x5C ' '
+    {2060, 6, 33, 10, 1, -25}, // 0x5D ']'
+    {2088, 13, 13, 16, 2, -24}, // 0x5E '^'
+    {2108, 21, 2, 19, -1, 5}, // 0x5F '_'
+    {2114, 7, 5, 9, 1, -25}, // 0x60 '`'
+    {2119, 17, 19, 19, 1, -18}, // 0x61 'a'
+    {2151, 16, 26, 20, 2, -25}, // 0x62 'b'
+    {2188, 16, 19, 18, 1, -18}, // 0x63 'c'
+    {2215, 17, 26, 20, 1, -25}, // 0x64 'd'
+    {2253, 16, 19, 19, 1, -18}, // 0x65 'e'
+    {2283, 7, 26, 10, 1, -25}, // 0x66 'f'
+    {2307, 16, 27, 19, 1, -18}, // 0x67 'g'
+    {2349, 15, 26, 19, 2, -25}, // 0x68 'h'
+    {2379, 3, 26, 8, 2, -25}, // 0x69 'i'
+    {2389, 6, 34, 9, 0, -25}, // 0x6A 'j'
+    {2418, 16, 26, 18, 2, -25}, // 0x6B 'k'
+    {2459, 3, 26, 7, 2, -25}, // 0x6C 'l'
+    {2470, 24, 19, 28, 2, -18}, // 0x6D 'm'
+    {2511, 15, 19, 19, 2, -18}, // 0x6E 'n'
+    {2535, 17, 19, 19, 1, -18}, // 0x6F 'o'
+    {2563, 16, 25, 20, 2, -18}, // 0x70 'p'
+    {2599, 17, 25, 20, 1, -18}, // 0x71 'q'
+    {2636, 9, 19, 12, 2, -18}, // 0x72 'r'
+    {2656, 14, 19, 17, 2, -18}, // 0x73 's'
+    {2681, 7, 23, 10, 1, -22}, // 0x74 't'
+    {2702, 15, 19, 19, 2, -18}, // 0x75 'u'
+    {2726, 17, 19, 17, 0, -18}, // 0x76 'v'
+    {2757, 25, 19, 25, 0, -18}, // 0x77 'w'
+    {2810, 16, 19, 17, 0, -18}, // 0x78 'x'
+    {2839, 17, 27, 17, 0, -18}, // 0x79 'y'
+    {2876, 15, 19, 17, 1, -18}, // 0x7A 'z'
+    {2899, 8, 33, 12, 1, -25}, // 0x7B '{'
+    {2928, 2, 33, 9, 3, -25}, // 0x7C '|'
+    {2937, 8, 33, 12, 3, -25}, // 0x7D '}'
+    {2967, 15, 7, 18, 1, -15}, // 0x7E '~'
+};
+
+const GFXfont FreeSans18pt7bRLE PROGMEM = {(uint8_t *)FreeSans18pt7bRLEBitmaps,
+    (GFXglyph *)FreeSans18pt7bRLEGlyphs, 0x20, 0x7E, 42, 0x43};
+
+// Approx. 3650 bytes
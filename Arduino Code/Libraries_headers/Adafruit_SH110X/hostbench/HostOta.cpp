@@ -0,0 +1,187 @@
+// Stand-in flash slot, signature check and update server for OtaUpdate
+
+#include "HostOta.h"
+
+static void put32(std::vector<uint8_t> &frame, uint32_t v) {
+  for (uint8_t i = 0; i < 4; i++)
+    frame.push_back(v >> (8 * i));
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+         (uint32_t)p[3] << 24;
+}
+
+/* HostFlash */
+
+HostFlash::HostFlash(const char *path, uint32_t slot_size)
+    : _path(path), _slot_size(slot_size) {}
+
+HostFlash::~HostFlash() {
+  if (_file)
+    fclose(_file);
+}
+
+// Erases the slot: the file starts out empty
+bool HostFlash::begin(uint32_t size) {
+  if (_file)
+    fclose(_file);
+  _file = NULL;
+  if (size > _slot_size)
+    return false;
+  _file = fopen(_path, "wb");
+  _size = size;
+  _written = 0;
+  return _file != NULL;
+}
+
+bool HostFlash::write(const uint8_t *data, size_t len) {
+  if (!_file || _written + len > _size)
+    return false;
+  uint32_t start = micros();
+  bool ok = fwrite(data, 1, len, _file) == len;
+  uint32_t took = micros() - start;
+  if (took > longest)
+    longest = took;
+  _written += len;
+  writes++;
+  return ok;
+}
+
+// Like esp_ota_end(): refuses a slot that was not written to the end
+bool HostFlash::activate() {
+  if (!_file)
+    return false;
+  bool ok = fclose(_file) == 0 && _written == _size;
+  _file = NULL;
+  if (ok)
+    activated++;
+  return ok;
+}
+
+void HostFlash::abort() {
+  if (_file)
+    fclose(_file);
+  _file = NULL;
+  aborted++;
+}
+
+/// True if the slot file holds exactly image
+bool HostFlash::contains(const std::vector<uint8_t> &image) {
+  FILE *f = fopen(_path, "rb");
+  if (!f)
+    return false;
+  std::vector<uint8_t> slot(image.size() + 1);
+  size_t n = fread(slot.data(), 1, slot.size(), f);
+  fclose(f);
+  return n == image.size() &&
+         memcmp(slot.data(), image.data(), image.size()) == 0;
+}
+
+/* HostOtaVerifier */
+
+bool HostOtaVerifier::verify(const uint8_t hash[SHA256_SIZE],
+                             const uint8_t *signature, size_t len) {
+  uint8_t expected[SHA256_SIZE], diff = 0;
+  Sha256::hmac(_key, _key_len, hash, SHA256_SIZE, expected);
+  if (len != SHA256_SIZE)
+    return false;
+  for (uint8_t i = 0; i < SHA256_SIZE; i++)
+    diff |= expected[i] ^ signature[i];
+  return !diff;
+}
+
+/* HostOtaServer */
+
+HostOtaServer::HostOtaServer(const std::vector<uint8_t> &image,
+                             uint32_t version, const uint8_t *key,
+                             size_t key_len)
+    : signed_version(version), _image(image), _version(version), _key(key),
+      _key_len(key_len) {}
+
+/// Offers the image to device: sends 'B'
+void HostOtaServer::start(OtaUpdate &device) {
+  _device = &device;
+  _inbox.clear();
+  _finished = _accepted = false;
+  _error = OTA_OK;
+  chunks = 0;
+
+  std::vector<uint8_t> frame = {'B'};
+  put32(frame, _image.size());
+  put32(frame, _version);
+  send(frame);
+}
+
+/// A frame from the device, answered on the next poll()
+void HostOtaServer::receive(const uint8_t *frame, size_t len) {
+  _inbox.emplace_back(frame, frame + len);
+}
+
+/// Answers the device: the next chunk, the signature, or nothing when done
+void HostOtaServer::poll(void) {
+  while (!_inbox.empty()) {
+    std::vector<uint8_t> f = _inbox.front();
+    _inbox.pop_front();
+    if (f.empty() || _finished)
+      continue;
+
+    if (f[0] == 'K') {
+      _finished = _accepted = true;
+    } else if (f[0] == 'E' && f.size() == 2) {
+      _finished = true;
+      _error = f[1];
+    } else if (f[0] == 'A' && f.size() == 7) {
+      uint32_t offset = get32(&f[1]);
+      uint16_t max = f[5] | f[6] << 8;
+      if (offset && offset == lose_ack_at) {
+        lose_ack_at = UINT32_MAX; // Time out and send the last chunk again
+        sendChunk(_last_offset, _last_max);
+      } else if (offset == _image.size()) {
+        // Sign SHA-256(SHA-256(image) size version) the way a build would
+        uint8_t message[SHA256_SIZE + 8], hash[SHA256_SIZE];
+        Sha256 sha;
+        sha.begin();
+        sha.update(_image.data(), _image.size());
+        sha.finish(message);
+        for (uint8_t i = 0; i < 4; i++) {
+          message[SHA256_SIZE + i] = _image.size() >> (8 * i);
+          message[SHA256_SIZE + 4 + i] = signed_version >> (8 * i);
+        }
+        sha.begin();
+        sha.update(message, sizeof(message));
+        sha.finish(hash);
+        std::vector<uint8_t> frame(1 + SHA256_SIZE, 'F');
+        Sha256::hmac(_key, _key_len, hash, SHA256_SIZE, &frame[1]);
+        send(frame);
+      } else if (offset == abort_at) {
+        send({'X'});
+      } else {
+        sendChunk(offset, max);
+      }
+    }
+  }
+}
+
+void HostOtaServer::sendChunk(uint32_t offset, uint16_t max) {
+  uint32_t n = min((uint32_t)max, (uint32_t)_image.size() - offset);
+  std::vector<uint8_t> frame = {'D'};
+  put32(frame, offset);
+  frame.insert(frame.end(), _image.begin() + offset,
+               _image.begin() + offset + n);
+  if (offset == corrupt_at)
+    frame.back() ^= 0x01;
+  _last_offset = offset;
+  _last_max = max;
+  send(frame);
+  if (offset == repeat_at) {
+    repeat_at = UINT32_MAX;
+    send(frame);
+  }
+}
+
+void HostOtaServer::send(const std::vector<uint8_t> &frame) {
+  if (frame[0] == 'D')
+    chunks++;
+  _device->receive(frame.data(), frame.size());
+}
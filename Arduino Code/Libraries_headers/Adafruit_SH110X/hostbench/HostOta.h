@@ -0,0 +1,101 @@
+// Stand-ins for the two ends of a firmware update (OtaUpdate in
+// Custom_Menu_Mosiah): a flash slot backed by a file, a server that
+// streams a signed image in the OtaUpdate frame protocol, and a verifier
+// for its signatures.
+//
+// The host has no mbedTLS, so images are signed with HMAC-SHA256 over the
+// same hash the ESP32 checks an ECDSA signature of. That is only good
+// enough for the bench: anyone with the key could sign.
+//
+// The server and the device talk through function calls instead of a
+// WebSocket. Frames from the device are queued and answered in poll(), the
+// way a real server would answer on its next read. The server can be made
+// to corrupt, repeat or give up on the transfer at a chosen offset, and to
+// lose one of the device's acknowledgements.
+
+#ifndef HOST_OTA_H
+#define HOST_OTA_H
+
+#include <Arduino.h>
+#include <OtaUpdate.h>
+#include <deque>
+#include <vector>
+
+/// Inactive flash slot as a file: written in order, activated or dropped
+class HostFlash : public OtaFlash {
+public:
+  HostFlash(const char *path, uint32_t slot_size);
+  ~HostFlash();
+
+  bool begin(uint32_t size) override;
+  bool write(const uint8_t *data, size_t len) override;
+  bool activate() override;
+  void abort() override;
+
+  bool contains(const std::vector<uint8_t> &image);
+
+  uint32_t activated = 0;  ///< Times a new image was set to boot
+  uint32_t aborted = 0;    ///< Times an image was dropped
+  uint32_t writes = 0;     ///< write() calls
+  uint32_t longest = 0;    ///< Longest write() in µs
+
+private:
+  const char *_path;
+  uint32_t _slot_size;
+  uint32_t _size = 0;    ///< Image size given to begin()
+  uint32_t _written = 0;
+  FILE *_file = NULL;
+};
+
+/// HMAC-SHA256 of the signed hash with a shared key
+class HostOtaVerifier : public OtaVerifier {
+public:
+  HostOtaVerifier(const uint8_t *key, size_t key_len)
+      : _key(key), _key_len(key_len) {}
+  bool verify(const uint8_t hash[SHA256_SIZE], const uint8_t *signature,
+              size_t len) override;
+
+private:
+  const uint8_t *_key;
+  size_t _key_len;
+};
+
+/// The update server: one image, one device
+class HostOtaServer {
+public:
+  HostOtaServer(const std::vector<uint8_t> &image, uint32_t version,
+                const uint8_t *key, size_t key_len);
+
+  void start(OtaUpdate &device);
+  void receive(const uint8_t *frame, size_t len);
+  void poll(void);
+
+  bool finished(void) const { return _finished; }
+  bool accepted(void) const { return _accepted; } ///< Device said 'K'
+  uint8_t error(void) const { return _error; }    ///< Code of the device's 'E'
+
+  uint32_t corrupt_at = UINT32_MAX; ///< Flip a byte of the chunk at this offset
+  uint32_t repeat_at = UINT32_MAX;  ///< Send the chunk at this offset twice
+  uint32_t lose_ack_at = UINT32_MAX; ///< Lose the device's 'A' for this offset
+  uint32_t abort_at = UINT32_MAX;   ///< Send 'X' instead of this chunk
+  uint32_t signed_version;          ///< Version signed, normally the one sent
+  uint32_t chunks = 0;              ///< 'D' frames sent
+
+private:
+  void sendChunk(uint32_t offset, uint16_t max);
+  void send(const std::vector<uint8_t> &frame);
+
+  const std::vector<uint8_t> &_image;
+  uint32_t _version;
+  const uint8_t *_key;
+  size_t _key_len;
+  OtaUpdate *_device = NULL;
+  std::deque<std::vector<uint8_t>> _inbox; ///< Frames from the device
+  uint32_t _last_offset = 0;               ///< Offset of the last chunk sent
+  uint16_t _last_max = OTA_CHUNK;
+  bool _finished = false;
+  bool _accepted = false;
+  uint8_t _error = OTA_OK;
+};
+
+#endif // HOST_OTA_H
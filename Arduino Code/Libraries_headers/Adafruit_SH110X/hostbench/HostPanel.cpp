@@ -0,0 +1,228 @@
+// Model of an SH110X controller on the host I2C or SPI bus
+
+#include "HostPanel.h"
+
+HostPanel::HostPanel(uint16_t width, uint16_t height, uint8_t column_offset,
+                     uint8_t addr)
+    : HostI2CDevice(addr), width(width), height(height),
+      _offset(column_offset) {
+  memset(_ram, 0, sizeof(_ram));
+}
+
+// Answer at our address on this I2C bus
+void HostPanel::attach(TwoWire &wire) { wire.attach(*this); }
+
+// Listen on this SPI bus while cs is low, D/C taken from the dc pin
+void HostPanel::attach(SPIClass &spi, int8_t cs, int8_t dc) {
+  _dc = dc;
+  spi.attach(*this, cs);
+}
+
+// One I2C transmission: a control byte, then commands or display data
+void HostPanel::receive(const uint8_t *data, size_t len) {
+  if (!len)
+    return; // Address probe
+  bool is_data = data[0] & 0x40;
+  for (size_t i = 1; i < len; i++) {
+    if (is_data)
+      this->data(data[i]);
+    else
+      command(data[i]);
+  }
+}
+
+// One SPI byte: a command with D/C low, display data with it high
+uint8_t HostPanel::exchange(uint8_t in) {
+  if (digitalRead(_dc) == LOW)
+    command(in);
+  else
+    data(in);
+  return 0xFF; // Write only
+}
+
+void HostPanel::data(uint8_t d) {
+  if ((_page < HOSTPANEL_PAGES) && (_column < HOSTPANEL_COLUMNS))
+    _ram[_page][_column] = d;
+  _column++; // Column address auto-increments, page does not
+}
+
+void HostPanel::command(uint8_t c) {
+  if (_parameter) {
+    if (_parameter == 0x81)
+      contrast = c;
+    _parameter = 0;
+    return;
+  }
+  switch (c) {
+  case 0x81: // Commands followed by one parameter byte
+  case 0xA8:
+  case 0xAD:
+  case 0xD3:
+  case 0xD5:
+  case 0xD9:
+  case 0xDA:
+  case 0xDB:
+  case 0xDC:
+    _parameter = c;
+    break;
+  case 0xAE:
+  case 0xAF:
+    on = c & 1;
+    break;
+  default:
+    if (c <= 0x0F) {
+      _column = (_column & 0xF0) | c;
+    } else if (c <= 0x1F) {
+      _column = (_column & 0x0F) | ((c & 0x0F) << 4);
+    } else if ((c & 0xF0) == 0xB0) {
+      _page = c & 0x0F;
+    }
+    break; // Everything else does not affect display RAM
+  }
+}
+
+// A visible pixel, in the driver's unrotated buffer coordinates
+bool HostPanel::pixel(int16_t x, int16_t y) const {
+  return (_ram[y / 8][x + _offset] >> (y & 7)) & 1;
+}
+
+// Whether the panel shows exactly what is in a driver frame buffer
+bool HostPanel::matches(const uint8_t *buffer) const {
+  return firstDifference(buffer) < 0;
+}
+
+// Index of the first buffer byte that differs from the panel, or -1
+int16_t HostPanel::firstDifference(const uint8_t *buffer) const {
+  for (uint16_t p = 0; p < (height + 7) / 8; p++) {
+    for (uint16_t x = 0; x < width; x++) {
+      if (_ram[p][x + _offset] != buffer[p * width + x])
+        return p * width + x;
+    }
+  }
+  return -1;
+}
+
+// Save as a binary PBM (P4), lit pixels white as on the panel
+bool HostPanel::savePBM(const char *path) const {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  fprintf(f, "P4\n%u %u\n", width, height);
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x += 8) {
+      uint8_t b = 0;
+      for (uint8_t i = 0; (i < 8) && (x + i < width); i++)
+        b |= (pixel(x + i, y) ? 0 : 0x80) >> i; // PBM: 1 is black
+      fputc(b, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n) {
+  crc = ~crc;
+  while (n--) {
+    crc ^= *p++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void putChunk(FILE *f, const char *type, const uint8_t *data,
+                     uint32_t len) {
+  uint8_t head[8] = {(uint8_t)(len >> 24), (uint8_t)(len >> 16),
+                     (uint8_t)(len >> 8), (uint8_t)len};
+  memcpy(head + 4, type, 4);
+  uint32_t crc = crc32(crc32(0, head + 4, 4), data, len);
+  uint8_t tail[4] = {(uint8_t)(crc >> 24), (uint8_t)(crc >> 16),
+                     (uint8_t)(crc >> 8), (uint8_t)crc};
+  fwrite(head, 1, 8, f);
+  fwrite(data, 1, len, f);
+  fwrite(tail, 1, 4, f);
+}
+
+// Save as a 1-bit grayscale PNG. The image data is zlib "stored" (not
+// compressed), which keeps this free of any library; snapshots are tiny.
+bool HostPanel::savePNG(const char *path) const {
+  uint16_t row = 1 + (width + 7) / 8; // Filter byte + packed pixels
+  uint32_t raw_len = (uint32_t)row * height;
+  uint8_t *raw = (uint8_t *)calloc(raw_len, 1);
+  uint8_t *z = (uint8_t *)malloc(raw_len + 6 + 5 * (raw_len / 65535 + 1));
+  if (!raw || !z) {
+    free(raw);
+    free(z);
+    return false;
+  }
+  for (uint16_t y = 0; y < height; y++)
+    for (uint16_t x = 0; x < width; x++)
+      if (pixel(x, y))
+        raw[y * row + 1 + x / 8] |= 0x80 >> (x & 7);
+
+  uint32_t zl = 0, a = 1, b = 0;
+  z[zl++] = 0x78; // zlib header, no compression
+  z[zl++] = 0x01;
+  for (uint32_t done = 0; done < raw_len;) {
+    uint16_t n = min(raw_len - done, (uint32_t)65535);
+    z[zl++] = (done + n == raw_len); // BFINAL, BTYPE = stored
+    z[zl++] = n & 0xFF;
+    z[zl++] = n >> 8;
+    z[zl++] = ~n & 0xFF;
+    z[zl++] = (~n >> 8) & 0xFF;
+    memcpy(z + zl, raw + done, n);
+    zl += n;
+    done += n;
+  }
+  for (uint32_t i = 0; i < raw_len; i++) { // Adler-32
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  uint32_t adler = (b << 16) | a;
+  z[zl++] = adler >> 24;
+  z[zl++] = adler >> 16;
+  z[zl++] = adler >> 8;
+  z[zl++] = adler;
+
+  FILE *f = fopen(path, "wb");
+  if (f) {
+    static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t ihdr[13] = {0, 0, (uint8_t)(width >> 8), (uint8_t)width,
+                        0, 0, (uint8_t)(height >> 8), (uint8_t)height,
+                        1, 0, 0, 0, 0}; // 1 bit, grayscale
+    fwrite(sig, 1, 8, f);
+    putChunk(f, "IHDR", ihdr, 13);
+    putChunk(f, "IDAT", z, zl);
+    putChunk(f, "IEND", NULL, 0);
+  }
+  free(raw);
+  free(z);
+  return f && (fclose(f) == 0);
+}
+
+// Compare with a PBM saved by savePBM(): returns the number of differing
+// pixels, or -1 if the file is missing or a different size
+int HostPanel::comparePBM(const char *path) const {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return -1;
+  unsigned w, h;
+  if ((fscanf(f, "P4 %u %u", &w, &h) != 2) || (w != width) ||
+      (h != height) || (fgetc(f) == EOF)) {
+    fclose(f);
+    return -1;
+  }
+  int diff = 0;
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x += 8) {
+      int b = fgetc(f);
+      if (b == EOF) {
+        fclose(f);
+        return -1;
+      }
+      for (uint8_t i = 0; (i < 8) && (x + i < width); i++)
+        diff += (!((b << i) & 0x80)) != pixel(x + i, y);
+    }
+  }
+  fclose(f);
+  return diff;
+}
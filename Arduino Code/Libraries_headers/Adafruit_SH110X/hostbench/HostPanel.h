@@ -0,0 +1,54 @@
+// Model of an SH110X controller (SH1106G or SH1107) on the host I2C or SPI
+// bus.
+//
+// Decodes the command/data stream the real driver sends (page address,
+// column address, display data) into its own copy of display RAM, so what
+// the panel would show can be compared with the driver's frame buffer and
+// saved as an image. Over I2C the control byte of each transmission says
+// whether commands or data follow, over SPI the level of the D/C pin.
+
+#ifndef HOST_PANEL_H
+#define HOST_PANEL_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#define HOSTPANEL_COLUMNS 132 ///< Column RAM of an SH1106 (SH1107: 128)
+#define HOSTPANEL_PAGES 16    ///< Page RAM of an SH1107 (SH1106: 8)
+
+/// Display RAM rebuilt from bus traffic
+class HostPanel : public HostI2CDevice, public HostSPIDevice {
+public:
+  HostPanel(uint16_t width, uint16_t height, uint8_t column_offset,
+            uint8_t addr = 0x3C);
+
+  void attach(TwoWire &wire);
+  void attach(SPIClass &spi, int8_t cs, int8_t dc);
+  void receive(const uint8_t *data, size_t len) override;
+  uint8_t exchange(uint8_t in) override;
+
+  bool pixel(int16_t x, int16_t y) const;
+  bool matches(const uint8_t *buffer) const;
+  int16_t firstDifference(const uint8_t *buffer) const;
+
+  bool savePBM(const char *path) const;
+  bool savePNG(const char *path) const;
+  int comparePBM(const char *path) const;
+
+  uint16_t width, height; ///< Visible size in pixels
+  uint8_t contrast = 0x80; ///< Set by 0x81, reset value 0x80
+  bool on = false;         ///< Display on (0xAF) or off (0xAE)
+
+private:
+  void command(uint8_t c);
+  void data(uint8_t d);
+
+  uint8_t _ram[HOSTPANEL_PAGES][HOSTPANEL_COLUMNS];
+  uint8_t _offset;
+  int8_t _dc = -1;
+  uint8_t _page = 0, _column = 0;
+  uint8_t _parameter = 0; ///< Command whose parameter comes next, 0 if none
+};
+
+#endif // HOST_PANEL_H
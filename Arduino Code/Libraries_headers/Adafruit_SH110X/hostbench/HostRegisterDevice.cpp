@@ -0,0 +1,107 @@
+// Model of register-file I2C devices on the host bus
+
+#include "HostRegisterDevice.h"
+
+#define TCA_CFG 0x01
+#define TCA_CFG_AI 0x80
+#define TCA_CFG_OVR_FLOW_M 0x20
+#define TCA_CFG_OVR_FLOW_IEN 0x08
+#define TCA_CFG_GPI_IEN 0x02
+#define TCA_CFG_KE_IEN 0x01
+#define TCA_INT_STAT 0x02
+#define TCA_INT_OVR_FLOW 0x08
+#define TCA_INT_GPI 0x02
+#define TCA_INT_K 0x01
+#define TCA_KEY_LCK_EC 0x03
+#define TCA_KEY_EVENT_A 0x04
+#define TCA_KEY_EVENT_J 0x0D
+
+HostRegisterDevice::HostRegisterDevice(uint8_t addr, bool auto_increment)
+    : HostI2CDevice(addr), _auto_increment(auto_increment) {
+  memset(regs, 0, sizeof(regs));
+}
+
+// A write: register pointer, then values from there on
+void HostRegisterDevice::receive(const uint8_t *data, size_t len) {
+  if (!len)
+    return; // Address probe
+  _pointer = data[0];
+  for (size_t i = 1; i < len; i++) {
+    writeRegister(_pointer, data[i]);
+    register_writes++;
+    if (autoIncrement())
+      _pointer++;
+  }
+}
+
+// One byte of a read, from the register pointer
+uint8_t HostRegisterDevice::transmit(void) {
+  uint8_t value = readRegister(_pointer);
+  register_reads++;
+  if (autoIncrement())
+    _pointer++;
+  return value;
+}
+
+/* HostTCA8418 */
+
+HostTCA8418::HostTCA8418(uint8_t addr) : HostRegisterDevice(addr, false) {}
+
+bool HostTCA8418::autoIncrement(void) { return regs[TCA_CFG] & TCA_CFG_AI; }
+
+uint8_t HostTCA8418::readRegister(uint8_t reg) {
+  if (reg == TCA_KEY_LCK_EC)
+    return (regs[reg] & 0xF0) | _count;
+  if (reg == TCA_KEY_EVENT_A) { // Reading the head takes it off the FIFO
+    if (!_count)
+      return 0;
+    uint8_t e = _fifo[0];
+    memmove(_fifo, _fifo + 1, --_count);
+    return e;
+  }
+  if ((reg > TCA_KEY_EVENT_A) && (reg <= TCA_KEY_EVENT_J)) {
+    uint8_t i = reg - TCA_KEY_EVENT_A;
+    return (i < _count) ? _fifo[i] : 0;
+  }
+  return regs[reg];
+}
+
+void HostTCA8418::writeRegister(uint8_t reg, uint8_t value) {
+  if (reg == TCA_INT_STAT) {
+    regs[reg] &= ~value; // Write 1 to clear
+  } else if (reg == TCA_KEY_LCK_EC) {
+    regs[reg] = (regs[reg] & 0x0F) | (value & 0xF0); // Count is read only
+  } else if ((reg < TCA_KEY_EVENT_A) || (reg > TCA_KEY_EVENT_J)) {
+    regs[reg] = value;
+  }
+}
+
+// Key at row, col (0 based) went down
+void HostTCA8418::press(uint8_t row, uint8_t col) {
+  event(0x80 | (row * 10 + col + 1));
+}
+
+// Key at row, col went up
+void HostTCA8418::release(uint8_t row, uint8_t col) {
+  event(row * 10 + col + 1);
+}
+
+// Log a raw event as the key scanner would
+void HostTCA8418::event(uint8_t e) {
+  if (_count == HOSTTCA8418_FIFO) {
+    regs[TCA_INT_STAT] |= TCA_INT_OVR_FLOW;
+    if (!(regs[TCA_CFG] & TCA_CFG_OVR_FLOW_M))
+      return; // New events are lost
+    memmove(_fifo, _fifo + 1, --_count); // Oldest is pushed out
+  }
+  _fifo[_count++] = e;
+  regs[TCA_INT_STAT] |= TCA_INT_K;
+}
+
+// Whether the INT pin is being held low
+bool HostTCA8418::interrupt(void) {
+  uint8_t cfg = regs[TCA_CFG], stat = regs[TCA_INT_STAT];
+  return ((stat & TCA_INT_K) && (cfg & TCA_CFG_KE_IEN)) ||
+         ((stat & TCA_INT_GPI) && (cfg & TCA_CFG_GPI_IEN)) ||
+         ((stat & TCA_INT_OVR_FLOW) && (cfg & TCA_CFG_OVR_FLOW_IEN));
+}
@@ -0,0 +1,60 @@
+// Model of a generic register-file I2C device, and of a TCA8418 keypad
+// controller built on it.
+//
+// A write transmission sets the register pointer with its first byte and
+// stores the rest from there; a read returns registers from the pointer
+// on. With auto-increment the pointer moves on after every byte, without
+// it a burst keeps hitting the same register (how FIFOs are read).
+
+#ifndef HOST_REGISTER_DEVICE_H
+#define HOST_REGISTER_DEVICE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/// 256 byte registers behind an address pointer
+class HostRegisterDevice : public HostI2CDevice {
+public:
+  HostRegisterDevice(uint8_t addr, bool auto_increment = true);
+
+  void receive(const uint8_t *data, size_t len) override;
+  uint8_t transmit(void) override;
+
+  virtual uint8_t readRegister(uint8_t reg) { return regs[reg]; }
+  virtual void writeRegister(uint8_t reg, uint8_t value) { regs[reg] = value; }
+  virtual bool autoIncrement(void) { return _auto_increment; }
+
+  uint8_t regs[256];            ///< Register contents
+  uint32_t register_reads = 0;  ///< Registers read over the bus
+  uint32_t register_writes = 0; ///< Registers written over the bus
+
+protected:
+  uint8_t _pointer = 0;
+  bool _auto_increment;
+};
+
+#define HOSTTCA8418_FIFO 10 ///< Key events the chip holds
+
+/// TCA8418: key event FIFO at KEY_EVENT_A, event count in KEY_LCK_EC,
+/// write-1-to-clear INT_STAT, auto-increment while CFG.AI is set
+class HostTCA8418 : public HostRegisterDevice {
+public:
+  HostTCA8418(uint8_t addr = 0x34);
+
+  uint8_t readRegister(uint8_t reg) override;
+  void writeRegister(uint8_t reg, uint8_t value) override;
+  bool autoIncrement(void) override;
+
+  void press(uint8_t row, uint8_t col);
+  void release(uint8_t row, uint8_t col);
+  void event(uint8_t e);
+  bool interrupt(void);
+
+  uint8_t queued(void) const { return _count; } ///< Events in the FIFO
+
+private:
+  uint8_t _fifo[HOSTTCA8418_FIFO];
+  uint8_t _count = 0;
+};
+
+#endif // HOST_REGISTER_DEVICE_H
@@ -0,0 +1,128 @@
+// Just enough of the Arduino core to build the display libraries on a PC.
+// Only what Adafruit_BusIO, Adafruit_GFX, Adafruit_SH110X and the menu
+// code actually use is provided.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <algorithm>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+
+typedef bool boolean;
+typedef uint8_t byte;
+enum BitOrder { LSBFIRST = 0, MSBFIRST = 1 };
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+using std::max;
+using std::min;
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+/// Arduino String, backed by std::string
+class String {
+public:
+  String(const char *c = "") : s(c ? c : "") {}
+  String(const std::string &str) : s(str) {}
+  String(const __FlashStringHelper *f) : s((const char *)f) {}
+  String(char c) : s(1, c) {}
+  String(int v, unsigned char base = DEC) : s(fmt(base == HEX ? "%x" : "%d", v)) {}
+  String(unsigned v, unsigned char base = DEC) : s(fmt(base == HEX ? "%x" : "%u", v)) {}
+  String(long v, unsigned char base = DEC) : s(fmt(base == HEX ? "%lx" : "%ld", v)) {}
+  String(unsigned long v, unsigned char base = DEC)
+      : s(fmt(base == HEX ? "%lx" : "%lu", v)) {}
+  String(float v, unsigned char decimals = 2) : s(fmt("%.*f", decimals, v)) {}
+  String(double v, unsigned char decimals = 2) : s(fmt("%.*f", decimals, v)) {}
+
+  const char *c_str() const { return s.c_str(); }
+  unsigned length() const { return s.size(); }
+  char operator[](unsigned i) const { return s[i]; }
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator!=(const String &o) const { return s != o.s; }
+  String &operator+=(const String &o) {
+    s += o.s;
+    return *this;
+  }
+  friend String operator+(const String &a, const String &b) {
+    return String(a.s + b.s);
+  }
+  friend String operator+(const String &a, const char *b) {
+    return String(a.s + b);
+  }
+  friend String operator+(const char *a, const String &b) {
+    return String(a + b.s);
+  }
+  String substring(unsigned from, unsigned to) const {
+    return String(s.substr(from, to - from));
+  }
+  int toInt() const { return atoi(s.c_str()); }
+  float toFloat() const { return atof(s.c_str()); }
+  void reserve(unsigned n) { s.reserve(n); }
+
+private:
+  template <class T> static std::string fmt(const char *f, T v) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), f, v);
+    return buf;
+  }
+  static std::string fmt(const char *f, unsigned d, double v) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), f, (int)d, v);
+    return buf;
+  }
+  std::string s;
+};
+
+#include "Print.h"
+
+/// Serial port, printing to stdout when enabled
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override {
+    if (echo)
+      putchar(c);
+    return 1;
+  }
+  using Print::write;
+  operator bool() { return true; }
+  bool echo = false; ///< Off by default so benchmark output stays readable
+};
+extern HardwareSerial Serial;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Host only: a simulated clock for timing tests. While it runs, millis()
+// and micros() stand still except when advanced, by hostClockAdvance() or
+// delay(). hostClockStop() goes back to real time.
+void hostClockStart(unsigned long us = 0);
+void hostClockAdvance(unsigned long us);
+void hostClockStop(void);
+void yield(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+#endif // HOST_ARDUINO_H
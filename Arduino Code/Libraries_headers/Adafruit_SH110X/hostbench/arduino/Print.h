@@ -0,0 +1,54 @@
+// Host version of the Arduino Print and Stream classes
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include "Arduino.h"
+
+/// Base class of everything that can print text
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) {
+    for (size_t i = 0; i < n; i++)
+      write(buf[i]);
+    return n;
+  }
+  size_t write(const char *str) {
+    return write((const uint8_t *)str, strlen(str));
+  }
+  size_t print(const char *str) { return write(str); }
+  size_t print(const String &str) { return write(str.c_str()); }
+  size_t print(const __FlashStringHelper *str) {
+    return write((const char *)str);
+  }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned v, int base = DEC) { return print(String(v, base)); }
+  size_t print(long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned long v, int base = DEC) {
+    return print(String(v, base));
+  }
+  size_t print(double v, int decimals = 2) {
+    return print(String(v, (unsigned)decimals));
+  }
+  size_t println(void) { return write("\r\n"); }
+  template <class T> size_t println(const T &v) {
+    size_t n = print(v);
+    return n + println();
+  }
+  template <class T> size_t println(const T &v, int fmt) {
+    size_t n = print(v, fmt);
+    return n + println();
+  }
+};
+
+/// Print with input
+class Stream : public Print {
+public:
+  virtual int available(void) { return 0; }
+  virtual int read(void) { return -1; }
+};
+
+#endif // HOST_PRINT_H
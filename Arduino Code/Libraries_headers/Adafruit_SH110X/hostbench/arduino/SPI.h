@@ -0,0 +1,61 @@
+// Host SPI bus simulator. Each byte goes to the device models whose chip
+// select pin is low at the time, and the byte they shift back is returned.
+//
+// Transfers are timed at the clock of the current SPISettings: 8 bit
+// times per byte, nothing for chip select or D/C changes.
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+/// SPI clock, bit order and mode
+class SPISettings {
+public:
+  SPISettings() {}
+  SPISettings(uint32_t clock, BitOrder, uint8_t) : clock(clock) {}
+  uint32_t clock = 4000000; ///< SCK frequency
+};
+
+/// A device model on the host SPI bus
+class HostSPIDevice {
+public:
+  HostSPIDevice() {}
+  virtual ~HostSPIDevice() {}
+
+  /// One byte in while selected; returns the byte shifted out
+  virtual uint8_t exchange(uint8_t in) = 0;
+
+  int8_t cs = -1;             ///< Chip select pin, selected when LOW
+  HostSPIDevice *next = NULL; ///< Next device on the same bus
+};
+
+/// SPI bus that hands traffic to device models instead of sending it
+class SPIClass {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void beginTransaction(SPISettings settings);
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t b);
+  void transfer(void *buf, size_t len);
+
+  void attach(HostSPIDevice &device, int8_t cs);
+  void resetStats(void);
+
+  uint32_t clock = 4000000;  ///< Clock of the last beginTransaction()
+  uint32_t bytes = 0;        ///< Bytes transferred
+  uint32_t transactions = 0; ///< beginTransaction() calls
+  double busy_us = 0;        ///< Time the bus would have been busy
+
+private:
+  HostSPIDevice *_devices = NULL;
+};
+extern SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,67 @@
+// Host I2C bus simulator. Transmissions go to the device models attached
+// at their address (a display controller, a keypad, a register file) and
+// reads are answered by them; an address nobody is attached at is NACKed.
+//
+// Every transfer is also timed as it would be on the wire at the clock
+// last given to setClock(): 9 bit times per byte (8 data + ACK), one for
+// each START and STOP, and 9 for the address byte.
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+/// A device model on the host I2C bus
+class HostI2CDevice {
+public:
+  HostI2CDevice(uint8_t addr) : address(addr) {}
+  virtual ~HostI2CDevice() {}
+
+  /// One write transmission to the device: all its bytes, none for a probe
+  virtual void receive(const uint8_t *data, size_t len) = 0;
+  /// One byte the device sends during a read
+  virtual uint8_t transmit(void) { return 0xFF; }
+
+  uint8_t address;             ///< 7-bit address it answers at
+  HostI2CDevice *next = NULL;  ///< Next device on the same bus
+};
+
+/// I2C bus that hands traffic to device models instead of sending it
+class TwoWire : public Stream {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void setClock(uint32_t hz) { clock = hz; }
+  void beginTransmission(uint8_t addr);
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t addr, uint8_t len, uint8_t stop = 1);
+  size_t write(uint8_t c) override;
+  using Print::write;
+  int available(void) override { return _rx_len - _rx_pos; }
+  int read(void) override;
+
+  void attach(HostI2CDevice &device);
+  HostI2CDevice *device(uint8_t addr);
+  void resetStats(void);
+
+  uint32_t clock = 100000;    ///< Last setClock() value
+  uint32_t bytes = 0;         ///< Bytes written, excluding address bytes
+  uint32_t transmissions = 0; ///< Completed write transmissions
+  uint32_t read_bytes = 0;    ///< Bytes read, excluding address bytes
+  uint32_t reads = 0;         ///< Completed reads
+  uint32_t nacks = 0;         ///< Transfers to an address with no device
+  double busy_us = 0;         ///< Time the bus would have been busy
+
+private:
+  void _busy(uint32_t bit_times);
+
+  uint8_t _addr = 0;
+  uint8_t _buf[256];
+  size_t _len = 0;
+  uint8_t _rx[256];
+  size_t _rx_len = 0, _rx_pos = 0;
+  HostI2CDevice *_devices = NULL;
+};
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
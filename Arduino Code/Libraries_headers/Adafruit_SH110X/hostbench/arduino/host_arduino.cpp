@@ -0,0 +1,159 @@
+// Host implementations of the Arduino core functions used by the bench
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+#include <chrono>
+
+HardwareSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+static bool simulated = false;  ///< hostClockStart() called
+static unsigned long sim_us = 0; ///< Simulated micros()
+
+unsigned long millis(void) { return micros() / 1000; }
+
+unsigned long micros(void) {
+  if (simulated)
+    return sim_us;
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Only the simulated clock moves; real time is never waited for
+void delay(unsigned long ms) { hostClockAdvance(ms * 1000); }
+void delayMicroseconds(unsigned int us) { hostClockAdvance(us); }
+
+void hostClockStart(unsigned long us) {
+  simulated = true;
+  sim_us = us;
+}
+
+void hostClockAdvance(unsigned long us) {
+  if (simulated)
+    sim_us += us;
+}
+
+void hostClockStop(void) { simulated = false; }
+void yield(void) {}
+void pinMode(uint8_t, uint8_t) {}
+
+// Pins driven low, so device models can see chip select and D/C; every
+// pin reads HIGH until written
+static bool pin_low[256];
+
+void digitalWrite(uint8_t pin, uint8_t val) { pin_low[pin] = !val; }
+int digitalRead(uint8_t pin) { return pin_low[pin] ? LOW : HIGH; }
+
+/* I2C */
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  _addr = addr;
+  _len = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+  if (_len >= sizeof(_buf))
+    return 0;
+  _buf[_len++] = c;
+  bytes++;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+  HostI2CDevice *dev = device(_addr);
+  if (!dev) {
+    _busy(1 + 9 + 1); // START, address NACKed, STOP
+    nacks++;
+    _len = 0;
+    return 2;
+  }
+  _busy(1 + 9 * (1 + _len) + (stop ? 1 : 0));
+  transmissions++;
+  dev->receive(_buf, _len);
+  _len = 0;
+  return 0; // ACK
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t len, uint8_t stop) {
+  HostI2CDevice *dev = device(addr);
+  _rx_len = _rx_pos = 0;
+  if (!dev) {
+    _busy(1 + 9 + 1);
+    nacks++;
+    return 0;
+  }
+  for (uint8_t i = 0; i < len; i++)
+    _rx[_rx_len++] = dev->transmit();
+  _busy(1 + 9 * (1 + len) + (stop ? 1 : 0));
+  read_bytes += len;
+  reads++;
+  return len;
+}
+
+int TwoWire::read(void) {
+  return (_rx_pos < _rx_len) ? _rx[_rx_pos++] : -1;
+}
+
+// Put a device model on the bus
+void TwoWire::attach(HostI2CDevice &dev) {
+  dev.next = _devices;
+  _devices = &dev;
+}
+
+// The device answering at an address, or NULL
+HostI2CDevice *TwoWire::device(uint8_t addr) {
+  for (HostI2CDevice *d = _devices; d; d = d->next)
+    if (d->address == addr)
+      return d;
+  return NULL;
+}
+
+void TwoWire::resetStats(void) {
+  bytes = transmissions = read_bytes = reads = nacks = 0;
+  busy_us = 0;
+}
+
+void TwoWire::_busy(uint32_t bit_times) {
+  busy_us += bit_times * 1e6 / clock;
+}
+
+/* SPI */
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  clock = settings.clock;
+  transactions++;
+}
+
+uint8_t SPIClass::transfer(uint8_t b) {
+  uint8_t in = 0xFF; // MISO floats high with nobody driving it
+  for (HostSPIDevice *d = _devices; d; d = d->next)
+    if ((d->cs < 0) || (digitalRead(d->cs) == LOW))
+      in &= d->exchange(b);
+  bytes++;
+  busy_us += 8 * 1e6 / clock;
+  return in;
+}
+
+void SPIClass::transfer(void *buf, size_t len) {
+  uint8_t *p = (uint8_t *)buf;
+  for (size_t i = 0; i < len; i++)
+    p[i] = transfer(p[i]);
+}
+
+// Put a device model on the bus, selected by a chip select pin (-1: always)
+void SPIClass::attach(HostSPIDevice &dev, int8_t cs) {
+  dev.cs = cs;
+  dev.next = _devices;
+  _devices = &dev;
+}
+
+void SPIClass::resetStats(void) {
+  bytes = transactions = 0;
+  busy_us = 0;
+}
@@ -0,0 +1,503 @@
+// Bus time benchmark for the display and keypad drivers, run on a PC.
+//
+// The real drivers talk to device models on the simulated I2C and SPI
+// buses (arduino/Wire.h, arduino/SPI.h): an SH1106G panel (HostPanel) and
+// a TCA8418 keypad (HostTCA8418). For each case the bench reports the
+// transactions, bytes and bus time it took, so batching, dirty rectangles
+// and register caching can be weighed without hardware, and checks that
+// the models ended up in the state the driver meant (panel RAM equal to
+// the frame buffer, key events in order, GPIO outputs right). Background
+// flushes are checked with the panel held up mid-flush while the next
+// frame is drawn. The keypad
+// events are also run through KeypadGestures, and DisplayGovernor runs the
+// panel for two simulated minutes, on a simulated clock where timing
+// matters.
+//
+// Usage: busbench
+
+#include <Adafruit_SH110X.h>
+#include <Adafruit_TCA8418.h>
+#include <Gestures.h>
+#include <Governor.h>
+
+#include "HostPanel.h"
+#include "HostRegisterDevice.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#define SPI_DC 9  ///< D/C pin of the SPI panel
+#define SPI_CS 10 ///< Chip select pin of the SPI panel
+
+/// Panel whose I2C traffic can be held up, so a background flush is
+/// certain to be running while the bench draws the next frame
+class GatedPanel : public HostPanel {
+public:
+  using HostPanel::HostPanel;
+
+  void receive(const uint8_t *data, size_t len) override {
+    std::unique_lock<std::mutex> lock(_lock);
+    _open.wait(lock, [this] { return !_held; });
+    HostPanel::receive(data, len);
+  }
+
+  void hold(bool held) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _held = held;
+    _open.notify_all();
+  }
+
+private:
+  std::mutex _lock;
+  std::condition_variable _open;
+  bool _held = false;
+};
+
+static GatedPanel panel(128, 64, 2);   // SH1106G RAM starts 2 columns early
+static HostPanel spiPanel(128, 64, 2);
+static HostTCA8418 keypadChip;
+
+static int failures = 0;
+
+Menu *current_menu = NULL; // Used by Menu.cpp
+
+/// Traffic on both buses so far
+typedef struct {
+  uint32_t transactions, bytes;
+  double busy_us;
+} Traffic;
+
+static Traffic traffic(void) {
+  Traffic t = {Wire.transmissions + Wire.reads + SPI.transactions,
+               Wire.bytes + Wire.read_bytes + SPI.bytes,
+               Wire.busy_us + SPI.busy_us};
+  return t;
+}
+
+static void report(const char *name, const Traffic &from, bool ok) {
+  Traffic t = traffic();
+  printf("%-40s %6u %7u %10.1f  %s\n", name, t.transactions - from.transactions,
+         t.bytes - from.bytes, t.busy_us - from.busy_us, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+// A full screen of readings, one value changing with n
+static void drawReadings(Adafruit_SH110X &d, int n) {
+  d.setTextColor(SH110X_WHITE, SH110X_BLACK);
+  d.setCursor(0, 0);
+  d.print("Temp");
+  d.setCursor(60, 0);
+  d.print(String(20.0 + n / 10.0, 1) + " C");
+  for (uint8_t row = 1; row < 8; row++) {
+    d.setCursor(0, row * 8);
+    d.print("Line of static text");
+  }
+}
+
+/* Display: one full frame at each I2C clock, then over SPI */
+static void fullFrames(void) {
+  static const uint32_t clocks[] = {100000, 400000, 1000000};
+  for (uint32_t clock : clocks) {
+    Adafruit_SH1106G d(128, 64, &Wire, -1, clock, 100000);
+    d.begin(0x3C, true);
+    d.fillScreen(SH110X_WHITE);
+    drawReadings(d, 0);
+
+    Traffic from = traffic();
+    d.display();
+    char name[48];
+    snprintf(name, sizeof(name), "full frame, I2C %lu kHz",
+             (unsigned long)clock / 1000);
+    report(name, from, panel.matches(d.getBuffer()));
+  }
+
+  Adafruit_SH1106G d(128, 64, &SPI, SPI_DC, -1, SPI_CS, 8000000UL);
+  d.begin(0x3C, true);
+  d.fillScreen(SH110X_WHITE);
+  drawReadings(d, 0);
+  Traffic from = traffic();
+  d.display();
+  report("full frame, SPI 8 MHz", from, spiPanel.matches(d.getBuffer()));
+}
+
+/* Display: one value changes on an otherwise static screen */
+static void partialFrames(void) {
+  Adafruit_SH1106G d(128, 64, &Wire);
+  d.begin(0x3C, true);
+  drawReadings(d, 0);
+  d.display();
+
+  // The application clears and redraws everything each frame
+  d.clearDisplay();
+  drawReadings(d, 1);
+  Traffic from = traffic();
+  d.display();
+  report("redraw all, dirty window", from, panel.matches(d.getBuffer()));
+
+  d.enableShadowBuffer();
+  d.display(); // Primes the shadow copy
+  d.clearDisplay();
+  drawReadings(d, 2);
+  from = traffic();
+  d.display();
+  report("redraw all, shadow buffer", from, panel.matches(d.getBuffer()));
+  d.enableShadowBuffer(false);
+
+  // Only the value is drawn again
+  d.setCursor(60, 0);
+  d.print(String(20.3, 1) + " C");
+  from = traffic();
+  d.display();
+  report("redraw value only, dirty window", from, panel.matches(d.getBuffer()));
+}
+
+/* Display: the next frame is drawn while the last one is still sent */
+static void asyncFrames(void) {
+  Adafruit_SH1106G d(128, 64, &Wire);
+  d.begin(0x3C, true);
+  d.enableAsyncDisplay();
+  static uint8_t sent[128 * 64 / 8];
+  bool ok = true;
+
+  Traffic from = traffic();
+  for (int n = 0; n < 20; n++) {
+    d.clearDisplay();
+    drawReadings(d, n);
+    memcpy(sent, d.getBuffer(), sizeof(sent));
+    panel.hold(true);
+    d.display();
+    // scribble over the frame buffer; the flush goes on from its snapshot
+    d.fillRect(0, 0, 128, 64, SH110X_INVERSE);
+    ok = ok && d.displayBusy();
+    panel.hold(false);
+    d.waitForDisplay();
+    ok = ok && !d.displayBusy() && panel.matches(sent);
+  }
+  report("async, drawing during flush", from, ok);
+
+  // stopping the thread lets the queued flush finish first
+  d.clearDisplay();
+  drawReadings(d, 20);
+  memcpy(sent, d.getBuffer(), sizeof(sent));
+  from = traffic();
+  panel.hold(true);
+  d.display();
+  panel.hold(false);
+  ok = d.enableAsyncDisplay(false) && !d.displayBusy() && panel.matches(sent);
+  d.display(); // blocking again
+  report("async, disabled with a flush queued", from,
+         ok && panel.matches(d.getBuffer()));
+}
+
+/* Governor: refresh rate, dimming and panel off, one loop() pass per ms */
+static void governor(void) {
+  Adafruit_SH1106G d(128, 64, &Wire);
+  d.begin(0x3C, true);
+  DisplayGovernor gov(d);
+  float value = 0;
+  ValueField field(0, 0, 128, 8, &value, 0);
+  WidgetScreen screen;
+  screen.add(field);
+
+  hostClockStart();
+  gov.wake();
+  uint32_t frames = 0;
+  Traffic from = traffic();
+  for (uint32_t t = 0; t < 2000; t++, hostClockAdvance(1000)) {
+    value = t; // Changes every pass
+    frames += gov.refresh(screen);
+  }
+  report("governor: 2 s changing, 40 frames", from,
+         frames == 40 && panel.matches(d.getBuffer()));
+
+  from = traffic();
+  bool ok = true;
+  for (uint32_t t = 2000; t < 120000; t++, hostClockAdvance(1000)) {
+    gov.refresh(screen); // Nothing changes from here on
+    if (t == 29999)
+      ok = ok && panel.contrast == 0xFF && gov.state() == DISPLAY_IDLE;
+    if (t == 30000)
+      ok = ok && panel.contrast == 0x10 && gov.state() == DISPLAY_DIMMED;
+  }
+  gov.refresh(screen);
+  report("governor: dim at 30 s, off at 120 s", from,
+         ok && !panel.on && gov.state() == DISPLAY_OFF);
+
+  from = traffic();
+  for (uint32_t t = 120000; t < 130000; t++, hostClockAdvance(1000)) {
+    value = t;
+    gov.refresh(screen);
+    if (t % 1000 == 0) { // A sketch drawing directly
+      d.setCursor(0, 56);
+      d.print(t / 1000);
+      gov.display();
+    }
+  }
+  Traffic off = traffic();
+  report("governor: 10 s drawing while off", from,
+         off.bytes == from.bytes && off.transactions == from.transactions);
+
+  from = traffic();
+  ok = gov.wake();
+  report("governor: wake", from,
+         ok && panel.on && panel.contrast == 0xFF &&
+             panel.matches(d.getBuffer()));
+  hostClockStop();
+}
+
+/* Keypad: GPIO writes with and without the register shadow */
+static bool gpioToggles(Adafruit_TCA8418 &keypad, const char *name) {
+  keypad.pinMode(TCA8418_COL8, OUTPUT);
+  keypad.pinMode(TCA8418_COL9, OUTPUT);
+  Traffic from = traffic();
+  for (uint8_t i = 0; i < 32; i++) {
+    keypad.digitalWrite(TCA8418_COL8, i & 1);
+    keypad.digitalWrite(TCA8418_COL9, (i >> 1) & 1);
+  }
+  // Last pass: COL8 high, COL9 high (bits 0 and 1 of GPIO_DAT_OUT_3)
+  bool ok = (keypadChip.regs[TCA8418_REG_GPIO_DAT_OUT_3] & 0x03) == 0x03;
+  report(name, from, ok);
+  return ok;
+}
+
+/* Keypad: five keys pressed and released, read two ways */
+static void pressKeys(void) {
+  for (uint8_t k = 0; k < 5; k++) {
+    keypadChip.press(k / 3, k % 3);
+    keypadChip.release(k / 3, k % 3);
+  }
+}
+
+static bool inOrder(const uint8_t *events, uint8_t count) {
+  if (count != 10)
+    return false;
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t k = i / 2;
+    uint8_t key = (k / 3) * 10 + (k % 3) + 1;
+    if (events[i] != ((i & 1) ? key : (0x80 | key)))
+      return false;
+  }
+  return true;
+}
+
+static void keyEvents(Adafruit_TCA8418 &keypad) {
+  uint8_t events[16], count = 0;
+
+  pressKeys();
+  Traffic from = traffic();
+  while (keypad.available() && (count < sizeof(events)))
+    events[count++] = keypad.getEvent();
+  report("10 key events, available()/getEvent()", from, inOrder(events, count));
+
+  pressKeys();
+  from = traffic();
+  keypad.drain();
+  count = 0;
+  TCA8418_event e;
+  while (keypad.readEvent(&e) && (count < sizeof(events)))
+    events[count++] = e.event;
+  report("10 key events, drain()", from, inOrder(events, count));
+
+  // 16 events, more than the chip holds, drained as they come in
+  for (uint8_t k = 0; k < 8; k++) {
+    keypadChip.press(k / 3, k % 3);
+    keypadChip.release(k / 3, k % 3);
+    if (k == 4)
+      keypad.drain();
+  }
+  from = traffic();
+  keypad.drain();
+  bool full = keypad.eventsQueued() == TCA8418_EVENT_QUEUE;
+  for (count = 0; keypad.readEvent(&e); count++)
+    full = full && e.event == ((count & 1) ? 0 : 0x80) +
+                                  (count / 2 / 3) * 10 + (count / 2) % 3 + 1;
+  report("16 key events, two drain()s", from, full && count == 16);
+
+  // 100 passes of loop() with no key pressed
+  from = traffic();
+  for (uint8_t i = 0; i < 100; i++)
+    keypad.available();
+  report("100 idle polls, available()", from, true);
+
+  keypad.enableInterrupts();
+  keypad.drain(); // Picks up anything left from before interrupts
+  from = traffic();
+  for (uint8_t i = 0; i < 100; i++) {
+    if (keypadChip.interrupt())
+      keypad.handleInterrupt();
+    keypad.drain();
+  }
+  report("100 idle polls, interrupt + drain()", from, !keypad.eventsQueued());
+  keypad.disableInterrupts();
+}
+
+/* Gestures: the KeypadGestures the menu uses, fed from the keypad */
+static const char keymap[] = "123456789*0#";
+
+// Raw TCA8418 event of a keymap key (3 columns)
+static uint8_t raw(char key, bool down) {
+  uint8_t pos = strchr(keymap, key) - keymap;
+  return (down ? 0x80 : 0) | ((pos / 3) * 10 + pos % 3 + 1);
+}
+
+static void pressChip(char key) {
+  uint8_t pos = strchr(keymap, key) - keymap;
+  keypadChip.press(pos / 3, pos % 3);
+}
+
+static void releaseChip(char key) {
+  uint8_t pos = strchr(keymap, key) - keymap;
+  keypadChip.release(pos / 3, pos % 3);
+}
+
+// drain() the keypad and feed every event to the gestures
+static void feedDrained(Adafruit_TCA8418 &keypad, KeypadGestures &g) {
+  keypad.drain();
+  TCA8418_event e;
+  while (keypad.readEvent(&e))
+    g.feed(e.event, e.time);
+}
+
+// Takes every waiting gesture into out; returns how many
+static uint8_t gestureList(KeypadGestures &g, Gesture *out, uint8_t max) {
+  uint8_t n = 0;
+  Gesture gesture;
+  while (g.next(gesture))
+    if (n < max)
+      out[n++] = gesture;
+  return n;
+}
+
+static void gestures(Adafruit_TCA8418 &keypad) {
+  KeypadGestures g(keymap, 3);
+  g.setKeyFlags("2468", KEY_REPEATS);
+  g.setKeyFlags("*#", KEY_LONG_PRESS);
+  g.addSequence("*#*", 1);
+  g.addChord('1', '3', 2);
+  Gesture out[40];
+
+  // "*#*" typed on the keypad
+  for (char key : {'*', '#', '*'}) {
+    pressChip(key);
+    releaseChip(key);
+  }
+  Traffic from = traffic();
+  feedDrained(keypad, g);
+  uint8_t n = gestureList(g, out, 40);
+  report("gestures: *#* sequence", from,
+         n == 7 && out[5].type == GESTURE_SEQUENCE && out[5].id == 1 &&
+             out[5].key == '*' && out[6].type == GESTURE_RELEASE);
+
+  // '2' held 2 s: repeats from 500 ms, each 1/4 sooner, down to 40 ms
+  static const uint32_t due[] = {1500, 1700, 1850, 1963, 2048,
+                                 2112, 2160, 2200, 2240};
+  from = traffic();
+  g.feed(raw('2', true), 1000);
+  for (uint32_t t = 1000; t <= 3000; t++)
+    g.update(t);
+  g.feed(raw('2', false), 3000);
+  g.update(4000);
+  n = gestureList(g, out, 40);
+  bool ok = n == 2 + 9 + (3000 - 2240) / 40 &&
+            out[0].type == GESTURE_PRESS && out[n - 1].type == GESTURE_RELEASE;
+  for (uint8_t i = 1; ok && (i < n - 1); i++) {
+    ok = out[i].type == GESTURE_REPEAT && out[i].id == i &&
+         out[i].time == (i <= 9 ? due[i - 1] : 2240 + 40 * (i - 9));
+  }
+  // '*' held: one long press at 800 ms, no repeats
+  g.feed(raw('*', true), 5000);
+  g.update(5799);
+  ok = ok && gestureList(g, out, 40) == 1 && out[0].type == GESTURE_PRESS;
+  for (uint32_t t = 5800; t < 7000; t += 10)
+    g.update(t);
+  g.feed(raw('*', false), 7000);
+  n = gestureList(g, out, 40);
+  ok = ok && n == 2 && out[0].type == GESTURE_LONG_PRESS && out[0].time == 5800;
+  report("gestures: repeat acceleration, long press", from, ok);
+
+  // '1' then '3' held together; a chord stops '1' long-pressing/repeating
+  g.setKeyFlags("1", KEY_REPEATS);
+  from = traffic();
+  g.feed(raw('1', true), 10000);
+  g.feed(raw('3', true), 10050);
+  for (uint32_t t = 10050; t < 12000; t += 10)
+    g.update(t);
+  g.feed(raw('3', false), 12000);
+  g.feed(raw('1', false), 12010);
+  n = gestureList(g, out, 40);
+  report("gestures: chord", from,
+         n == 5 && out[2].type == GESTURE_CHORD && out[2].id == 2 &&
+             out[2].key == '3' && out[3].type == GESTURE_RELEASE &&
+             out[4].type == GESTURE_RELEASE);
+
+  // A full keypad queue, 16 events in two drain()s, fed before any next()
+  const char burst[] = "12345670";
+  from = traffic();
+  for (uint8_t i = 0; burst[i]; i++) {
+    pressChip(burst[i]);
+    releaseChip(burst[i]);
+    if (i == 4)
+      keypad.drain(); // The chip only holds 10
+  }
+  feedDrained(keypad, g);
+  n = gestureList(g, out, 40);
+  ok = n == 16 && !g.dropped();
+  for (uint8_t i = 0; ok && (i < n); i++) {
+    ok = out[i].key == burst[i / 2] &&
+         out[i].type == ((i & 1) ? GESTURE_RELEASE : GESTURE_PRESS);
+  }
+  report("gestures: 16 drained events", from, ok);
+}
+
+static void keypad(void) {
+  Wire.attach(keypadChip);
+  Adafruit_TCA8418 keypad;
+
+  Traffic from = traffic();
+  bool ok = keypad.begin(TCA8418_DEFAULT_ADDR, &Wire) && keypad.matrix(4, 3);
+  report("keypad begin() + matrix(4, 3)", from, ok);
+
+  gpioToggles(keypad, "64 GPIO writes");
+  keypad.enableShadow();
+  gpioToggles(keypad, "64 GPIO writes, register shadow");
+  keypad.enableShadow(false);
+
+  keyEvents(keypad);
+  gestures(keypad);
+}
+
+// Reads longer than the Wire buffer, split into pieces by the transaction
+static void longReads(void) {
+  static HostRegisterDevice eeprom(0x50);
+  Wire.attach(eeprom);
+  for (uint16_t r = 0; r < 256; r++)
+    eeprom.regs[r] = r * 13 + 7;
+
+  Adafruit_I2CDevice dev(0x50, &Wire);
+  uint8_t buf[255];
+  bool ok = dev.begin();
+  for (uint8_t len : {200, 240, 255}) {
+    char name[48];
+    snprintf(name, sizeof(name), "%u register read in one transaction", len);
+    memset(buf, 0, sizeof(buf));
+    Traffic from = traffic();
+    Adafruit_I2CTransaction txn(&dev);
+    bool done = ok && txn.readRegisters(0, buf, len) && txn.execute();
+    report(name, from, done && !memcmp(buf, eeprom.regs, len));
+  }
+}
+
+int main(void) {
+  panel.attach(Wire);
+  spiPanel.attach(SPI, SPI_CS, SPI_DC);
+
+  printf("%-40s %6s %7s %10s  %s\n", "case", "txns", "bytes", "bus us",
+         "check");
+  fullFrames();
+  partialFrames();
+  asyncFrames();
+  governor();
+  keypad();
+  longReads();
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+// Equivalence check for the drawing fast paths, run on a PC.
+//
+// Adafruit_GrayOLED and GFXcanvas1 replace Adafruit_GFX primitives with
+// loops that resolve the rotation once and work a byte at a time. Each
+// case draws the same random shapes, in every rotation and color, once
+// through the fast path and once through Adafruit_GFX's own pixel by pixel
+// version on a second buffer, and stops at the first draw that leaves the
+// two buffers different. For the display the dirty tracking is checked as
+// well: display() after every batch must leave the panel model
+// (HostPanel) equal to the frame buffer.
+//
+// Usage: gfxbench [-n draws] [-s seed]   (draws per case, default 200000)
+
+#include <Adafruit_SH110X.h>
+#include <Fonts/FreeSansBold12pt7b.h>
+#include <Fonts/TomThumb.h>
+#include <unistd.h>
+
+#include "HostPanel.h"
+
+#define BATCH 64 ///< Draws between display() calls, rotation changes
+
+/// xorshift32, so a failing draw can be replayed from its seed
+struct Rng {
+  uint32_t s;
+
+  uint32_t next(void) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+  }
+  /// In [lo, hi)
+  int16_t range(int16_t lo, int16_t hi) { return lo + next() % (hi - lo); }
+};
+
+/// Draws one random shape on d, through Adafruit_GFX if generic
+typedef void (*Draw)(Adafruit_GFX &d, bool generic, Rng &r);
+
+/// Display with drawMonoBitmap() reachable, which the public drawBitmap()
+/// and drawXBitmap() variants only call with some of the flags
+class BenchDisplay : public Adafruit_SH1106G {
+public:
+  using Adafruit_SH1106G::Adafruit_SH1106G;
+
+  void monoBitmap(bool generic, int16_t x, int16_t y, const uint8_t *bitmap,
+                  int16_t w, int16_t h, uint16_t color, uint16_t bg,
+                  uint8_t flags) {
+    if (generic)
+      Adafruit_GFX::drawMonoBitmap(x, y, bitmap, w, h, color, bg, flags);
+    else
+      drawMonoBitmap(x, y, bitmap, w, h, color, bg, flags);
+  }
+};
+
+static HostPanel panel(128, 64, 2); // SH1106G RAM starts 2 columns early
+static BenchDisplay fast(128, 64, &Wire), reference(128, 64, &Wire);
+static GFXcanvas1 canvas(128, 64), canvasReference(128, 64);
+
+static uint32_t draws = 200000, seed = 1;
+static int failures = 0;
+
+static void report(const char *name, uint32_t done, long bad, bool stale) {
+  char first[16] = "-";
+  if (bad >= 0)
+    snprintf(first, sizeof(first), "%ld", bad);
+  bool ok = (bad < 0) && !stale;
+  printf("%-36s %8u %10s  %s%s\n", name, done, first, ok ? "ok" : "FAIL",
+         stale ? " (panel out of date)" : "");
+  failures += !ok;
+}
+
+// Random rectangles over the whole screen, so black and inverse draws
+// have something to clear and flip
+static void scramble(Adafruit_GFX &d, Rng &r) {
+  d.fillScreen(r.next() & 1);
+  for (uint8_t i = 0; i < 12; i++) {
+    d.fillRect(r.range(-8, d.width()), r.range(-8, d.height()),
+               r.range(1, 64), r.range(1, 48), r.next() % 3);
+  }
+}
+
+/* Lines, clipped at every edge; horizontal and vertical ones included */
+static void line(Adafruit_GFX &d, bool generic, Rng &r) {
+  int16_t x0 = r.range(-32, d.width() + 32), y0 = r.range(-32, d.height() + 32);
+  int16_t x1, y1;
+  switch (r.next() % 4) {
+  case 0:
+    x1 = x0, y1 = r.range(-32, d.height() + 32);
+    break;
+  case 1:
+    x1 = r.range(-32, d.width() + 32), y1 = y0;
+    break;
+  default:
+    x1 = r.range(-32, d.width() + 32), y1 = r.range(-32, d.height() + 32);
+    break;
+  }
+  uint16_t color = r.next() % 3; // a canvas draws inverse as white
+  if (generic)
+    d.Adafruit_GFX::writeLine(x0, y0, x1, y1, color);
+  else
+    d.writeLine(x0, y0, x1, y1, color);
+}
+
+/* Bitmaps with every flag, from 1x1 to 40x40, clipped at every edge */
+static void bitmap(Adafruit_GFX &d, bool generic, Rng &r) {
+  static uint8_t bits[5 * 40];
+  int16_t w = r.range(1, 41), h = r.range(1, 41);
+  for (int16_t i = 0; i < (w + 7) / 8 * h; i++)
+    bits[i] = r.next();
+  int16_t x = r.range(-w, d.width() + 1), y = r.range(-h, d.height() + 1);
+  uint16_t color = r.next() % 3, bg = r.next() % 3;
+  uint8_t flags = r.next() & (GFX_BITMAP_PROGMEM | GFX_BITMAP_XBM |
+                              GFX_BITMAP_OPAQUE);
+  ((BenchDisplay &)d).monoBitmap(generic, x, y, bits, w, h, color, bg, flags);
+}
+
+/* Page-format icons, transparent or black on white and white on black */
+static void icon(Adafruit_GFX &d, bool generic, Rng &r) {
+  static uint8_t bits[5 * 40];
+  GrayOLED_icon icon = {bits, (uint8_t)r.range(1, 41), (uint8_t)r.range(1, 41)};
+  for (int16_t i = 0; i < (icon.height + 7) / 8 * icon.width; i++)
+    bits[i] = r.next();
+  int16_t x = r.range(-icon.width, d.width() + 1);
+  int16_t y = r.range(-icon.height, d.height() + 1);
+  uint16_t color = r.next() % 3, bg = color;
+  if (r.next() & 1) {
+    color = r.next() & 1;
+    bg = !color;
+  }
+  if (!generic) {
+    ((BenchDisplay &)d).drawIcon(x, y, &icon, color, bg);
+    return;
+  }
+  for (int16_t j = 0; j < icon.height; j++) {
+    for (int16_t i = 0; i < icon.width; i++) {
+      if (bits[(j / 8) * icon.width + i] & (1 << (j & 7)))
+        d.drawPixel(x + i, y + j, color);
+      else if (bg != color)
+        d.drawPixel(x + i, y + j, bg);
+    }
+  }
+}
+
+/* Scrolls of random areas, either way, clipped at every edge */
+static void scroll(Adafruit_GFX &d, bool generic, Rng &r) {
+  int16_t x = r.range(-16, d.width()), y = r.range(-16, d.height());
+  int16_t w = r.range(1, d.width() + 16), h = r.range(1, d.height() + 16);
+  int16_t dx = r.range(-w - 2, w + 3);
+  BenchDisplay &oled = (BenchDisplay &)d;
+  if (!generic) {
+    oled.scrollRect(x, y, w, h, dx);
+    return;
+  }
+  // clipped as scrollRect() does, then moved a pixel at a time
+  int16_t x1 = max(x, (int16_t)0), y1 = max(y, (int16_t)0);
+  int16_t x2 = min((int16_t)(x + w), d.width());
+  int16_t y2 = min((int16_t)(y + h), d.height());
+  for (int16_t j = y1; j < y2; j++) {
+    for (int16_t k = 0; k < x2 - x1; k++) {
+      int16_t i = (dx > 0) ? (x1 + k) : (x2 - 1 - k);
+      int16_t from = i + dx;
+      bool on = (from >= x1) && (from < x2) && oled.getPixel(from, j);
+      d.drawPixel(i, j, on ? SH110X_WHITE : SH110X_BLACK);
+    }
+  }
+}
+
+/* Characters through the glyph cache in every font, size and color, with
+   cp437() switched back and forth */
+static void glyph(Adafruit_GFX &d, bool generic, Rng &r) {
+  static const GFXfont *fonts[] = {NULL, &TomThumb, &FreeSansBold12pt7b};
+  const GFXfont *font = fonts[r.next() % 3];
+  d.setFont(font);
+  d.cp437(r.next() & 1);
+  // often a classic code cp437() moves, so both forms meet in the cache
+  unsigned char c = (r.next() & 1) ? r.range(170, 186) : r.next();
+  if (font) // only codes the font has
+    c = font->first + c % (font->last - font->first + 1);
+  uint8_t size_x = r.range(1, 4), size_y = r.range(1, 4);
+  int16_t x = r.range(-20, d.width()), y = r.range(-20, d.height() + 20);
+  uint16_t color = r.next() % 3, bg = color;
+  if (r.next() & 1) {
+    color = r.next() & 1;
+    bg = !color;
+  }
+  if (generic)
+    d.Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+  else
+    d.drawChar(x, y, c, color, bg, size_x, size_y);
+}
+
+/* Display: fast path against Adafruit_GFX on the reference display */
+static void displayCase(const char *name, Draw draw) {
+  Rng r = {seed};
+  size_t bytes = 128 * 64 / 8;
+  long bad = -1;
+  bool stale = false;
+  uint32_t i = 0;
+  while ((i < draws) && (bad < 0)) {
+    uint8_t rotation = (i / BATCH) & 3;
+    fast.setRotation(rotation);
+    reference.setRotation(rotation);
+    scramble(fast, r);
+    memcpy(reference.getBuffer(), fast.getBuffer(), bytes);
+    fast.display(); // only the draws below are left dirty
+
+    for (uint16_t k = 0; (k < BATCH) && (i < draws); k++, i++) {
+      Rng shape = r;
+      draw(fast, false, shape);
+      shape = r;
+      draw(reference, true, shape);
+      r = shape;
+      if (memcmp(fast.getBuffer(), reference.getBuffer(), bytes)) {
+        bad = i;
+        break;
+      }
+    }
+    fast.display();
+    stale = stale || !panel.matches(fast.getBuffer());
+  }
+  report(name, i, bad, stale);
+}
+
+/* Canvas: fast path against Adafruit_GFX on the reference canvas */
+static void canvasCase(const char *name, Draw draw) {
+  Rng r = {seed};
+  size_t bytes = 128 * 64 / 8;
+  long bad = -1;
+  uint32_t i = 0;
+  while ((i < draws) && (bad < 0)) {
+    uint8_t rotation = (i / BATCH) & 3;
+    canvas.setRotation(rotation);
+    canvasReference.setRotation(rotation);
+    scramble(canvas, r);
+    memcpy(canvasReference.getBuffer(), canvas.getBuffer(), bytes);
+
+    for (uint16_t k = 0; (k < BATCH) && (i < draws); k++, i++) {
+      Rng shape = r;
+      draw(canvas, false, shape);
+      shape = r;
+      draw(canvasReference, true, shape);
+      r = shape;
+      if (memcmp(canvas.getBuffer(), canvasReference.getBuffer(), bytes)) {
+        bad = i;
+        break;
+      }
+    }
+  }
+  report(name, i, bad, false);
+}
+
+int main(int argc, char *argv[]) {
+  int opt;
+  while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+    if (opt == 'n') {
+      draws = max(atoi(optarg), 1);
+    } else if (opt == 's') {
+      seed = max(atoi(optarg), 1);
+    } else {
+      fprintf(stderr, "usage: %s [-n draws] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  panel.attach(Wire);
+  reference.begin(0x3C, true);
+  fast.begin(0x3C, true); // the panel shows this one
+
+  printf("%-36s %8s %10s  %s\n", "case", "draws", "first bad", "check");
+  displayCase("display writeLine()", line);
+  displayCase("display drawMonoBitmap()", bitmap);
+  displayCase("display drawIcon()", icon);
+  displayCase("display scrollRect()", scroll);
+  fast.enableGlyphCache();
+  displayCase("display drawChar(), glyph cache", glyph);
+  canvasCase("canvas writeLine()", line);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,374 @@
+// Render benchmark and golden-image check for Adafruit_SH110X, run on a PC.
+//
+// The real Adafruit_SH1106G driver draws into its frame buffer and sends
+// display() traffic over a host I2C bus (arduino/Wire.h) that a model of
+// the controller (HostPanel) decodes. Each scene below is a screen from the
+// weather monitor; for each one the bench reports time per frame, I2C bytes
+// and simulated bus time per frame, checks after every frame that the panel shows exactly what is
+// in the frame buffer, and compares a snapshot against golden/. With -b
+// display() only snapshots the frame and a background thread sends it, so
+// the next frame is drawn while the last one is still going out; the panel
+// is then checked at the snapshot and last frames, once the flush is done.
+//
+// Usage: hostbench [options]
+//   -n N    frames per scene (default 200, at least GOLDEN_FRAME + 1)
+//   -r R    display rotation 0..3 (default 0)
+//   -s      enable the shadow frame buffer (skip unchanged bytes)
+//   -g      enable the glyph cache
+//   -m      enable cached text metrics
+//   -b      flush in the background (enableAsyncDisplay())
+//   -u      update the golden images instead of checking them
+//   -p DIR  also save each snapshot as DIR/<scene>_r<R>.png
+//   -a      trace heap allocations per scene and print them at the end
+//   -t      time each scene's frames and display() with the loop profiler
+
+#include <Adafruit_SH110X.h>
+#include <Fonts/FreeSansBold12pt7b.h>
+#include <Fonts/TomThumb.h>
+#include <HeapTrace.h>
+#include <Icons.h>
+#include <LoopProfiler.h>
+#include <Widgets.h>
+#include <unistd.h>
+
+#include "FreeSans18pt7bRLE.h"
+#include "HostPanel.h"
+#include "splash.h"
+
+#define GOLDEN_FRAME 100 ///< Frame of each scene that is snapshotted
+
+Menu *current_menu = NULL; // Used by Menu.cpp
+
+static Adafruit_SH1106G display(128, 64, &Wire);
+
+/// One screen of the application, drawn frame by frame
+typedef struct {
+  const char *name;
+  void (*setup)(void);
+  void (*frame)(uint16_t n);
+} Scene;
+
+// Slowly varying, deterministic sensor readings
+static float temperature(uint16_t n) { return 21.0 + 3.0 * sin(n / 20.0); }
+static float humidity(uint16_t n) { return 40 + (n / 7) % 15; }
+
+/* Menu: the menu list, scrolling and switching to a submenu */
+static Menu mainMenu, settingsMenu;
+static MenuList menuList(0, 0, 128, 64, &current_menu);
+static WidgetScreen menuScreen;
+
+static void menuSetup(void) {
+  mainMenu.title = "Main menu";
+  mainMenu.choices = {"Start", "Settings", "Test", "Shutdown"};
+  settingsMenu.title = "Settings";
+  settingsMenu.choices = {"Temperature", "Humidity", "Measurement Interval",
+                          "Sleep Mode", "Exit"};
+  setParentMenu(&mainMenu, settingsMenu);
+  mainMenu.currentSelection = settingsMenu.currentSelection = 0;
+  current_menu = &mainMenu;
+  menuScreen.add(menuList);
+}
+
+static void menuFrame(uint16_t n) {
+  if (n % 10 == 9) {
+    current_menu = (current_menu == &mainMenu) ? &settingsMenu : &mainMenu;
+  } else {
+    scrollDown(*current_menu);
+  }
+  menuScreen.refresh(display);
+}
+
+/* Readings: retained labels and values, one message line */
+static float temp, humid;
+static Label tempLabel(0, 0, 48, 8, "Temp"), humidLabel(0, 12, 48, 8, "Humid");
+static Label windowLabel(0, 24, 48, 8, "Window");
+static ValueField tempValue(60, 0, 60, 8, &temp, 1, " C");
+static ValueField humidValue(60, 12, 60, 8, &humid, 0, " %");
+static Label windowState(60, 24, 60, 8), message(0, 56, 128, 8);
+static WidgetScreen readingsScreen;
+
+static void readingsSetup(void) {
+  Widget *w[] = {&tempLabel, &humidLabel, &windowLabel, &tempValue,
+                 &humidValue, &windowState, &message};
+  for (Widget *widget : w)
+    readingsScreen.add(*widget);
+}
+
+static void readingsFrame(uint16_t n) {
+  temp = temperature(n);
+  humid = humidity(n);
+  windowState.setText((n / 50) % 2 ? "Closed" : "Open");
+  message.setText(n < 30 ? "Connecting..." : "Rain sensor dry");
+  readingsScreen.refresh(display);
+}
+
+/* The same readings redrawn from scratch every frame, for comparison */
+static void immediateFrame(uint16_t n) {
+  display.clearDisplay();
+  display.setTextColor(SH110X_WHITE);
+  display.setCursor(0, 0);
+  display.print("Temp");
+  display.setCursor(60, 0);
+  display.print(String(temperature(n), 1) + " C");
+  display.setCursor(0, 12);
+  display.print("Humid");
+  display.setCursor(60, 12);
+  display.print(String(humidity(n), 0) + " %");
+  display.setCursor(0, 24);
+  display.print("Window");
+  display.setCursor(60, 24);
+  display.print((n / 50) % 2 ? "Closed" : "Open");
+  display.setCursor(0, 56);
+  display.print(n < 30 ? "Connecting..." : "Rain sensor dry");
+  display.display();
+}
+
+/* Graph: a scrolling temperature chart under the current value */
+static StripChart chart(0, 16, 128, 48, 17, 25);
+static ValueField graphValue(36, 0, 60, 8, &temp, 1, " C");
+static Label graphLabel(0, 0, 30, 8, "Temp");
+static WidgetScreen graphScreen;
+
+static void graphSetup(void) {
+  graphScreen.add(graphLabel);
+  graphScreen.add(graphValue);
+  graphScreen.add(chart);
+}
+
+static void graphFrame(uint16_t n) {
+  temp = temperature(n) + ((n * 7919) % 13) / 10.0; // Some sensor noise
+  chart.push(temp);
+  graphScreen.refresh(display);
+}
+
+/* Alarm: large flashing banner with a running clock below */
+static void alarmSetup(void) {}
+
+static void alarmFrame(uint16_t n) {
+  bool on = (n / 5) % 2;
+  if ((n % 5) == 0) { // Banner only changes every 5 frames
+    int16_t x1, y1;
+    uint16_t w, h;
+    display.setFont(&FreeSansBold12pt7b);
+    display.setTextSize(1);
+    display.getTextBounds("ALARM", 0, 0, &x1, &y1, &w, &h);
+    display.fillRect(0, 0, 128, 40, on ? SH110X_WHITE : SH110X_BLACK);
+    display.setTextColor(on ? SH110X_BLACK : SH110X_WHITE);
+    display.setCursor((128 - w) / 2 - x1, (40 - h) / 2 - y1);
+    display.print("ALARM");
+    display.setFont(NULL);
+  }
+  char clock[12];
+  snprintf(clock, sizeof(clock), "12:%02u:%02u", (n / 60) % 60, n % 60);
+  display.setTextColor(SH110X_WHITE, SH110X_BLACK);
+  display.setTextSize(2);
+  display.setCursor(16, 46);
+  display.print(clock);
+  display.setTextSize(1);
+  display.display();
+}
+
+/* Large: the temperature in a big run-length encoded font, right-aligned */
+static void largeFrame(uint16_t n) {
+  char value[8];
+  int16_t x1, y1;
+  uint16_t w, h;
+  snprintf(value, sizeof(value), "%.1f", temperature(n));
+  display.fillRect(0, 0, 128, 64, SH110X_BLACK);
+  display.setTextColor(SH110X_WHITE);
+  display.setTextSize(1);
+  display.setFont(&TomThumb);
+  display.setCursor(0, 6);
+  display.print("OUTSIDE  C");
+  display.setFont(&FreeSans18pt7bRLE);
+  display.getTextBounds(value, 0, 0, &x1, &y1, &w, &h);
+  display.setCursor(124 - w - x1, 50);
+  display.print(value);
+  display.setFont(NULL);
+  display.display();
+}
+
+/* Status: icon bar redrawn every frame above the boot logo */
+static void statusSetup(void) {
+  display.drawBitmap((128 - splash2_width) / 2, 20, splash2_data,
+                     splash2_width, splash2_height, SH110X_WHITE);
+}
+
+static void statusFrame(uint16_t n) {
+  display.fillRect(0, 0, 128, 12, SH110X_BLACK);
+  if ((n >= 30) || (n % 4 < 2)) // Blinks while connecting
+    display.drawIcon(0, 0, &wifiIcon, SH110X_WHITE);
+  if ((n / 40) % 2)
+    display.drawIcon(20, 0, &rainIcon, SH110X_WHITE);
+  display.drawIcon(40, 0, (n / 50) % 2 ? &windowClosedIcon : &windowOpenIcon,
+                   SH110X_WHITE);
+  if ((n / 5) % 2)
+    display.drawIcon(116, 0, &alarmIcon, SH110X_WHITE, SH110X_BLACK);
+  display.display();
+}
+
+static const Scene scenes[] = {
+    {"menu", menuSetup, menuFrame},
+    {"readings", readingsSetup, readingsFrame},
+    {"immediate", alarmSetup, immediateFrame},
+    {"graph", graphSetup, graphFrame},
+    {"alarm", alarmSetup, alarmFrame},
+    {"large", alarmSetup, largeFrame},
+    {"status", statusSetup, statusFrame},
+};
+
+int main(int argc, char *argv[]) {
+  uint16_t frames = 200;
+  uint8_t rotation = 0;
+  bool shadow = false, glyphs = false, metrics = false, update = false;
+  bool async = false;
+  bool allocs = false, profile = false;
+  const char *png_dir = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:r:sgmbup:at")) != -1) {
+    switch (opt) {
+    case 'n':
+      frames = max(atoi(optarg), GOLDEN_FRAME + 1);
+      break;
+    case 'r':
+      rotation = atoi(optarg) & 3;
+      break;
+    case 's':
+      shadow = true;
+      break;
+    case 'g':
+      glyphs = true;
+      break;
+    case 'm':
+      metrics = true;
+      break;
+    case 'b':
+      async = true;
+      break;
+    case 'u':
+      update = true;
+      break;
+    case 'p':
+      png_dir = optarg;
+      break;
+    case 'a':
+      allocs = true;
+      break;
+    case 't':
+      profile = true;
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-n frames] [-r rotation] [-s] [-g] [-m] "
+                      "[-b] [-u] [-p png_dir] [-a] [-t]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  HostPanel panel(128, 64, 2); // SH1106G RAM starts 2 columns early
+  panel.attach(Wire);
+  if (!display.begin(0x3C, true)) {
+    fprintf(stderr, "display.begin() failed\n");
+    return 1;
+  }
+  display.setRotation(rotation);
+  if (shadow)
+    display.enableShadowBuffer();
+  if (glyphs)
+    display.enableGlyphCache();
+  if (metrics)
+    display.enableTextMetrics();
+  if (async && !display.enableAsyncDisplay()) {
+    fprintf(stderr, "display.enableAsyncDisplay() failed\n");
+    return 1;
+  }
+
+  printf("%-10s %8s %10s %10s %8s  %s\n", "scene", "frames", "us/frame",
+         "bytes/frm", "bus ms", "golden");
+  int failures = 0;
+  if (allocs)
+    heapTrace.begin();
+  if (profile)
+    loopProfiler.begin();
+
+  for (const Scene &scene : scenes) {
+    HEAP_TRACE_SCOPE(scene.name);
+    display.clearDisplay();
+    display.display();
+    scene.setup();
+    display.waitForDisplay(); // Bus counters start after the cleared screen
+
+    uint32_t bytes = Wire.bytes;
+    double busy_us = Wire.busy_us;
+    unsigned long elapsed = 0;
+    int diverged = -1;
+    char golden[64] = "";
+
+    uint8_t phase = loopProfiler.phase(scene.name);
+    for (uint16_t n = 0; n < frames; n++) {
+      unsigned long t = micros();
+      {
+        LoopProfileScope timer(phase);
+        scene.frame(n);
+      }
+      elapsed += micros() - t;
+
+      if (async) {
+        if ((n != GOLDEN_FRAME) && (n != frames - 1))
+          continue; // Next frame is drawn while this one is sent
+        display.waitForDisplay();
+      }
+      if ((diverged < 0) && !panel.matches(display.getBuffer()))
+        diverged = n; // Partial refresh left the panel out of date
+      if (n == GOLDEN_FRAME) {
+        char path[64];
+        snprintf(path, sizeof(path), "golden/%s_r%u.pbm", scene.name,
+                 rotation);
+        if (update) {
+          snprintf(golden, sizeof(golden), panel.savePBM(path) ? "written"
+                                                               : "WRITE FAILED");
+        } else {
+          int diff = panel.comparePBM(path);
+          if (diff < 0)
+            snprintf(golden, sizeof(golden), "missing");
+          else if (diff)
+            snprintf(golden, sizeof(golden), "FAIL (%d pixels)", diff);
+          else
+            snprintf(golden, sizeof(golden), "ok");
+          failures += (diff != 0);
+        }
+        if (png_dir) {
+          snprintf(path, sizeof(path), "%s/%s_r%u.png", png_dir, scene.name,
+                   rotation);
+          panel.savePNG(path);
+        }
+      }
+    }
+
+    bytes = Wire.bytes - bytes;
+    // As timed by the bus simulator, at the clock the driver set
+    float bus_ms = (Wire.busy_us - busy_us) / 1000.0 / frames;
+    printf("%-10s %8u %10.2f %10.1f %8.2f  %s\n", scene.name, frames,
+           (float)elapsed / frames, (float)bytes / frames, bus_ms, golden);
+    if (diverged >= 0) {
+      printf("%-10s panel differs from frame buffer after frame %d\n", "",
+             diverged);
+      failures++;
+    }
+  }
+
+  Serial.echo = true;
+  if (allocs) {
+    heapTrace.end();
+    heapTrace.dump(Serial);
+  }
+  if (profile) {
+    loopProfiler.end();
+    loopProfiler.report(Serial);
+    char line[LOOP_PROFILE_SUMMARY];
+    loopProfiler.summary(line, sizeof(line));
+    Serial.println(line);
+  }
+  return failures ? 1 : 0;
+}
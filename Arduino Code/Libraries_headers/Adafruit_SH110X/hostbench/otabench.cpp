@@ -0,0 +1,175 @@
+// Firmware update test for OtaUpdate (Custom_Menu_Mosiah), run on a PC.
+//
+// A HostOtaServer streams a signed image to an OtaUpdate writing into a
+// HostFlash file, while a stand-in loop() keeps running between update()
+// calls. Each case checks that a good image is set to boot and matches
+// byte for byte, and that a damaged, wrongly signed, old, oversized or
+// abandoned one never is. It reports the download rate, how many loop()
+// passes ran during it and the longest single pass, which the throttle
+// keeps to one flash write.
+//
+// Usage: otabench [-s KB] [-i ms] [-f slot file]
+//        (image size, default 64; throttle, default 2; /tmp/otabench.bin)
+
+#include "HostOta.h"
+#include <unistd.h>
+
+static uint32_t image_kb = 64;
+static uint16_t throttle = 2;
+static const char *slot_path = "/tmp/otabench.bin";
+static int failures = 0;
+
+static const char key[] = "otabench secret";
+#define RUNNING_VERSION 6 ///< Firmware the device runs; images must be newer
+static HostOtaServer *server = NULL;
+
+// OtaSend for the device: frames go to the server's inbox
+static bool toServer(const uint8_t *frame, size_t len) {
+  server->receive(frame, len);
+  return true;
+}
+
+static const char *errorName(uint8_t error) {
+  static const char *names[] = {"ok",       "size",      "flash",   "sequence",
+                                "length",   "signature", "timeout", "aborted",
+                                "version"};
+  return error < sizeof(names) / sizeof(names[0]) ? names[error] : "?";
+}
+
+struct Case {
+  const char *name;
+  OtaError expect;       // What the device should end with
+  uint16_t interval;     // Throttle
+  const char *key;       // Server's signing key
+  uint32_t slot;         // Slot size, 0 for plenty
+  uint32_t version;      // Image version sent in 'B'
+  uint32_t signed_version; // Version in the signature
+  uint32_t corrupt_at, repeat_at, lose_ack_at, abort_at;
+};
+
+static void run(const Case &c, const std::vector<uint8_t> &image) {
+  HostFlash flash(slot_path, c.slot ? c.slot : image.size() * 2);
+  HostOtaVerifier verifier((const uint8_t *)key, strlen(key));
+  OtaUpdate ota(flash, verifier);
+  HostOtaServer host(image, c.version, (const uint8_t *)c.key, strlen(c.key));
+  host.signed_version = c.signed_version;
+  host.corrupt_at = c.corrupt_at;
+  host.repeat_at = c.repeat_at;
+  host.lose_ack_at = c.lose_ack_at;
+  host.abort_at = c.abort_at;
+  server = &host;
+  ota.begin(RUNNING_VERSION, toServer);
+  ota.setThrottle(c.interval);
+
+  uint32_t passes = 0, longest = 0;
+  uint32_t start = micros();
+  host.start(ota);
+  while (!host.finished() && micros() - start < 20000000) {
+    uint32_t t = micros();
+    host.poll();  // The network: frames arrive
+    ota.update(); // At most one flash write
+    passes++;     // Sensing, control, display would run here
+    longest = max(longest, (uint32_t)(micros() - t));
+  }
+  double s = (micros() - start) / 1e6;
+
+  bool good = c.expect == OTA_OK;
+  bool ok = host.finished() && host.accepted() == good &&
+            (good ? ota.state() == OTA_DONE : ota.state() == OTA_FAILED) &&
+            host.error() == c.expect && ota.error() == c.expect &&
+            flash.activated == good && (!good || flash.contains(image));
+
+  printf("%-30s %8.0f %8lu %8lu %6lu  %-9s %s\n", c.name,
+         s > 0 ? ota.written() / 1024.0 / s : 0.0, (unsigned long)passes,
+         (unsigned long)longest, (unsigned long)host.chunks,
+         errorName(ota.error()), ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+// Known answers: FIPS 180-2 "abc", RFC 4231 test case 2, and a message
+// hashed in odd pieces against the same in one go
+static void basics(void) {
+  static const uint8_t abc[SHA256_SIZE] = {
+      0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+      0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+      0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+  static const uint8_t jefe[SHA256_SIZE] = {
+      0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24,
+      0x26, 0x08, 0x95, 0x75, 0xc7, 0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27,
+      0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+  uint8_t digest[SHA256_SIZE], pieces[SHA256_SIZE];
+  Sha256 sha;
+
+  sha.begin();
+  sha.update("abc", 3);
+  sha.finish(digest);
+  bool ok = !memcmp(digest, abc, SHA256_SIZE);
+
+  const char *what = "what do ya want for nothing?";
+  Sha256::hmac((const uint8_t *)"Jefe", 4, what, strlen(what), digest);
+  ok = ok && !memcmp(digest, jefe, SHA256_SIZE);
+
+  uint8_t message[1000];
+  for (uint16_t i = 0; i < sizeof(message); i++)
+    message[i] = i * 7;
+  sha.begin();
+  sha.update(message, sizeof(message));
+  sha.finish(digest);
+  sha.begin();
+  for (uint16_t i = 0, n = 1; i < sizeof(message); i += n, n = n * 3 % 97)
+    sha.update(message + i, min((uint16_t)(sizeof(message) - i), n));
+  sha.finish(pieces);
+  ok = ok && !memcmp(digest, pieces, SHA256_SIZE);
+
+  printf("%-30s %8s %8s %8s %6s  %-9s %s\n", "sha-256 / hmac", "", "", "", "",
+         "", ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+int main(int argc, char *argv[]) {
+  int opt;
+  while ((opt = getopt(argc, argv, "s:i:f:")) != -1) {
+    if (opt == 's') {
+      image_kb = max(atoi(optarg), 16);
+    } else if (opt == 'i') {
+      throttle = max(atoi(optarg), 0);
+    } else if (opt == 'f') {
+      slot_path = optarg;
+    } else {
+      fprintf(stderr, "usage: %s [-s KB] [-i ms] [-f slot file]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Odd length, so the last chunk is a short one
+  std::vector<uint8_t> image(image_kb * 1024 + 123);
+  uint32_t x = 12345;
+  for (auto &b : image) {
+    x = x * 1103515245 + 12345;
+    b = x >> 16;
+  }
+
+  const uint32_t none = UINT32_MAX, third = image.size() / 3 / OTA_CHUNK * OTA_CHUNK;
+  const uint32_t v = RUNNING_VERSION + 1; // A newer image
+  const Case cases[] = {
+      {"signed image", OTA_OK, throttle, key, 0, v, v, none, none, none, none},
+      {"signed image, unthrottled", OTA_OK, 0, key, 0, v, v, none, none, none, none},
+      {"chunk sent twice", OTA_OK, throttle, key, 0, v, v, none, third, none, none},
+      {"acknowledgement lost", OTA_OK, throttle, key, 0, v, v, none, none, third, none},
+      {"chunk corrupted", OTA_ERR_SIGNATURE, throttle, key, 0, v, v, third, none, none, none},
+      {"wrong key", OTA_ERR_SIGNATURE, throttle, "not the key", 0, v, v, none, none, none, none},
+      {"version not the one signed", OTA_ERR_SIGNATURE, throttle, key, 0, v + 1, v, none, none, none, none},
+      {"same version again", OTA_ERR_VERSION, throttle, key, 0, v - 1, v - 1, none, none, none, none},
+      {"older version", OTA_ERR_VERSION, throttle, key, 0, v - 2, v - 2, none, none, none, none},
+      {"too big for the slot", OTA_ERR_SIZE, throttle, key, 16 * 1024, v, v, none, none, none, none},
+      {"server gives up", OTA_ERR_ABORTED, throttle, key, 0, v, v, none, none, none, third},
+  };
+
+  printf("%-30s %8s %8s %8s %6s  %-9s %s\n", "case", "KB/s", "passes",
+         "max us", "chunks", "result", "check");
+  basics();
+  for (const Case &c : cases)
+    run(c, image);
+  unlink(slot_path);
+  return failures ? 1 : 0;
+}
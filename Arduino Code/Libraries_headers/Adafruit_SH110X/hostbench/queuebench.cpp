@@ -0,0 +1,241 @@
+// Stress test and throughput benchmark for the queues in
+// Custom_Menu_Mosiah (SpscQueue, MpscQueue, IsrQueue), run on a PC.
+//
+// Producers and consumers are std::threads hammering one queue. Every item
+// carries its producer and a sequence number, so the consumer checks that
+// nothing is lost, duplicated or reordered within a producer; each case
+// reports items per second, how often a push found the queue full, and
+// the most items that were waiting at once. A last case runs CoreSplit's
+// network loop as a thread and sends events through it and back.
+//
+// Usage: queuebench [-n items]   (items per producer, default 1000000)
+
+#include <CoreSplit.h>
+#include <IsrQueue.h>
+#include <MpscQueue.h>
+#include <SpscQueue.h>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define QUEUE_SIZE 256 ///< Slots in every queue under test
+#define BATCH 16       ///< Items per batch push/pop
+
+static uint32_t items = 1000000;
+static int failures = 0;
+
+enum Mode { SINGLE, BATCHED, IN_PLACE };
+
+// Producer in the top byte, sequence number below
+static inline uint32_t tag(uint32_t producer, uint32_t n) {
+  return (producer << 24) | n;
+}
+
+template <class Q> static void produce(Q &q, uint32_t producer, Mode mode) {
+  uint32_t n = 0;
+  while (n < items) {
+    uint32_t before = n;
+    if (mode == BATCHED) {
+      uint32_t batch[BATCH];
+      uint16_t count = min((uint32_t)BATCH, items - n);
+      for (uint16_t i = 0; i < count; i++)
+        batch[i] = tag(producer, n + i);
+      n += q.push(batch, count);
+    } else if (mode == IN_PLACE) {
+      uint32_t *slot = q.reserve();
+      if (slot) {
+        *slot = tag(producer, n++);
+        q.commit(slot);
+      }
+    } else if (q.push(tag(producer, n))) {
+      n++;
+    }
+    if (n == before)
+      std::this_thread::yield(); // Full: let the consumer in
+  }
+}
+
+// Takes everything the producers send; false if anything was out of order
+template <class Q>
+static bool consume(Q &q, uint8_t producers, Mode mode) {
+  std::vector<uint32_t> next(producers, 0);
+  uint64_t total = (uint64_t)items * producers, got = 0;
+  bool ok = true;
+  auto check = [&](uint32_t v) {
+    uint32_t p = v >> 24;
+    if (p >= producers || (v & 0xFFFFFF) != next[p]) {
+      ok = false;
+    } else {
+      next[p]++;
+    }
+  };
+
+  while (got < total) {
+    uint16_t n = 0;
+    if (mode == BATCHED) {
+      uint32_t batch[BATCH];
+      n = q.pop(batch, BATCH);
+      for (uint16_t i = 0; i < n; i++)
+        check(batch[i]);
+    } else if (mode == IN_PLACE) {
+      const uint32_t *slot = q.peek();
+      if (slot) {
+        check(*slot);
+        q.release();
+        n = 1;
+      }
+    } else {
+      uint32_t v;
+      if (q.pop(v)) {
+        check(v);
+        n = 1;
+      }
+    }
+    got += n;
+    if (!n)
+      std::this_thread::yield();
+  }
+  return ok && q.empty();
+}
+
+template <class Q>
+static void run(const char *name, uint8_t producers, Mode mode) {
+  Q &q = *new Q; // Aligned to the cache line by C++17's new
+  bool ok = false;
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread consumer([&] { ok = consume(q, producers, mode); });
+  std::vector<std::thread> threads;
+  for (uint8_t p = 0; p < producers; p++)
+    threads.emplace_back([&q, p, mode] { produce(q, p, mode); });
+  for (auto &t : threads)
+    t.join();
+  consumer.join();
+  double s = std::chrono::duration<double>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+
+  printf("%-32s %8.1f %10lu %6u  %s\n", name,
+         (double)items * producers / s / 1e6, (unsigned long)q.dropped(),
+         q.highWater(), ok ? "ok" : "FAIL");
+  failures += !ok;
+  delete &q;
+}
+
+// What the queues promise without any threads
+static void basics(void) {
+  SpscQueue<uint32_t, 8> s;
+  MpscQueue<uint32_t, 8> m;
+  IsrQueue<uint32_t, 8> i;
+  uint32_t in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out[10];
+  bool ok = s.push(in, 10) == 8 && s.dropped() == 2 && s.full() &&
+            !s.push(in[0]) && s.pop(out, 10) == 8 && out[7] == 7 &&
+            s.empty() && s.highWater() == 8;
+  ok = ok && m.push(in, 10) == 8 && m.dropped() == 2 && !m.reserve() &&
+       m.pop(out, 3) == 3 && out[2] == 2 && m.push(in, 3) == 3 &&
+       m.pop(out, 10) == 8 && out[4] == 7 && out[7] == 2 && m.empty();
+  ok = ok && i.push(in, 10) == 8 && i.dropped() == 2 && !i.reserve() &&
+       i.pop(out, 10) == 8 && out[0] == 0 && i.empty() && !i.peek();
+  // One item in, one out: never more than one waiting
+  s.resetStats();
+  m.resetStats();
+  i.resetStats();
+  for (uint8_t n = 0; n < 20; n++) {
+    ok = ok && s.push(in[n % 10]) && s.pop(out[0]) && m.push(in[n % 10]) &&
+         m.pop(out[1]) && i.push(in[n % 10]) && i.pop(out[2]);
+  }
+  ok = ok && s.highWater() == 1 && m.highWater() == 1 && i.highWater() == 1;
+  printf("%-32s %8s %10s %6s  %s\n", "basics", "", "", "", ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+// CoreSplit network loop: answers each event with a command, value doubled
+static CoreSplit *cores = NULL;
+static std::atomic<uint32_t> network_passes(0);
+
+static void echo(void) {
+  CoreMessage m;
+  while (cores->receiveEvent(m))
+    cores->sendCommand(m.type + 1, m.arg, m.value * 2);
+  CoreTelemetry t;
+  while (cores->receiveTelemetry(t))
+    cores->sendCommand(0xFFFF, 0, t.temperature);
+  network_passes++;
+}
+
+// Waits up to a second for the command the network loop sends back
+static bool awaitCommand(CoreMessage &m) {
+  for (uint16_t ms = 0; ms < 1000; ms++) {
+    if (cores->receiveCommand(m))
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+// begin(), round trips from loop() to the network thread and back, end()
+static void coreSplit(void) {
+  const uint16_t trips = 200;
+  CoreSplit split;
+  cores = &split;
+  bool ok = split.split() && split.begin(echo);
+
+  for (uint16_t n = 0; ok && (n < trips); n++) {
+    CoreMessage m;
+    ok = split.sendEvent(100, n, n * 0.5f) && awaitCommand(m) &&
+         m.type == 101 && m.arg == n && m.value == n;
+  }
+  CoreTelemetry reading = {(uint32_t)millis(), 21.5f, 40, 0};
+  CoreMessage m;
+  ok = ok && split.sendTelemetry(reading) && awaitCommand(m) &&
+       m.type == 0xFFFF && m.value == 21.5f;
+
+  // Stopped: no more passes, and an event stays queued
+  split.end();
+  uint32_t passes = network_passes;
+  ok = ok && split.sendEvent(100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ok = ok && !split.receiveCommand(m) && network_passes == passes;
+  // Started again, it picks up the event left behind
+  ok = ok && split.begin(echo) && awaitCommand(m) && m.type == 101;
+  split.end();
+  ok = ok && !split.droppedCommands() && !split.droppedEvents() &&
+       !split.droppedTelemetry();
+
+  printf("%-32s %8s %10s %6s  %s\n", "coresplit round trips", "", "", "",
+         ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+int main(int argc, char *argv[]) {
+  int opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1) {
+    if (opt == 'n') {
+      items = min(max(atoi(optarg), 1), 0xFFFFFF);
+    } else {
+      fprintf(stderr, "usage: %s [-n items]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  typedef SpscQueue<uint32_t, QUEUE_SIZE> Spsc;
+  typedef MpscQueue<uint32_t, QUEUE_SIZE> Mpsc;
+  typedef IsrQueue<uint32_t, QUEUE_SIZE> Isr;
+
+  printf("%-32s %8s %10s %6s  %s\n", "case", "M/s", "full", "high",
+         "check");
+  basics();
+  run<Spsc>("spsc 1:1", 1, SINGLE);
+  run<Spsc>("spsc 1:1, batches of 16", 1, BATCHED);
+  run<Spsc>("spsc 1:1, reserve/peek", 1, IN_PLACE);
+  run<Mpsc>("mpsc 1:1", 1, SINGLE);
+  run<Mpsc>("mpsc 4:1", 4, SINGLE);
+  run<Mpsc>("mpsc 4:1, batches of 16", 4, BATCHED);
+  run<Mpsc>("mpsc 4:1, reserve/peek", 4, IN_PLACE);
+  run<Isr>("isr 1:1", 1, SINGLE);
+  run<Isr>("isr 4:1", 4, SINGLE);
+  run<Isr>("isr 4:1, batches of 16", 4, BATCHED);
+  coreSplit();
+  return failures ? 1 : 0;
+}
@@ -35,6 +35,14 @@
 #include "Arduino.h"
 
 #include "Adafruit_TCA8418.h"
+#include <Adafruit_I2CBus.h>
+
+//  keypad polls show up as the "keypad" phase when built with LOOP_PROFILE
+#ifdef LOOP_PROFILE
+#include <LoopProfiler.h>
+#else
+#define LOOP_PROFILE_SCOPE(name)
+#endif
 
 /**
  *    @brief  Instantiates a new TCA8418 class
@@ -44,7 +52,7 @@ Adafruit_TCA8418::Adafruit_TCA8418(void) {}
 /**
  *    @brief  destructor
  */
-Adafruit_TCA8418::~Adafruit_TCA8418(void) {}
+Adafruit_TCA8418::~Adafruit_TCA8418(void) { delete _shadow; }
 
 /**
  *    @brief  Sets up the hardware and initializes I2C
@@ -53,6 +61,11 @@ Adafruit_TCA8418::~Adafruit_TCA8418(void) {}
  *    @return True if initialization was successful, otherwise false.
  */
 bool Adafruit_TCA8418::begin(uint8_t address, TwoWire *wire) {
+  bool shadow = _shadow;
+  if (_shadow) {
+    delete _shadow; // refers to the old interface
+    _shadow = NULL;
+  }
   if (i2c_dev) {
     delete i2c_dev; // remove old interface
   }
@@ -63,28 +76,28 @@ bool Adafruit_TCA8418::begin(uint8_t address, TwoWire *wire) {
     return false;
   }
 
-  //  GPIO
-  //  set default all GIO pins to INPUT
-  writeRegister(TCA8418_REG_GPIO_DIR_1, 0x00);
-  writeRegister(TCA8418_REG_GPIO_DIR_2, 0x00);
-  writeRegister(TCA8418_REG_GPIO_DIR_3, 0x00);
-
-  //  add all pins to key events
-  writeRegister(TCA8418_REG_GPI_EM_1, 0xFF);
-  writeRegister(TCA8418_REG_GPI_EM_2, 0xFF);
-  writeRegister(TCA8418_REG_GPI_EM_3, 0xFF);
+  //  auto-increment, so each register bank below is a single burst
+  _auto_increment = false;
+  uint8_t cfg = readRegister(TCA8418_REG_CFG) & ~TCA8418_REG_CFG_AI;
+  writeRegister(TCA8418_REG_CFG, cfg | TCA8418_REG_CFG_AI);
 
-  //  set all pins to FALLING interrupts
-  writeRegister(TCA8418_REG_GPIO_INT_LVL_1, 0x00);
-  writeRegister(TCA8418_REG_GPIO_INT_LVL_2, 0x00);
-  writeRegister(TCA8418_REG_GPIO_INT_LVL_3, 0x00);
+  static const uint8_t gpio[] = {
+      0xFF, 0xFF, 0xFF, //  GPI_EM:      add all pins to key events
+      0x00, 0x00, 0x00, //  GPIO_DIR:    set default all GIO pins to INPUT
+      0x00, 0x00, 0x00  //  GPIO_INT_LVL: set all pins to FALLING interrupts
+  };
+  static const uint8_t int_en[] = {0xFF, 0xFF, 0xFF};
 
+  Adafruit_I2CTransaction txn(i2c_dev, _auto_increment);
+  txn.writeRegisters(TCA8418_REG_GPI_EM_1, gpio, sizeof(gpio));
   //  add all pins to interrupts
-  writeRegister(TCA8418_REG_GPIO_INT_EN_1, 0xFF);
-  writeRegister(TCA8418_REG_GPIO_INT_EN_2, 0xFF);
-  writeRegister(TCA8418_REG_GPIO_INT_EN_3, 0xFF);
-
-  return true;
+  txn.writeRegisters(TCA8418_REG_GPIO_INT_EN_1, int_en, sizeof(int_en));
+  //  and back off: the key FIFO is drained by reading KEY_EVENT_A over
+  //  and over, which needs the register address to stay put
+  txn.writeRegister(TCA8418_REG_CFG, cfg);
+  bool ok = txn.execute();
+  _auto_increment = false;
+  return ok && (!shadow || enableShadow());
 }
 
 /**
@@ -105,27 +118,25 @@ bool Adafruit_TCA8418::matrix(uint8_t rows, uint8_t columns) {
   //  skip zero size matrix
   if ((rows != 0) && (columns != 0)) {
     // setup the keypad matrix.
-    uint8_t mask = 0x00;
+    uint8_t mask[3] = {0x00, 0x00, 0x00};
     for (int r = 0; r < rows; r++) {
-      mask <<= 1;
-      mask |= 1;
+      mask[0] <<= 1;
+      mask[0] |= 1;
     }
-    writeRegister(TCA8418_REG_KP_GPIO_1, mask);
 
-    mask = 0x00;
     for (int c = 0; c < columns && c < 8; c++) {
-      mask <<= 1;
-      mask |= 1;
+      mask[1] <<= 1;
+      mask[1] |= 1;
     }
-    writeRegister(TCA8418_REG_KP_GPIO_2, mask);
 
     if (columns > 8) {
       if (columns == 9)
-        mask = 0x01;
+        mask[2] = 0x01;
       else
-        mask = 0x03;
-      writeRegister(TCA8418_REG_KP_GPIO_3, mask);
+        mask[2] = 0x03;
     }
+
+    _writeBank(TCA8418_REG_KP_GPIO_1, mask, (columns > 8) ? 3 : 2);
   }
 
   return true;
@@ -142,6 +153,7 @@ bool Adafruit_TCA8418::matrix(uint8_t rows, uint8_t columns) {
  * @return number of key events in the buffer
  */
 uint8_t Adafruit_TCA8418::available() {
+  LOOP_PROFILE_SCOPE("keypad");
   uint8_t eventCount = readRegister(TCA8418_REG_KEY_LCK_EC);
   eventCount &= 0x0F; //  lower 4 bits only
   return eventCount;
@@ -172,18 +184,123 @@ uint8_t Adafruit_TCA8418::getEvent() {
  */
 uint8_t Adafruit_TCA8418::flush() {
   //  flush key events
-  uint8_t count = 0;
-  while (getEvent() != 0)
-    count++;
+  uint8_t events[TCA8418_FIFO_SIZE];
+  uint8_t count = _readFifo(events);
   //  flush gpio events
-  readRegister(TCA8418_REG_GPIO_INT_STAT_1);
-  readRegister(TCA8418_REG_GPIO_INT_STAT_2);
-  readRegister(TCA8418_REG_GPIO_INT_STAT_3);
+  uint8_t stat[3];
+  Adafruit_I2CTransaction txn(i2c_dev, _auto_increment);
+  txn.readRegisters(TCA8418_REG_GPIO_INT_STAT_1, stat, sizeof(stat));
   //  clear INT_STAT register
-  writeRegister(TCA8418_REG_INT_STAT, 3);
+  txn.writeRegister(TCA8418_REG_INT_STAT, 3);
+  txn.execute();
   return count;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//
+//  INTERRUPT DRIVEN EVENTS
+//
+
+/**
+ * @brief tells the driver the INT pin went low. Safe to call from the
+ *        interrupt handler of that pin.
+ *
+ * @details if the keypad is on an Adafruit_I2CBus, this also asks the bus
+ *          to run its service handler (see service()) at the next chance,
+ *          even in the middle of a display flush.
+ */
+void Adafruit_TCA8418::handleInterrupt() {
+  _irq_pending = true;
+  if (i2c_dev && i2c_dev->bus()) {
+    i2c_dev->bus()->requestService();
+  }
+}
+
+/**
+ * @brief moves all key events from the chip into the event queue.
+ *
+ * @return number of events moved.
+ *
+ * @details after enableInterrupts() this does no I2C traffic at all until
+ *          handleInterrupt() is called. Then it reads the event count,
+ *          takes the whole FIFO in one burst, clears INT_STAT and queues
+ *          the events with a timestamp. Without interrupts it checks the
+ *          event count on every call.
+ *
+ *          drain() fills the queue and readEvent() empties it, so each
+ *          may run in its own task, but drain() must only be called from
+ *          one place at a time.
+ */
+uint8_t Adafruit_TCA8418::drain() {
+  LOOP_PROFILE_SCOPE("keypad");
+  if (_irq_mode && !_irq_pending) {
+    return 0;
+  }
+  _irq_pending = false;
+
+  uint8_t events[TCA8418_FIFO_SIZE];
+  uint8_t count = _readFifo(events);
+  //  clear INT_STAT; if keys came in meanwhile the chip keeps INT low
+  //  without a new edge, so look once more on the next call
+  writeRegister(TCA8418_REG_INT_STAT,
+                TCA8418_REG_STAT_K_INT | TCA8418_REG_STAT_GPI_INT |
+                    TCA8418_REG_STAT_OVR_FLOW_INT);
+  if (count) {
+    _irq_pending = true;
+  }
+
+  uint32_t now = millis();
+  uint8_t head = _queue_head;
+  for (uint8_t i = 0; i < count; i++) {
+    if ((uint8_t)(head - _queue_tail) == TCA8418_EVENT_QUEUE) {
+      break; //  queue full, the rest is lost
+    }
+    _queue[head & (TCA8418_EVENT_QUEUE - 1)].time = now;
+    _queue[head & (TCA8418_EVENT_QUEUE - 1)].event = events[i];
+    head++;
+  }
+  _queue_head = head; //  publish after the entries are written
+  return count;
+}
+
+/**
+ * @brief takes the oldest event from the event queue.
+ *
+ * @param [out] event where to store the event
+ * @return false if the queue is empty.
+ */
+bool Adafruit_TCA8418::readEvent(TCA8418_event *event) {
+  uint8_t tail = _queue_tail;
+  if (tail == _queue_head) {
+    return false;
+  }
+  *event = _queue[tail & (TCA8418_EVENT_QUEUE - 1)];
+  _queue_tail = tail + 1;
+  return true;
+}
+
+/**
+ * @brief checks how many events drain() has queued.
+ *
+ * @return number of events readEvent() can take.
+ */
+uint8_t Adafruit_TCA8418::eventsQueued() {
+  return _queue_head - _queue_tail;
+}
+
+/**
+ * @brief drain() for Adafruit_I2CBus::setServiceHandler().
+ *
+ * @details set it from the task that otherwise calls drain(); the bus
+ *          only runs it while that task holds the bus, so drain() keeps
+ *          a single caller.
+ *
+ * @param [in] keypad the Adafruit_TCA8418 to drain
+ */
+void Adafruit_TCA8418::service(void *keypad) {
+  ((Adafruit_TCA8418 *)keypad)->drain();
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 //  GPIO
@@ -312,6 +429,8 @@ bool Adafruit_TCA8418::pinIRQMode(uint8_t pinnum, uint8_t mode) {
  * @brief enables key event + GPIO interrupts.
  */
 void Adafruit_TCA8418::enableInterrupts() {
+  _irq_mode = true;
+  _irq_pending = true; //  pick up anything already waiting
   uint8_t value = readRegister(TCA8418_REG_CFG);
   value |= (TCA8418_REG_CFG_GPI_IEN | TCA8418_REG_CFG_KE_IEN);
   writeRegister(TCA8418_REG_CFG, value);
@@ -321,6 +440,7 @@ void Adafruit_TCA8418::enableInterrupts() {
  * @brief disables key events + GPIO interrupts.
  */
 void Adafruit_TCA8418::disableInterrupts() {
+  _irq_mode = false;
   uint8_t value = readRegister(TCA8418_REG_CFG);
   value &= ~(TCA8418_REG_CFG_GPI_IEN | TCA8418_REG_CFG_KE_IEN);
   writeRegister(TCA8418_REG_CFG, value);
@@ -348,18 +468,56 @@ void Adafruit_TCA8418::disableMatrixOverflow() {
  * @brief enables key debounce.
  */
 void Adafruit_TCA8418::enableDebounce() {
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_1, 0x00);
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_2, 0x00);
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_3, 0x00);
+  static const uint8_t dis[] = {0x00, 0x00, 0x00};
+  _writeBank(TCA8418_REG_DEBOUNCE_DIS_1, dis, sizeof(dis));
 }
 
 /**
  * @brief disables key debounce.
  */
 void Adafruit_TCA8418::disableDebounce() {
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_1, 0xFF);
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_2, 0xFF);
-  writeRegister(TCA8418_REG_DEBOUNCE_DIS_3, 0xFF);
+  static const uint8_t dis[] = {0xFF, 0xFF, 0xFF};
+  _writeBank(TCA8418_REG_DEBOUNCE_DIS_1, dis, sizeof(dis));
+}
+
+/**
+ * @brief keeps a copy of the configuration registers on the host.
+ *
+ * @param [in] enable true to keep the copy, false to drop it
+ * @return false if there was no memory for the copy.
+ *
+ * @details the registers only the host changes (CFG, GPIO_DAT_OUT up to
+ *          GPIO_PULL) are then read over I2C once; after that
+ *          digitalWrite(), pinMode() and the other read-modify-write calls
+ *          cost a single register write. Call sync() if the chip may have
+ *          been reset behind the driver's back.
+ */
+bool Adafruit_TCA8418::enableShadow(bool enable) {
+  delete _shadow;
+  _shadow = NULL;
+  if (!enable) {
+    return true;
+  }
+  if (!i2c_dev) {
+    return false;
+  }
+  _shadow = new Adafruit_I2CRegisterShadow(
+      i2c_dev, TCA8418_REG_CFG, TCA8418_REG_GPIO_PULL_3 - TCA8418_REG_CFG + 1);
+  if (!_shadow->begin()) {
+    delete _shadow;
+    _shadow = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief re-reads the registers held by enableShadow() from the chip.
+ *
+ * @return false if there is no copy or reading failed.
+ */
+bool Adafruit_TCA8418::sync() {
+  return _shadow && _shadow->sync(_auto_increment);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -374,12 +532,51 @@ void Adafruit_TCA8418::disableDebounce() {
  * @return value from register
  */
 uint8_t Adafruit_TCA8418::readRegister(uint8_t reg) {
-  Adafruit_I2CRegister i2cReg = Adafruit_I2CRegister(i2c_dev, reg);
   uint8_t buffer[1] = {0};
-  i2cReg.read(buffer, 1);
+  if (_shadowed(reg))
+    _shadow->read(reg, buffer);
+  else
+    i2c_dev->write_then_read(&reg, 1, buffer, 1);
   return buffer[0];
 }
 
+/**
+ * @brief reads the event count and then the whole key FIFO
+ *
+ * @param [out] events TCA8418_FIFO_SIZE bytes for the events
+ * @return number of events read.
+ */
+uint8_t Adafruit_TCA8418::_readFifo(uint8_t *events) {
+  uint8_t count = readRegister(TCA8418_REG_KEY_LCK_EC) & 0x0F;
+  if (count > TCA8418_FIFO_SIZE) {
+    count = TCA8418_FIFO_SIZE;
+  }
+  if (count) {
+    //  every byte read from KEY_EVENT_A pops the next event
+    uint8_t reg = TCA8418_REG_KEY_EVENT_A;
+    if (!i2c_dev->write_then_read(&reg, 1, events, count)) {
+      return 0;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief writes consecutive registers and keeps the shadow in step
+ *
+ * @param [in] reg first register address
+ * @param [in] data values to write
+ * @param [in] len number of registers
+ */
+void Adafruit_TCA8418::_writeBank(uint8_t reg, const uint8_t *data,
+                                  uint8_t len) {
+  Adafruit_I2CTransaction txn(i2c_dev, _auto_increment);
+  txn.writeRegisters(reg, data, len);
+  if (txn.execute() && _shadow) {
+    _shadow->store(reg, data, len);
+  }
+}
+
 /**
  * @brief write byte value to register
  *
@@ -387,6 +584,12 @@ uint8_t Adafruit_TCA8418::readRegister(uint8_t reg) {
  * @param [in] value
  */
 void Adafruit_TCA8418::writeRegister(uint8_t reg, uint8_t value) {
-  Adafruit_I2CRegister i2cReg = Adafruit_I2CRegister(i2c_dev, reg);
-  i2cReg.write(value);
+  uint8_t buffer[2] = {reg, value};
+  if (_shadowed(reg))
+    _shadow->write(reg, value);
+  else
+    i2c_dev->write(buffer, 2);
+  if (reg == TCA8418_REG_CFG) {
+    _auto_increment = value & TCA8418_REG_CFG_AI;
+  }
 }
@@ -24,6 +24,16 @@
 #include <Adafruit_TCA8418_registers.h>
 
 #define TCA8418_DEFAULT_ADDR 0x34 ///< The default I2C address for our breakout
+#define TCA8418_FIFO_SIZE 10      ///< Key events the chip itself can hold
+
+/// Key events drain() can queue for the application, a power of two up to 128
+#define TCA8418_EVENT_QUEUE 16
+
+/** A key event taken from the chip's FIFO by drain() */
+typedef struct {
+  uint32_t time; ///< millis() when it was drained
+  uint8_t event; ///< Raw key event, as returned by getEvent()
+} TCA8418_event;
 
 /** Pin IDs for matrix rows/columns */
 enum {
@@ -74,6 +84,18 @@ public:
   //  flush all events in the FIFO buffer + GPIO events
   uint8_t flush();
 
+  //  INTERRUPT DRIVEN EVENTS
+  //  call from the INT pin interrupt handler
+  void handleInterrupt();
+  //  move all events from the chip to the event queue
+  uint8_t drain();
+  //  take the oldest event from the event queue
+  bool readEvent(TCA8418_event *event);
+  //  events waiting in the event queue
+  uint8_t eventsQueued();
+  //  drain() as an Adafruit_I2CBus service handler
+  static void service(void *keypad);
+
   //  GPIO
   uint8_t digitalRead(uint8_t pinnum);
   bool digitalWrite(uint8_t pinnum, uint8_t level);
@@ -93,12 +115,36 @@ public:
   void enableDebounce();
   void disableDebounce();
 
+  //  keep a copy of the configuration registers on the host
+  bool enableShadow(bool enable = true);
+  //  re-read that copy, e.g. after a reset of the chip
+  bool sync();
+
   // for expert mode
   uint8_t readRegister(uint8_t reg);
   void writeRegister(uint8_t reg, uint8_t value);
 
 protected:
   Adafruit_I2CDevice *i2c_dev = NULL; ///< Pointer to I2C bus interface
+  bool _auto_increment = false; ///< CFG.AI set, register banks can be burst
+  Adafruit_I2CRegisterShadow *_shadow = NULL; ///< Copy of config registers
+
+private:
+  uint8_t _readFifo(uint8_t *events);
+  void _writeBank(uint8_t reg, const uint8_t *data, uint8_t len);
+  /*! @brief Whether a register goes through the shadow: only those the
+   *         host alone changes, CFG and GPIO_DAT_OUT up to GPIO_PULL */
+  bool _shadowed(uint8_t reg) {
+    return _shadow && (reg == TCA8418_REG_CFG ||
+                       (reg >= TCA8418_REG_GPIO_DAT_OUT_1 &&
+                        reg <= TCA8418_REG_GPIO_PULL_3));
+  }
+
+  bool _irq_mode = false;             ///< enableInterrupts() was called
+  volatile bool _irq_pending = false; ///< INT fired since the last drain()
+  TCA8418_event _queue[TCA8418_EVENT_QUEUE]; ///< Drained events
+  volatile uint8_t _queue_head = 0; ///< Events drain() queued, free running
+  volatile uint8_t _queue_tail = 0; ///< Events readEvent() took, free running
 };
 
 #endif
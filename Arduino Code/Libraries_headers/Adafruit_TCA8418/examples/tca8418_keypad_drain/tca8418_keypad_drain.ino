@@ -0,0 +1,92 @@
+
+/***************************************************
+
+  @file tca8418_keypad_drain.ino
+
+  This is an example for the Adafruit TCA8418 Keypad Matrix / GPIO Expander Breakout
+
+  Designed specifically to work with the Adafruit TCA8418 Keypad Matrix
+  ----> https://www.adafruit.com/products/XXXX
+
+  These Keypad Matrix use I2C to communicate, 2 pins are required to
+  interface.
+  The Keypad Matrix has an interrupt pin to provide fast detection
+  of changes. This example lets the interrupt tell the driver when to
+  read: drain() only talks to the chip after the pin went low, and then
+  takes all waiting events in one go, each with the time it was read.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  Written by Limor Fried/Ladyada for Adafruit Industries.
+  BSD license, all text above must be included in any redistribution
+ ****************************************************/
+
+
+#include <Adafruit_TCA8418.h>
+
+Adafruit_TCA8418 keypad;
+
+//  typical Arduino UNO
+const int IRQPIN = 3;
+
+void TCA8418_irq()
+{
+  keypad.handleInterrupt();
+}
+
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  Serial.println(__FILE__);
+
+  if (! keypad.begin(TCA8418_DEFAULT_ADDR, &Wire)) {
+    Serial.println("keypad not found, check wiring & pullups!");
+    while (1);
+  }
+
+  //  configure the size of the keypad matrix.
+  //  all other pins will be inputs
+  keypad.matrix(8, 10);
+
+  //  install interrupt handler
+  //  going LOW is interrupt
+  pinMode(IRQPIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(IRQPIN), TCA8418_irq, FALLING);
+
+  //  flush pending interrupts
+  keypad.flush();
+  //  enable interrupt mode
+  keypad.enableInterrupts();
+}
+
+
+void loop()
+{
+  //  no I2C traffic unless a key was pressed or released
+  keypad.drain();
+
+  TCA8418_event e;
+  while (keypad.readEvent(&e))
+  {
+    //  datasheet page 15 - Table 1
+    int k = e.event;
+    Serial.print(e.time);
+    if (k & 0x80) Serial.print("\tPRESS\tR: ");
+    else Serial.print("\tRELEASE\tR: ");
+    k &= 0x7F;
+    k--;
+    Serial.print(k / 10);
+    Serial.print("\tC: ");
+    Serial.print(k % 10);
+    Serial.println();
+  }
+
+  // other code here
+  delay(100);
+}
@@ -0,0 +1,183 @@
+// CoreSplit.cpp
+#include "CoreSplit.h"
+
+#if defined(CORE_SPLIT_THREAD)
+#include <chrono>
+#endif
+
+
+/**
+ * CoreSplit() - Nothing runs until begin()
+ */
+CoreSplit::CoreSplit()
+  : network(NULL), running(false) {
+#if defined(ARDUINO_ARCH_ESP32)
+  task = NULL;
+#endif
+}
+
+/**
+ * begin() - Starts the network loop on its own core
+ * @param network - Called over and over on the network side
+ * @param stack - Stack of the network task in bytes (ESP32 only)
+ *
+ * Each pass is followed by a 1 ms sleep, so the idle task of core 0 still
+ * gets to feed the watchdog. Returns false if the task could not be
+ * started. On one-core targets nothing is started; poll() runs the loop.
+ */
+bool CoreSplit::begin(CoreLoop network, uint32_t stack) {
+  if (running) {
+    return true;
+  }
+  this->network = network;
+  running = true;
+
+#if defined(ARDUINO_ARCH_ESP32)
+  if (xTaskCreatePinnedToCore(networkTask, "network", stack, this,
+                              CORE_NETWORK_PRIORITY, (TaskHandle_t *)&task,
+                              CORE_NETWORK_CORE) != pdPASS) {
+    task = NULL;
+    running = false;
+    return false;
+  }
+#elif defined(CORE_SPLIT_THREAD)
+  (void)stack;
+  thread = std::thread(networkTask, this);
+#else
+  (void)stack;
+#endif
+  return true;
+}
+
+/**
+ * end() - Stops the network loop after its current pass and waits for it
+ *
+ * Messages still queued stay there.
+ */
+void CoreSplit::end() {
+  if (!running) {
+    return;
+  }
+  running = false;
+#if defined(ARDUINO_ARCH_ESP32)
+  while (task) {
+    delay(1);
+  }
+#elif defined(CORE_SPLIT_THREAD)
+  if (thread.joinable()) {
+    thread.join();
+  }
+#endif
+}
+
+/**
+ * poll() - Runs one pass of the network loop where there is no second core
+ *
+ * Does nothing when the network loop has a core (or thread) of its own,
+ * so a sketch can call it in loop() on every target.
+ */
+void CoreSplit::poll() {
+  if (running && !split()) {
+    network();
+  }
+}
+
+/**
+ * split() - Says whether the network loop runs apart from loop()
+ */
+bool CoreSplit::split() const {
+#if defined(ARDUINO_ARCH_ESP32) || defined(CORE_SPLIT_THREAD)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Body of the network task or thread
+void CoreSplit::networkTask(void *self) {
+  CoreSplit *cores = (CoreSplit *)self;
+  while (cores->running) {
+    cores->network();
+#if defined(ARDUINO_ARCH_ESP32)
+    vTaskDelay(1);
+#elif defined(CORE_SPLIT_THREAD)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+  }
+#if defined(ARDUINO_ARCH_ESP32)
+  cores->task = NULL;
+  vTaskDelete(NULL);
+#endif
+}
+
+
+/* loop() side */
+
+/**
+ * sendEvent() - Tells the network side something happened here
+ * @param type - What, up to the sketch
+ * @param arg - Small detail, e.g. which setting
+ * @param value - A value that goes with it
+ *
+ * Returns false (and counts it) if the event queue is full.
+ */
+bool CoreSplit::sendEvent(uint16_t type, int16_t arg, float value) {
+  CoreMessage m = {(uint32_t)millis(), type, arg, value};
+  return events.push(m);
+}
+
+/**
+ * sendTelemetry() - Hands a sensor reading to the network side
+ * @param reading - The reading; fill in its time
+ *
+ * Returns false (and counts it) if the telemetry queue is full.
+ */
+bool CoreSplit::sendTelemetry(const CoreTelemetry &reading) {
+  return telemetry.push(reading);
+}
+
+/**
+ * receiveCommand() - Takes the oldest command from the network side
+ * @param message - Where to put it
+ *
+ * Returns false if there is none.
+ */
+bool CoreSplit::receiveCommand(CoreMessage &message) {
+  return commands.pop(message);
+}
+
+
+/* Network side */
+
+/**
+ * sendCommand() - Asks the loop() side to do something
+ * @param type - What, up to the sketch
+ * @param arg - Small detail, e.g. which setting
+ * @param value - A value that goes with it
+ *
+ * Returns false (and counts it) if the command queue is full.
+ */
+bool CoreSplit::sendCommand(uint16_t type, int16_t arg, float value) {
+  CoreMessage m = {(uint32_t)millis(), type, arg, value};
+  return commands.push(m);
+}
+
+/**
+ * receiveEvent() - Takes the oldest event from the loop() side
+ * @param message - Where to put it
+ *
+ * Returns false if there is none.
+ */
+bool CoreSplit::receiveEvent(CoreMessage &message) {
+  return events.pop(message);
+}
+
+/**
+ * receiveTelemetry() - Takes the oldest sensor reading from the loop() side
+ * @param reading - Where to put it
+ *
+ * Returns false if there is none.
+ */
+bool CoreSplit::receiveTelemetry(CoreTelemetry &reading) {
+  return telemetry.pop(reading);
+}
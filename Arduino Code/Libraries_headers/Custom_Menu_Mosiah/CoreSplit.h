@@ -0,0 +1,139 @@
+// CoreSplit.h
+
+#ifndef CORE_SPLIT_H
+#define CORE_SPLIT_H
+
+#include <Arduino.h>
+#include "SpscQueue.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif !defined(ESP8266) && (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#define CORE_SPLIT_THREAD             // Host bench: the network loop is a std::thread
+#include <thread>
+#endif
+
+
+/** Network / sensing split across the two ESP32 cores:
+ *
+ * The SinricPro, WebSockets and TLS work runs in its own loop, pinned to
+ * core 0 next to the WiFi stack, while Arduino's loop() keeps core 1 for
+ * the sensors, stepper, keypad and OLED. A TLS handshake or a big JSON
+ * message then only stalls the network loop; steps and key presses carry
+ * on. On the host bench the network loop is a second thread.
+ *
+ * The two sides share nothing but three single producer, single consumer
+ * queues:
+ *
+ *    commands  : network -> loop()   what SinricPro asked for (open the
+ *                                    window, alarm on, new target, ...)
+ *    events    : loop() -> network   what happened here that SinricPro
+ *                                    should hear about (window moved by
+ *                                    hand, alarm tripped, push message)
+ *    telemetry : loop() -> network   sensor readings to report
+ *
+ * A full queue drops the new message and counts it. Message types are up
+ * to the sketch; keep SinricPro calls and their callbacks on the network
+ * side and everything that touches pins on the loop() side.
+ *
+ * Targets with one core (ESP8266) have no network task: call poll() in
+ * loop() and the network loop runs there, between the other work.
+ *
+ * Example:
+ *
+ *    CoreSplit cores;
+ *
+ *    void network() {                    // core 0
+ *      SinricPro.handle();               // callbacks do cores.sendCommand()
+ *      CoreMessage m;
+ *      while (cores.receiveEvent(m)) {
+ *        if (m.type == ALARM_TRIPPED) monitor.sendPushNotification("Rain!");
+ *      }
+ *      CoreTelemetry t;
+ *      while (cores.receiveTelemetry(t)) {
+ *        monitor.sendTemperatureEvent(t.temperature, t.humidity);
+ *      }
+ *    }
+ *
+ *    void setup() {
+ *      ...                               // WiFi, SinricPro.begin()
+ *      cores.begin(network);
+ *    }
+ *
+ *    void loop() {                       // core 1
+ *      cores.poll();                     // only does work on one core
+ *      CoreMessage m;
+ *      while (cores.receiveCommand(m)) {
+ *        if (m.type == OPEN_WINDOW) stepper.moveTo(OPEN_STEPS);
+ *      }
+ *      stepper.run();
+ *      ...
+ *    }
+ */
+
+#define CORE_COMMAND_QUEUE 8          // Queue sizes, powers of two
+#define CORE_EVENT_QUEUE 16
+#define CORE_TELEMETRY_QUEUE 4
+#define CORE_NETWORK_STACK 8192       // Bytes; TLS handshakes need most of it
+#define CORE_NETWORK_CORE 0
+#define CORE_NETWORK_PRIORITY 1       // Same as loop(), below the WiFi tasks
+
+struct CoreMessage {
+  uint32_t time;            // millis() when sent
+  uint16_t type;            // Up to the sketch
+  int16_t arg;
+  float value;
+};
+
+struct CoreTelemetry {
+  uint32_t time;            // millis() when read
+  float temperature;        // Celsius
+  float humidity;           // Percent
+  uint16_t rain;            // Raw rain sensor value
+};
+
+typedef void (*CoreLoop)();
+
+class CoreSplit {
+public:
+  CoreSplit();
+
+  bool begin(CoreLoop network, uint32_t stack = CORE_NETWORK_STACK);
+  void end();               // Stop the network loop and wait for it
+  void poll();              // Call in loop(): runs the network loop on one-core targets
+  bool split() const;       // Network loop runs on its own core (or thread)
+
+  // loop() side
+  bool sendEvent(uint16_t type, int16_t arg = 0, float value = 0);
+  bool sendTelemetry(const CoreTelemetry &reading);
+  bool receiveCommand(CoreMessage &message);
+
+  // Network side
+  bool sendCommand(uint16_t type, int16_t arg = 0, float value = 0);
+  bool receiveEvent(CoreMessage &message);
+  bool receiveTelemetry(CoreTelemetry &reading);
+
+  // Messages dropped on a full queue
+  uint32_t droppedCommands() const { return commands.dropped(); }
+  uint32_t droppedEvents() const { return events.dropped(); }
+  uint32_t droppedTelemetry() const { return telemetry.dropped(); }
+
+protected:
+  static void networkTask(void *self);
+
+  CoreLoop network;
+  std::atomic<bool> running;            // Cleared by end(), read by the network loop
+  SpscQueue<CoreMessage, CORE_COMMAND_QUEUE> commands;
+  SpscQueue<CoreMessage, CORE_EVENT_QUEUE> events;
+  SpscQueue<CoreTelemetry, CORE_TELEMETRY_QUEUE> telemetry;
+#if defined(ARDUINO_ARCH_ESP32)
+  TaskHandle_t volatile task;         // Cleared by the task as it exits
+#elif defined(CORE_SPLIT_THREAD)
+  std::thread thread;
+#endif
+};
+
+
+
+#endif // CORE_SPLIT_H
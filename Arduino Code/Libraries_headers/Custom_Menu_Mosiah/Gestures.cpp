@@ -0,0 +1,300 @@
+// Gestures.cpp
+#include "Gestures.h"
+
+
+// A press of a key that is already down (its release was missed) starts
+// it over; a chorded key no longer long-presses or repeats.
+const uint8_t KeypadGestures::transitions[4][4] = {
+  //              PRESSED    RELEASED   TIMED_OUT   CHORDED
+  /* FREE  */   { HELD_DOWN, HELD_FREE, HELD_FREE,  HELD_FREE  },
+  /* DOWN  */   { HELD_DOWN, HELD_FREE, HELD_LONG,  HELD_CHORD },
+  /* LONG  */   { HELD_DOWN, HELD_FREE, HELD_LONG,  HELD_CHORD },
+  /* CHORD */   { HELD_DOWN, HELD_FREE, HELD_CHORD, HELD_CHORD },
+};
+
+
+/* KeypadGestures */
+
+/**
+ * KeypadGestures() - Sets up the recognizer for one keypad layout
+ * @param keymap - Key characters, row by row, e.g. "123456789*0#"
+ * @param columns - Keys per row (columns given to keypad.matrix())
+ */
+KeypadGestures::KeypadGestures(const char *new_keymap, uint8_t new_columns)
+  : keymap(new_keymap), columns(new_columns), keys(strlen(new_keymap)),
+    longPress(800), repeatDelay(500), repeatInterval(200), repeatMin(40),
+    sequenceGap(1500), chordCount(0), sequenceCount(0) {
+  memset(flags, 0, sizeof(flags));
+  reset();
+}
+
+/**
+ * setKeyFlags() - Sets which gestures some keys report
+ * @param keys - The keys, e.g. "2468"
+ * @param flags - KEY_REPEATS and/or KEY_LONG_PRESS, 0 for plain presses
+ */
+void KeypadGestures::setKeyFlags(const char *set, uint8_t new_flags) {
+  for (; *set; set++) {
+    const char *at = strchr(keymap, *set);
+    if (at && (at - keymap) < GESTURE_MAX_KEYS) {
+      flags[at - keymap] = new_flags;
+    }
+  }
+}
+
+/**
+ * setTiming() - Sets the gesture timeouts
+ * @param longPress - ms held before LONG_PRESS
+ * @param repeatDelay - ms held before the first REPEAT
+ * @param repeatInterval - ms between the first REPEATs
+ * @param repeatMin - Shortest ms between REPEATs; each one comes 1/4
+ *                    sooner than the last until this is reached
+ * @param sequenceGap - Longest ms between the keys of a sequence
+ */
+void KeypadGestures::setTiming(uint16_t new_long, uint16_t new_delay,
+                               uint16_t new_interval, uint16_t new_min,
+                               uint16_t new_gap) {
+  longPress = new_long;
+  repeatDelay = new_delay;
+  repeatInterval = new_interval;
+  repeatMin = new_min;
+  sequenceGap = new_gap;
+}
+
+/**
+ * addChord() - Reports CHORD id when both keys are down
+ * @param first, second - The keys, in either order
+ * @param id - Passed back in Gesture::id
+ *
+ * Returns false if the chord table is full.
+ */
+bool KeypadGestures::addChord(char first, char second, uint8_t id) {
+  if (chordCount == GESTURE_MAX_CHORDS) {
+    return false;
+  }
+  chords[chordCount].first = first;
+  chords[chordCount].second = second;
+  chords[chordCount].id = id;
+  chordCount++;
+  return true;
+}
+
+/**
+ * addSequence() - Reports SEQUENCE id when these keys are pressed in order
+ * @param keys - The keys, e.g. "*#*", kept by pointer
+ * @param id - Passed back in Gesture::id
+ *
+ * Returns false if the table is full or the sequence too long.
+ */
+bool KeypadGestures::addSequence(const char *seq, uint8_t id) {
+  uint8_t len = strlen(seq);
+  if (sequenceCount == GESTURE_MAX_SEQUENCES || len == 0 ||
+      len > GESTURE_MAX_SEQUENCE_LENGTH) {
+    return false;
+  }
+  sequences[sequenceCount].keys = seq;
+  sequences[sequenceCount].len = len;
+  sequences[sequenceCount].id = id;
+  sequenceCount++;
+  return true;
+}
+
+/**
+ * feed() - Hands the recognizer one raw key event
+ * @param event - As read from the TCA8418 (bit 7 set on press)
+ * @param time - millis() when it was read
+ *
+ * GPIO events and keys outside the keymap are ignored.
+ */
+void KeypadGestures::feed(uint8_t event, uint32_t time) {
+  char key = keyChar(event);
+  if (!key) {
+    return;
+  }
+  if (event & 0x80) {
+    press(key, time);
+  } else {
+    release(key, time);
+  }
+}
+
+/**
+ * update() - Sends the LONG_PRESS and REPEAT gestures that have come due
+ * @param now - millis()
+ *
+ * Call it every pass of loop(); a late call sends one REPEAT, not a burst.
+ */
+void KeypadGestures::update(uint32_t now) {
+  for (uint8_t i = 0; i < GESTURE_MAX_HELD; i++) {
+    HeldKey &k = held[i];
+    if (k.state != HELD_DOWN && k.state != HELD_LONG) {
+      continue;
+    }
+    uint8_t f = flagsOf(k.key);
+
+    if ((f & KEY_LONG_PRESS) && k.state == HELD_DOWN &&
+        now - k.since >= longPress) {
+      step(k, HELD_TIMED_OUT);
+      emit(GESTURE_LONG_PRESS, k.key, 0, k.since + longPress);
+    }
+    if ((f & KEY_REPEATS) && (int32_t)(now - k.nextRepeat) >= 0) {
+      if (k.repeats < 255) {
+        k.repeats++;
+      }
+      emit(GESTURE_REPEAT, k.key, k.repeats, now);
+      k.nextRepeat += k.interval;
+      if ((int32_t)(now - k.nextRepeat) >= 0) {
+        k.nextRepeat = now + k.interval;   // fell behind, don't catch up
+      }
+      k.interval = max((uint16_t)(k.interval - k.interval / 4), repeatMin);
+    }
+  }
+}
+
+/**
+ * next() - Takes the oldest gesture
+ * @param gesture - Filled in if there was one
+ *
+ * Returns false if none are waiting.
+ */
+bool KeypadGestures::next(Gesture &gesture) {
+  if (tail == head) {
+    return false;
+  }
+  gesture = queue[tail];
+  tail = (tail + 1) & (GESTURE_QUEUE - 1);
+  return true;
+}
+
+/**
+ * reset() - Forgets held keys, the sequence so far and queued gestures
+ */
+void KeypadGestures::reset() {
+  for (uint8_t i = 0; i < GESTURE_MAX_HELD; i++) {
+    held[i].state = HELD_FREE;
+  }
+  historyCount = 0;
+  lastPress = 0;
+  head = tail = 0;
+  lost = 0;
+}
+
+/**
+ * keyChar() - Looks up the key of a raw key event
+ * @param event - Raw TCA8418 event; key number n is row (n-1)/10, column (n-1)%10
+ *
+ * Returns 0 for GPIO events and keys not in the keymap.
+ */
+char KeypadGestures::keyChar(uint8_t event) const {
+  uint8_t n = event & 0x7F;
+  if (n < 1 || n > 80) {
+    return 0;
+  }
+  uint8_t row = (n - 1) / 10, col = (n - 1) % 10;
+  uint16_t pos = row * columns + col;
+  if (col >= columns || pos >= keys) {
+    return 0;
+  }
+  return keymap[pos];
+}
+
+// A key went down: PRESS, then a chord with a held key, then a sequence
+void KeypadGestures::press(char key, uint32_t time) {
+  emit(GESTURE_PRESS, key, 0, time);
+
+  HeldKey *slot = NULL;
+  HeldKey *other = NULL;
+  for (uint8_t i = 0; i < GESTURE_MAX_HELD; i++) {
+    if (held[i].state == HELD_FREE) {
+      if (!slot) {
+        slot = &held[i];
+      }
+    } else if (held[i].key == key) {
+      slot = &held[i];                      // missed its release
+    } else if (held[i].state != HELD_CHORD && !other) {
+      other = &held[i];
+    }
+  }
+  if (slot) {
+    slot->key = key;
+    step(*slot, HELD_PRESSED);
+    slot->repeats = 0;
+    slot->since = time;
+    slot->nextRepeat = time + repeatDelay;
+    slot->interval = repeatInterval;
+  }
+
+  if (other) {
+    for (uint8_t c = 0; c < chordCount; c++) {
+      const Chord &ch = chords[c];
+      if ((ch.first == other->key && ch.second == key) ||
+          (ch.first == key && ch.second == other->key)) {
+        step(*other, HELD_CHORDED);
+        if (slot) {
+          step(*slot, HELD_CHORDED);
+        }
+        emit(GESTURE_CHORD, key, ch.id, time);
+        break;
+      }
+    }
+  }
+
+  if (historyCount && time - lastPress > sequenceGap) {
+    historyCount = 0;
+  }
+  lastPress = time;
+  if (historyCount == GESTURE_MAX_SEQUENCE_LENGTH) {
+    memmove(history, history + 1, GESTURE_MAX_SEQUENCE_LENGTH - 1);
+    historyCount--;
+  }
+  history[historyCount++] = key;
+  for (uint8_t s = 0; s < sequenceCount; s++) {
+    const Sequence &seq = sequences[s];
+    if (historyCount >= seq.len &&
+        !memcmp(history + historyCount - seq.len, seq.keys, seq.len)) {
+      emit(GESTURE_SEQUENCE, key, seq.id, time);
+      historyCount = 0;                     // keys count towards one sequence only
+      break;
+    }
+  }
+}
+
+// A key went up: RELEASE, and its slot is free again
+void KeypadGestures::release(char key, uint32_t time) {
+  for (uint8_t i = 0; i < GESTURE_MAX_HELD; i++) {
+    if (held[i].state != HELD_FREE && held[i].key == key) {
+      step(held[i], HELD_RELEASED);
+    }
+  }
+  emit(GESTURE_RELEASE, key, 0, time);
+}
+
+// Moves a held key to its next state
+void KeypadGestures::step(HeldKey &k, HeldEvent event) {
+  k.state = transitions[k.state][event];
+}
+
+// Queues a gesture, dropping it if next() has fallen GESTURE_QUEUE behind
+void KeypadGestures::emit(GestureType type, char key, uint8_t id, uint32_t time) {
+  uint8_t following = (head + 1) & (GESTURE_QUEUE - 1);
+  if (following == tail) {
+    if (lost < 255) {
+      lost++;
+    }
+    return;
+  }
+  queue[head].type = type;
+  queue[head].key = key;
+  queue[head].id = id;
+  queue[head].time = time;
+  head = following;
+}
+
+// KEY_ flags of a key, 0 if setKeyFlags() never named it
+uint8_t KeypadGestures::flagsOf(char key) const {
+  const char *at = strchr(keymap, key);
+  if (!at || (at - keymap) >= GESTURE_MAX_KEYS) {
+    return 0;
+  }
+  return flags[at - keymap];
+}
@@ -0,0 +1,139 @@
+// Gestures.h
+
+#ifndef GESTURES_H
+#define GESTURES_H
+
+#include <Arduino.h>
+
+
+/** Keypad gesture recognizer:
+ *
+ * Turns the raw TCA8418 key events (bit 7 set on press, key number
+ * 1..80 below it) into what the menu acts on:
+ *
+ *    PRESS      : a key went down (straight away, for live key display)
+ *    RELEASE    : a key went up
+ *    LONG_PRESS : a KEY_LONG_PRESS key held for longPress ms
+ *    REPEAT     : a KEY_REPEATS key still held; the first after repeatDelay
+ *                 ms, then faster and faster down to repeatMin ms apart
+ *    CHORD      : a second key pressed while the first is held, if the
+ *                 pair was given to addChord()
+ *    SEQUENCE   : keys pressed in the order given to addSequence(), each
+ *                 within sequenceGap ms of the last (e.g. "*#*")
+ *
+ * Each held key moves between free, down, long and chorded through a fixed
+ * transition table. Everything is in fixed tables, nothing is allocated.
+ * Sequence strings are kept by pointer, so pass literals.
+ *
+ * Example:
+ *
+ *    KeypadGestures gestures("123456789*0#", 3);
+ *    gestures.setKeyFlags("2468", KEY_REPEATS);   // arrows for numeric entry
+ *    gestures.setKeyFlags("*#", KEY_LONG_PRESS);
+ *    gestures.addSequence("*#*", EXIT_KEY_TEST);
+ *
+ *    // in loop()
+ *    keypad.drain();
+ *    TCA8418_event e;
+ *    while (keypad.readEvent(&e)) {
+ *      gestures.feed(e.event, e.time);
+ *    }
+ *    gestures.update(millis());
+ *    Gesture g;
+ *    while (gestures.next(g)) {
+ *      // act on g.type, g.key, g.id
+ *    }
+ */
+
+#define GESTURE_MAX_KEYS 16         // Keys setKeyFlags() can configure
+#define GESTURE_MAX_HELD 4          // Keys tracked down at the same time
+#define GESTURE_MAX_CHORDS 4
+#define GESTURE_MAX_SEQUENCES 4
+#define GESTURE_MAX_SEQUENCE_LENGTH 6
+#define GESTURE_QUEUE 32            // Gestures waiting for next(), power of two;
+                                    // holds a full keypad queue of presses and releases
+
+#define KEY_REPEATS 0x01            // Key auto-repeats while held
+#define KEY_LONG_PRESS 0x02         // Key reports a long press
+
+enum GestureType {
+  GESTURE_PRESS,
+  GESTURE_RELEASE,
+  GESTURE_LONG_PRESS,
+  GESTURE_REPEAT,
+  GESTURE_CHORD,
+  GESTURE_SEQUENCE
+};
+
+struct Gesture {
+  GestureType type;
+  char key;             // Key it is about, the last key of a chord or sequence
+  uint8_t id;           // Chord/sequence id, or how many repeats so far
+  uint32_t time;        // millis() of the key event or timeout behind it
+};
+
+class KeypadGestures {
+public:
+  KeypadGestures(const char *keymap, uint8_t columns);
+
+  void setKeyFlags(const char *keys, uint8_t flags);
+  void setTiming(uint16_t longPress, uint16_t repeatDelay, uint16_t repeatInterval,
+                 uint16_t repeatMin, uint16_t sequenceGap);  // ms
+  bool addChord(char first, char second, uint8_t id);
+  bool addSequence(const char *keys, uint8_t id);
+
+  void feed(uint8_t event, uint32_t time);  // Raw key event from the keypad
+  void update(uint32_t now);                // Fire long presses and repeats
+  bool next(Gesture &gesture);              // Take the oldest gesture
+  void reset();                             // Forget held keys and queued gestures
+
+  char keyChar(uint8_t event) const;        // Key of a raw event, 0 if not in the keymap
+  uint8_t dropped() const { return lost; }  // Gestures lost to a full queue
+
+protected:
+  enum HeldState { HELD_FREE, HELD_DOWN, HELD_LONG, HELD_CHORD };
+  enum HeldEvent { HELD_PRESSED, HELD_RELEASED, HELD_TIMED_OUT, HELD_CHORDED };
+  static const uint8_t transitions[4][4];  // Next HeldState by [state][event]
+
+  struct HeldKey {
+    char key;
+    uint8_t state;          // HeldState
+    uint8_t repeats;        // REPEATs sent so far
+    uint32_t since;         // When it went down
+    uint32_t nextRepeat;    // When the next REPEAT is due
+    uint16_t interval;      // Current repeat interval
+  };
+
+  struct Chord { char first, second; uint8_t id; };
+  struct Sequence { const char *keys; uint8_t len; uint8_t id; };
+
+  void press(char key, uint32_t time);
+  void release(char key, uint32_t time);
+  void step(HeldKey &k, HeldEvent event);
+  void emit(GestureType type, char key, uint8_t id, uint32_t time);
+  uint8_t flagsOf(char key) const;
+
+  const char *keymap;                       // Row-major, columns keys per row
+  uint8_t columns, keys;
+  uint8_t flags[GESTURE_MAX_KEYS];          // KEY_ flags by keymap position
+
+  uint16_t longPress, repeatDelay, repeatInterval, repeatMin, sequenceGap;
+
+  HeldKey held[GESTURE_MAX_HELD];
+  Chord chords[GESTURE_MAX_CHORDS];
+  uint8_t chordCount;
+  Sequence sequences[GESTURE_MAX_SEQUENCES];
+  uint8_t sequenceCount;
+
+  char history[GESTURE_MAX_SEQUENCE_LENGTH]; // Recent presses, oldest first
+  uint8_t historyCount;
+  uint32_t lastPress;
+
+  Gesture queue[GESTURE_QUEUE];
+  uint8_t head, tail;                       // Next slot to fill / to take
+  uint8_t lost;
+};
+
+
+
+#endif // GESTURES_H
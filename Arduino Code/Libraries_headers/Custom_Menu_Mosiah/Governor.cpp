@@ -0,0 +1,170 @@
+// Governor.cpp
+#include "Governor.h"
+
+
+/* DisplayGovernor */
+DisplayGovernor::DisplayGovernor(Adafruit_SH110X &display)
+  : oled(display), powerState(DISPLAY_ACTIVE), dimAfter(30000),
+    offAfter(120000), idleAfter(5000), activeInterval(50), idleInterval(1000),
+    bright(0xFF), dimmed(0x10), lastInput(0), lastChange(0), lastFrame(0),
+    framePending(true) {}
+
+/**
+ * setTimeouts() - Sets how long without input before dimming and switching off
+ * @param dimAfter - ms without input before the contrast is lowered, 0 = never
+ * @param offAfter - ms without input before the panel is turned off, 0 = never
+ */
+void DisplayGovernor::setTimeouts(uint32_t new_dim, uint32_t new_off) {
+  dimAfter = new_dim;
+  offAfter = new_off;
+}
+
+/**
+ * setIntervals() - Sets how often the screen is refreshed
+ * @param activeInterval - ms between refreshes while the screen is changing
+ * @param idleInterval - ms between refreshes once it has stopped changing
+ * @param idleAfter - ms without a change before idleInterval is used
+ *
+ * A slow idleInterval only delays the first change after a quiet spell;
+ * from then on the screen is refreshed at activeInterval again.
+ */
+void DisplayGovernor::setIntervals(uint16_t new_active, uint16_t new_idle,
+                                   uint32_t new_idle_after) {
+  activeInterval = new_active;
+  idleInterval = new_idle;
+  idleAfter = new_idle_after;
+}
+
+/**
+ * setContrast() - Sets the normal and dimmed contrast levels
+ * @param bright - Contrast while in use (the SH1106G starts at 0xFF)
+ * @param dimmed - Contrast after dimAfter without input
+ *
+ * Takes effect immediately, so call it after display.begin().
+ */
+void DisplayGovernor::setContrast(uint8_t new_bright, uint8_t new_dimmed) {
+  bright = new_bright;
+  dimmed = new_dimmed;
+  if (powerState != DISPLAY_OFF) {
+    oled.waitForDisplay();
+    oled.setContrast(powerState == DISPLAY_DIMMED ? dimmed : bright);
+  }
+}
+
+/**
+ * wake() - Registers user input
+ *
+ * Restarts the dim/off timeouts, brings the panel back to full contrast and
+ * makes the next refresh happen right away. If the panel was off, whatever
+ * was drawn before it went off is sent first so it comes back up showing
+ * the right thing.
+ *
+ * Returns true if the panel was off, so the caller can treat the key press
+ * as "wake up" only.
+ */
+bool DisplayGovernor::wake() {
+  bool wasOff = (powerState == DISPLAY_OFF);
+  lastInput = lastChange = millis();
+  framePending = true;
+  setState(DISPLAY_ACTIVE);
+  return wasOff;
+}
+
+/**
+ * update() - Moves between states as the timeouts expire
+ */
+void DisplayGovernor::update() {
+  uint32_t now = millis();
+  uint32_t quiet = now - lastInput;
+
+  if (offAfter && quiet >= offAfter) {
+    setState(DISPLAY_OFF);
+  } else if (dimAfter && quiet >= dimAfter) {
+    setState(DISPLAY_DIMMED);
+  } else if (idleAfter && (now - lastChange) >= idleAfter) {
+    setState(DISPLAY_IDLE);
+  } else {
+    setState(DISPLAY_ACTIVE);
+  }
+}
+
+/**
+ * frameDue() - Tells a sketch that draws directly whether to draw now
+ *
+ * False while the panel is off or until the current refresh interval has
+ * passed since the last frame. When it returns true the interval restarts.
+ */
+bool DisplayGovernor::frameDue() {
+  update();
+  if (powerState == DISPLAY_OFF) {
+    return false;
+  }
+  uint32_t now = millis();
+  bool quiet = idleAfter && (now - lastChange) >= idleAfter;
+  uint16_t interval = quiet ? idleInterval : activeInterval;
+  if (!framePending && (now - lastFrame) < interval) {
+    return false;
+  }
+  lastFrame = now;
+  framePending = false;
+  return true;
+}
+
+/**
+ * display() - Sends the frame buffer, unless the panel is off
+ * @param changed - Whether this frame drew anything new (keeps the refresh
+ *                  rate up while the screen is changing)
+ *
+ * Drawing done while the panel is off stays in the frame buffer, still
+ * marked dirty, and is sent by wake().
+ */
+void DisplayGovernor::display(bool changed) {
+  if (changed) {
+    lastChange = millis();
+  }
+  if (powerState != DISPLAY_OFF) {
+    oled.display();
+  }
+}
+
+/**
+ * refresh() - Refreshes a widget screen when a frame is due
+ * @param screen - The screen currently shown
+ *
+ * Returns true if anything was drawn.
+ */
+bool DisplayGovernor::refresh(WidgetScreen &screen) {
+  if (!frameDue()) {
+    return false;
+  }
+  bool drawn = screen.refresh(oled);
+  if (drawn) {
+    lastChange = millis();
+  }
+  return drawn;
+}
+
+// Sends the commands for a change of state, nothing if it is the same
+void DisplayGovernor::setState(DisplayPowerState next) {
+  if (next == powerState) {
+    return;
+  }
+  DisplayPowerState prev = powerState;
+  powerState = next;
+
+  if (prev == DISPLAY_OFF) {
+    // Catch up on what was drawn while off before the panel shows it
+    oled.display();
+  }
+  oled.waitForDisplay();  // Commands must not cut into an async flush
+  if (next == DISPLAY_OFF) {
+    oled.oled_command(SH110X_DISPLAYOFF);
+  } else if (next == DISPLAY_DIMMED) {
+    oled.setContrast(dimmed);
+  } else if (prev == DISPLAY_DIMMED || prev == DISPLAY_OFF) {
+    oled.setContrast(bright);
+  }
+  if (prev == DISPLAY_OFF) {
+    oled.oled_command(SH110X_DISPLAYON);
+  }
+}
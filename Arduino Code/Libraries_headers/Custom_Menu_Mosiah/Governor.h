@@ -0,0 +1,84 @@
+// Governor.h
+
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <Arduino.h>
+#include <Adafruit_SH110X.h>
+#include "Widgets.h"
+
+
+/** Display power and refresh governor:
+ *
+ * Decides when the screen is worth refreshing and how bright it should be,
+ * so a unit left alone stops spending I2C traffic and panel current on it:
+ *
+ *    ACTIVE : full contrast, refreshed every activeInterval ms
+ *    IDLE   : nothing on screen changed for idleAfter ms, refreshed only
+ *             every idleInterval ms (first change goes back to ACTIVE)
+ *    DIMMED : no input for dimAfter ms, contrast lowered
+ *    OFF    : no input for offAfter ms, panel switched off (display-off
+ *             command, the controller keeps its RAM). Nothing is drawn or
+ *             sent while off, since nobody can see it.
+ *
+ * wake() (call it on every keypad event) turns the panel back on at full
+ * contrast straight away.
+ *
+ * Example:
+ *
+ *    DisplayGovernor governor(display);
+ *    governor.setTimeouts(30000, 120000);    // the "Sleep Mode" setting
+ *
+ *    // in loop()
+ *    if (key pressed && governor.wake()) {
+ *      // the panel was off: this key only woke it up
+ *    }
+ *    governor.refresh(readings);              // instead of readings.refresh()
+ *
+ * Sketches that draw directly instead of through a WidgetScreen check
+ * frameDue() before drawing and call display(changed) afterwards.
+ */
+
+enum DisplayPowerState {
+  DISPLAY_ACTIVE,
+  DISPLAY_IDLE,
+  DISPLAY_DIMMED,
+  DISPLAY_OFF
+};
+
+class DisplayGovernor {
+public:
+  DisplayGovernor(Adafruit_SH110X &display);
+
+  void setTimeouts(uint32_t dimAfter, uint32_t offAfter);  // ms without input, 0 = never
+  void setIntervals(uint16_t activeInterval, uint16_t idleInterval,
+                    uint32_t idleAfter);                    // ms
+  void setContrast(uint8_t bright, uint8_t dimmed);
+
+  bool wake();              // User input: full brightness now. True if the panel was off
+  void update();            // Apply dim/off timeouts, called by refresh() and frameDue()
+  bool refresh(WidgetScreen &screen);  // Refresh the screen if due and visible
+  bool frameDue();          // For direct drawing: may a frame be drawn now?
+  void display(bool changed = true);   // For direct drawing: push the frame if visible
+
+  DisplayPowerState state() const { return powerState; }
+  bool isOn() const { return powerState != DISPLAY_OFF; }
+
+protected:
+  void setState(DisplayPowerState next);
+
+  Adafruit_SH110X &oled;
+  DisplayPowerState powerState;
+  uint32_t dimAfter, offAfter;          // Input timeouts
+  uint32_t idleAfter;                   // Time without changes before IDLE
+  uint16_t activeInterval, idleInterval;  // Time between refreshes
+  uint8_t bright, dimmed;               // Contrast levels
+  uint32_t lastInput;                   // millis() of the last wake()
+  uint32_t lastChange;                  // millis() of the last frame that drew something
+  uint32_t lastFrame;                   // millis() of the last refresh attempt
+  bool framePending;                    // No refresh since wake(), do one now
+};
+
+
+
+#endif // GOVERNOR_H
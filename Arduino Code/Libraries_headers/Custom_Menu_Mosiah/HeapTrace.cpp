@@ -0,0 +1,451 @@
+// HeapTrace.cpp
+#include "HeapTrace.h"
+
+#ifdef HEAP_TRACE
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <reent.h>
+static portMUX_TYPE heapTraceMux = portMUX_INITIALIZER_UNLOCKED;
+#define HEAP_TRACE_LOCK() portENTER_CRITICAL(&heapTraceMux)
+#define HEAP_TRACE_UNLOCK() portEXIT_CRITICAL(&heapTraceMux)
+#elif defined(ESP8266)
+#define HEAP_TRACE_LOCK() noInterrupts()
+#define HEAP_TRACE_UNLOCK() interrupts()
+#else
+#include <new>
+#define HEAP_TRACE_LOCK()       // Host bench: a single thread
+#define HEAP_TRACE_UNLOCK()
+#endif
+
+// The running scope's tag is kept per task, so scopes opened by tasks on
+// the two cores can't restore each other's
+#if defined(ARDUINO_ARCH_ESP32)
+static inline uint8_t scopeTag() {
+  return (uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, HEAP_TRACE_TLS_INDEX);
+}
+static inline void setScopeTag(uint8_t tag) {
+  vTaskSetThreadLocalStoragePointer(NULL, HEAP_TRACE_TLS_INDEX, (void *)(uintptr_t)tag);
+}
+#else
+#if defined(ESP8266)
+static uint8_t taskTag;                 // One task
+#else
+static thread_local uint8_t taskTag;    // Host: per thread
+#endif
+static inline uint8_t scopeTag() { return taskTag; }
+static inline void setScopeTag(uint8_t tag) { taskTag = tag; }
+#endif
+
+
+HeapTracer heapTrace;
+
+
+/* HeapTracer */
+
+/**
+ * begin() - Forgets all stats and starts tracing
+ */
+void HeapTracer::begin() {
+  HEAP_TRACE_LOCK();
+  running = false;
+  memset(tagStats, 0, sizeof(tagStats));
+  tagStats[0].name = "other";
+  tagCount = 1;
+  memset(blocks, 0, sizeof(blocks));
+  blockCount = 0;
+  missed = 0;
+  sampleNext = sampleCount = 0;
+  HEAP_TRACE_UNLOCK();
+
+  started = lastSample = millis();
+  sample();
+  running = true;
+}
+
+/**
+ * end() - Stops tracing; what was gathered stays for dump()
+ */
+void HeapTracer::end() {
+  running = false;
+}
+
+/**
+ * tag() - Looks up the id of a subsystem, adding it on first use
+ * @param name - Name to charge allocations to, kept by pointer
+ *
+ * Returns 0 ("other") once HEAP_TRACE_TAGS names are in use.
+ */
+uint8_t HeapTracer::tag(const char *name) {
+  HEAP_TRACE_LOCK();
+  uint8_t id = 0;
+  for (uint8_t i = 1; i < tagCount; i++) {
+    if (tagStats[i].name == name || !strcmp(tagStats[i].name, name)) {
+      id = i;
+      break;
+    }
+  }
+  if (!id && tagCount < HEAP_TRACE_TAGS) {
+    id = tagCount++;
+    tagStats[id].name = name;
+  }
+  HEAP_TRACE_UNLOCK();
+  return id;
+}
+
+/**
+ * update() - Samples the heap if interval ms have passed since the last sample
+ * @param interval - ms between samples
+ */
+void HeapTracer::update(uint32_t interval) {
+  if (running && millis() - lastSample >= interval) {
+    sample();
+  }
+}
+
+/**
+ * sample() - Records free heap, largest free block and traced bytes now
+ *
+ * The oldest sample is dropped once HEAP_TRACE_SAMPLES are kept.
+ */
+void HeapTracer::sample() {
+  HeapSample s;
+  s.time = lastSample = millis();
+#if defined(ARDUINO_ARCH_ESP32)
+  s.freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  s.largestFree = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+#elif defined(ESP8266)
+  s.freeBytes = ESP.getFreeHeap();
+  s.largestFree = ESP.getMaxFreeBlockSize();
+#else
+  s.freeBytes = s.largestFree = 0;
+#endif
+  s.tracedBytes = 0;
+  for (uint8_t i = 0; i < tagCount; i++) {
+    s.tracedBytes += tagStats[i].liveBytes;
+  }
+  samples[sampleNext] = s;
+  sampleNext = (sampleNext + 1) % HEAP_TRACE_SAMPLES;
+  if (sampleCount < HEAP_TRACE_SAMPLES) {
+    sampleCount++;
+  }
+}
+
+// Right-aligns a number in a column
+static void column(Print &out, uint32_t value, uint8_t width) {
+  uint8_t digits = 1;
+  for (uint32_t v = value; v >= 10; v /= 10) {
+    digits++;
+  }
+  while (digits++ < width) {
+    out.print(' ');
+  }
+  out.print(value);
+}
+
+/**
+ * dump() - Prints the stats of every subsystem and the heap samples
+ * @param out - Where to, e.g. Serial
+ *
+ * Prints with numbers only, so it does not allocate itself.
+ */
+void HeapTracer::dump(Print &out) {
+  out.print("heap trace, ");
+  out.print(millis() - started);
+  out.print(" ms, ");
+  out.print(blockCount);
+  out.print(" blocks live, ");
+  out.print(missed);
+  out.println(" untracked");
+  out.println("subsystem     allocs   frees  failed   live B   peak B  total B"
+              "  largest  avg life  churn");
+
+  for (uint8_t i = 0; i < tagCount; i++) {
+    HeapTagStats t = tagStats[i];   // Copy, it may change while printing
+    if (!t.allocs && !t.failed) {
+      continue;
+    }
+    out.print(t.name);
+    for (uint8_t n = strlen(t.name); n < 12; n++) {
+      out.print(' ');
+    }
+    column(out, t.allocs, 8);
+    column(out, t.frees, 8);
+    column(out, t.failed, 8);
+    column(out, t.liveBytes, 9);
+    column(out, t.peakBytes, 9);
+    column(out, t.totalBytes, 9);
+    column(out, t.largest, 9);
+    column(out, t.frees ? t.lifetime / t.frees : 0, 10);
+    column(out, t.shortLived, 7);
+    out.println();
+  }
+
+  out.println("time ms      free B  largest B  traced B  frag %");
+  for (uint8_t i = 0; i < sampleCount; i++) {
+    const HeapSample &s =
+      samples[(sampleNext + HEAP_TRACE_SAMPLES - sampleCount + i) % HEAP_TRACE_SAMPLES];
+    column(out, s.time, 10);
+    column(out, s.freeBytes, 10);
+    column(out, s.largestFree, 11);
+    column(out, s.tracedBytes, 10);
+    // How much of the free heap can't be had in one piece
+    column(out, s.freeBytes ? 100 - (uint32_t)((uint64_t)s.largestFree * 100 / s.freeBytes) : 0, 8);
+    out.println();
+  }
+}
+
+/**
+ * allocated() - Records a block returned by the allocator
+ * @param ptr - The block, NULL if the allocation failed
+ * @param size - Bytes requested
+ */
+void HeapTracer::allocated(void *ptr, size_t size) {
+  if (!running) {
+    return;
+  }
+  if (!ptr) {
+    failed(size);
+    return;
+  }
+  uint8_t id = tagNow();
+  uint32_t now = millis();
+
+  HEAP_TRACE_LOCK();
+  HeapTagStats &t = tagStats[id];
+  t.allocs++;
+  t.totalBytes += size;
+  if (size > t.largest) {
+    t.largest = size;
+  }
+  // Keep one slot free so lookups always reach an empty one
+  if (blockCount >= HEAP_TRACE_BLOCKS - 1) {
+    missed++;
+  } else {
+    uint16_t i = slotOf(ptr);
+    while (blocks[i].ptr) {
+      i = (i + 1) & (HEAP_TRACE_BLOCKS - 1);
+    }
+    blocks[i].ptr = ptr;
+    blocks[i].size = size;
+    blocks[i].time = now;
+    blocks[i].tag = id;
+    blockCount++;
+    t.liveBlocks++;
+    t.liveBytes += size;
+    if (t.liveBytes > t.peakBytes) {
+      t.peakBytes = t.liveBytes;
+    }
+  }
+  HEAP_TRACE_UNLOCK();
+}
+
+/**
+ * freed() - Records a block about to be given back to the allocator
+ * @param ptr - The block
+ *
+ * Returns the size it was allocated with, 0 if it was not tracked.
+ */
+uint32_t HeapTracer::freed(void *ptr) {
+  if (!ptr || !blockCount) {
+    return 0;
+  }
+  uint32_t now = millis();
+  uint32_t size = 0;
+
+  HEAP_TRACE_LOCK();
+  uint16_t i = slotOf(ptr);
+  while (blocks[i].ptr && blocks[i].ptr != ptr) {
+    i = (i + 1) & (HEAP_TRACE_BLOCKS - 1);
+  }
+  if (blocks[i].ptr) {
+    Block &b = blocks[i];
+    HeapTagStats &t = tagStats[b.tag];
+    uint32_t life = now - b.time;
+    size = b.size;
+    t.frees++;
+    t.liveBlocks--;
+    t.liveBytes -= b.size;
+    t.lifetime += life;
+    if (life < HEAP_TRACE_SHORT_LIVED) {
+      t.shortLived++;
+    }
+    blockCount--;
+
+    // Close the gap: move back any later entry of the run that would no
+    // longer be found past the empty slot
+    uint16_t gap = i;
+    b.ptr = NULL;
+    for (uint16_t j = (gap + 1) & (HEAP_TRACE_BLOCKS - 1); blocks[j].ptr;
+         j = (j + 1) & (HEAP_TRACE_BLOCKS - 1)) {
+      uint16_t home = slotOf(blocks[j].ptr);
+      if (((j - home) & (HEAP_TRACE_BLOCKS - 1)) >=
+          ((j - gap) & (HEAP_TRACE_BLOCKS - 1))) {
+        blocks[gap] = blocks[j];
+        blocks[j].ptr = NULL;
+        gap = j;
+      }
+    }
+  }
+  HEAP_TRACE_UNLOCK();
+  return size;
+}
+
+/**
+ * failed() - Records an allocation the allocator could not satisfy
+ * @param size - Bytes requested
+ */
+void HeapTracer::failed(size_t size) {
+  if (!running) {
+    return;
+  }
+  uint8_t id = tagNow();
+  HEAP_TRACE_LOCK();
+  tagStats[id].failed++;
+  if (size > tagStats[id].largest) {
+    tagStats[id].largest = size;
+  }
+  HEAP_TRACE_UNLOCK();
+}
+
+// Subsystem to charge: the scope running in this task, "other" if none
+uint8_t HeapTracer::tagNow() {
+  return scopeTag();
+}
+
+// Home slot of a block in the table
+uint16_t HeapTracer::slotOf(void *ptr) const {
+  uint32_t h = (uint32_t)((uintptr_t)ptr >> 3) * 2654435761u;
+  return (h >> 16) & (HEAP_TRACE_BLOCKS - 1);
+}
+
+
+/* HeapTraceScope */
+
+/**
+ * HeapTraceScope() - Charges allocations to a subsystem until destroyed
+ * @param name - The subsystem, e.g. "sinric"; a literal, kept by pointer
+ *
+ * Scopes nest within a task. Only allocations in the task that opened the
+ * scope are charged to it; each task (thread on the host) has its own.
+ */
+HeapTraceScope::HeapTraceScope(const char *name)
+  : previousTag(scopeTag()) {
+  setScopeTag(heapTrace.tag(name));
+}
+
+HeapTraceScope::~HeapTraceScope() {
+  setScopeTag(previousTag);
+}
+
+
+/* Allocator hooks, reached through the linker's --wrap */
+
+extern "C" {
+
+void *__real_malloc(size_t size);
+void __real_free(void *ptr);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  void *ptr = __real_malloc(size);
+  heapTrace.allocated(ptr, size);
+  return ptr;
+}
+
+void __wrap_free(void *ptr) {
+  heapTrace.freed(ptr);
+  __real_free(ptr);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  void *ptr = __real_calloc(count, size);
+  heapTrace.allocated(ptr, count * size);
+  return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  // Forget the old block first: once realloc moves it, another task may
+  // be handed the same address
+  uint32_t old = heapTrace.freed(ptr);
+  void *moved = __real_realloc(ptr, size);
+  if (moved) {
+    heapTrace.allocated(moved, size);
+  } else if (size) {
+    heapTrace.failed(size);
+    if (old) {
+      heapTrace.allocated(ptr, old);    // Still there, as a new block
+    }
+  }
+  return moved;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+// newlib's own calls (strdup, stdio) go straight to the reentrant versions
+void *__real__malloc_r(struct _reent *r, size_t size);
+void __real__free_r(struct _reent *r, void *ptr);
+void *__real__calloc_r(struct _reent *r, size_t count, size_t size);
+void *__real__realloc_r(struct _reent *r, void *ptr, size_t size);
+
+void *__wrap__malloc_r(struct _reent *r, size_t size) {
+  void *ptr = __real__malloc_r(r, size);
+  heapTrace.allocated(ptr, size);
+  return ptr;
+}
+
+void __wrap__free_r(struct _reent *r, void *ptr) {
+  heapTrace.freed(ptr);
+  __real__free_r(r, ptr);
+}
+
+void *__wrap__calloc_r(struct _reent *r, size_t count, size_t size) {
+  void *ptr = __real__calloc_r(r, count, size);
+  heapTrace.allocated(ptr, count * size);
+  return ptr;
+}
+
+void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size) {
+  uint32_t old = heapTrace.freed(ptr);
+  void *moved = __real__realloc_r(r, ptr, size);
+  if (moved) {
+    heapTrace.allocated(moved, size);
+  } else if (size) {
+    heapTrace.failed(size);
+    if (old) {
+      heapTrace.allocated(ptr, old);
+    }
+  }
+  return moved;
+}
+#endif
+
+} // extern "C"
+
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(ESP8266)
+// On the host the C++ runtime is a shared library whose operator new
+// calls malloc where --wrap can't reach, so replace new and delete here.
+// Their malloc() and free() calls are wrapped like any other.
+void *operator new(size_t size) {
+  void *ptr = malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return malloc(size ? size : 1);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return malloc(size ? size : 1);
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+#endif
+
+#endif // HEAP_TRACE
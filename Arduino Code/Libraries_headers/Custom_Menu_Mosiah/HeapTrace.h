@@ -0,0 +1,155 @@
+// HeapTrace.h
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#include <Arduino.h>
+
+
+/** Heap allocation tracer:
+ *
+ * Hooks malloc/calloc/realloc/free (and with them new/delete, String and
+ * ArduinoJson) and charges every block to the subsystem whose
+ * HEAP_TRACE_SCOPE() is running when it is allocated. Per subsystem it
+ * keeps allocation and free counts, live/peak/total bytes, the largest
+ * request, and how long freed blocks lived; short-lived blocks are the
+ * churn that fragments the heap. update() samples the free heap and the
+ * largest free block every so often, so fragmentation can be followed
+ * over days of uptime. dump() prints it all to any Print (Serial, or
+ * stdout in the host bench).
+ *
+ * Everything is compiled out unless HEAP_TRACE is defined for the whole
+ * build, and the allocator calls are only seen if the link wraps them:
+ *
+ *    -DHEAP_TRACE -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+ *
+ * On ESP32 also add --wrap=_malloc_r,--wrap=_free_r,--wrap=_calloc_r,
+ * --wrap=_realloc_r, which newlib calls directly (strdup, printf). With
+ * PlatformIO these go in build_flags; in the Arduino IDE in
+ * compiler.c.elf.extra_flags of a platform.local.txt.
+ *
+ * Blocks are tracked in a fixed table, nothing is allocated. Blocks that
+ * were allocated before begin() or while the table was full are passed
+ * through untouched and counted as untracked.
+ *
+ * Example:
+ *
+ *    void setup() {
+ *    #ifdef HEAP_TRACE
+ *      heapTrace.begin();
+ *    #endif
+ *    }
+ *
+ *    void readSensors() {
+ *      HEAP_TRACE_SCOPE("sensors");    // charged to "sensors" until return
+ *      ...
+ *    }
+ *
+ *    // in loop()
+ *    #ifdef HEAP_TRACE
+ *    heapTrace.update(60000);          // one heap sample a minute
+ *    if (dumpRequested) heapTrace.dump(Serial);
+ *    #endif
+ */
+
+#define HEAP_TRACE_TAGS 12            // Subsystems, including "other"
+#define HEAP_TRACE_BLOCKS 256         // Live blocks tracked, power of two
+#define HEAP_TRACE_SAMPLES 32         // Heap samples kept by update()
+#define HEAP_TRACE_SHORT_LIVED 1000   // ms; blocks freed sooner are churn
+
+// ESP32: FreeRTOS thread local slot holding each task's scope. The IDF's
+// pthread keys use slot 0; with CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS
+// at 1 (Arduino's default) a sketch using pthread keys must raise it
+#ifndef HEAP_TRACE_TLS_INDEX
+#define HEAP_TRACE_TLS_INDEX (configNUM_THREAD_LOCAL_STORAGE_POINTERS - 1)
+#endif
+
+#ifdef HEAP_TRACE
+#define HEAP_TRACE_JOIN2(a, b) a##b
+#define HEAP_TRACE_JOIN(a, b) HEAP_TRACE_JOIN2(a, b)
+#define HEAP_TRACE_SCOPE(name) \
+  HeapTraceScope HEAP_TRACE_JOIN(heapTraceScope, __LINE__)(name)
+#else
+#define HEAP_TRACE_SCOPE(name)
+#endif
+
+struct HeapTagStats {
+  const char *name;
+  uint32_t allocs;          // Blocks allocated (a realloc is a free + alloc)
+  uint32_t frees;           // Of those, freed again
+  uint32_t failed;          // Requests that returned NULL
+  uint32_t liveBlocks;
+  uint32_t liveBytes;
+  uint32_t peakBytes;       // Most liveBytes at any time
+  uint32_t totalBytes;      // All bytes ever requested
+  uint32_t largest;         // Largest single request
+  uint32_t lifetime;        // Summed ms the freed blocks lived
+  uint32_t shortLived;      // Freed within HEAP_TRACE_SHORT_LIVED ms
+};
+
+struct HeapSample {
+  uint32_t time;            // millis()
+  uint32_t freeBytes;       // Free heap, 0 where the platform can't tell
+  uint32_t largestFree;     // Largest block malloc could return
+  uint32_t tracedBytes;     // Live bytes in tracked blocks
+};
+
+class HeapTracer {
+public:
+  void begin();                         // Clear everything and start
+  void end();                           // Stop; stats stay for dump()
+  bool active() const { return running; }
+
+  uint8_t tag(const char *name);        // Id of a subsystem, added on first use
+  uint8_t tags() const { return tagCount; }
+  const HeapTagStats &stats(uint8_t id) const { return tagStats[id]; }
+  uint32_t untracked() const { return missed; }  // Blocks not in the table
+
+  void update(uint32_t interval);       // Sample the heap every interval ms
+  void sample();                        // Sample the heap now
+  void dump(Print &out);
+
+  // Called by the allocator hooks
+  void allocated(void *ptr, size_t size);
+  uint32_t freed(void *ptr);            // Returns the block's size, 0 if unknown
+  void failed(size_t size);
+
+protected:
+  struct Block {
+    void *ptr;
+    uint32_t size;
+    uint32_t time;          // millis() when allocated
+    uint8_t tag;
+  };
+
+  uint8_t tagNow();
+  uint16_t slotOf(void *ptr) const;
+
+  // No constructor: the tracer must work for allocations made during
+  // static initialization, before any constructor could have run
+  bool running;
+  uint32_t started;
+  HeapTagStats tagStats[HEAP_TRACE_TAGS];
+  uint8_t tagCount;
+  Block blocks[HEAP_TRACE_BLOCKS];
+  uint16_t blockCount;
+  uint32_t missed;
+  HeapSample samples[HEAP_TRACE_SAMPLES];
+  uint8_t sampleNext, sampleCount;
+  uint32_t lastSample;
+};
+
+extern HeapTracer heapTrace;
+
+/** Charges allocations to a subsystem until it goes out of scope */
+class HeapTraceScope {
+public:
+  HeapTraceScope(const char *name);
+  ~HeapTraceScope();
+private:
+  uint8_t previousTag;      // This task's scope before this one
+};
+
+
+
+#endif // HEAP_TRACE_H
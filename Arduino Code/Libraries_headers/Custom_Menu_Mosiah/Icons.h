@@ -0,0 +1,116 @@
+// Icons.h
+
+#ifndef ICONS_H
+#define ICONS_H
+
+#include <Adafruit_GrayOLED.h>
+
+
+/** Status icons for the OLED, 12x12, in page format for drawIcon():
+ *
+ *    display.drawIcon(0, 0, &wifiIcon, SH110X_WHITE);
+ *
+ * With the display unrotated an icon is copied straight into the frame
+ * buffer, a few bytes per column, so a whole status bar costs about as
+ * much as one character. Generated with
+ * Adafruit_GFX_Library/fontconvert/iconconvert.py from the pictures below;
+ * edit the picture and rerun it rather than editing the bytes.
+ */
+
+// wifi: 12x12
+//   ............
+//   ...######...
+//   .##......##.
+//   #...####...#
+//   ..##....##..
+//   .#..####..#.
+//   ...#....#...
+//   .....##.....
+//   ....#..#....
+//   .....##.....
+//   ............
+//   ............
+const uint8_t wifiBitmap[] PROGMEM = {
+    0x08, 0x24, 0x14, 0x52, 0x2A, 0xAA, 0xAA, 0x2A, 0x52, 0x14, 0x24, 0x08,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00,
+};
+const GrayOLED_icon wifiIcon = {wifiBitmap, 12, 12};
+
+// rain: 12x12
+//   ....####....
+//   ..##....##..
+//   .#........#.
+//   #..........#
+//   #..........#
+//   .##########.
+//   ............
+//   ..#...#...#.
+//   .#...#...#..
+//   ............
+//   ...#...#....
+//   ..#...#.....
+const uint8_t rainBitmap[] PROGMEM = {
+    0x18, 0x24, 0xA2, 0x22, 0x21, 0x21, 0xA1, 0x21, 0x22, 0x22, 0xA4, 0x18,
+    0x00, 0x01, 0x08, 0x04, 0x00, 0x01, 0x08, 0x04, 0x00, 0x01, 0x00, 0x00,
+};
+const GrayOLED_icon rainIcon = {rainBitmap, 12, 12};
+
+// windowOpen: 12x12
+//   ############
+//   #.........##
+//   #........#.#
+//   #.......#..#
+//   #......#...#
+//   #......#...#
+//   #......#...#
+//   #......#...#
+//   #.......#..#
+//   #........#.#
+//   #.........##
+//   ############
+const uint8_t windowOpenBitmap[] PROGMEM = {
+    0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xF1, 0x09, 0x05, 0x03, 0xFF,
+    0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x09, 0x0A, 0x0C, 0x0F,
+};
+const GrayOLED_icon windowOpenIcon = {windowOpenBitmap, 12, 12};
+
+// windowClosed: 12x12
+//   ############
+//   #....#.....#
+//   #....#.....#
+//   #....#.....#
+//   #....#.....#
+//   ############
+//   #....#.....#
+//   #....#.....#
+//   #....#.....#
+//   #....#.....#
+//   #....#.....#
+//   ############
+const uint8_t windowClosedBitmap[] PROGMEM = {
+    0xFF, 0x21, 0x21, 0x21, 0x21, 0xFF, 0x21, 0x21, 0x21, 0x21, 0x21, 0xFF,
+    0x0F, 0x08, 0x08, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0F,
+};
+const GrayOLED_icon windowClosedIcon = {windowClosedBitmap, 12, 12};
+
+// alarm: 12x12
+//   .....##.....
+//   ....####....
+//   ...######...
+//   ..########..
+//   ..########..
+//   ..########..
+//   ..########..
+//   .##########.
+//   ############
+//   ............
+//   .....##.....
+//   ............
+const uint8_t alarmBitmap[] PROGMEM = {
+    0x00, 0x80, 0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFE, 0xFC, 0xF8, 0x80, 0x00,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x05, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01,
+};
+const GrayOLED_icon alarmIcon = {alarmBitmap, 12, 12};
+
+
+#endif // ICONS_H
@@ -0,0 +1,196 @@
+// IsrQueue.h
+
+#ifndef ISR_QUEUE_H
+#define ISR_QUEUE_H
+
+#include "SpscQueue.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#endif
+
+
+/** Interrupt-safe queue:
+ *
+ * Same interface as SpscQueue (see SpscQueue.h), but every call may come
+ * from an interrupt handler or any task, on either core, producers and
+ * consumers alike. Each call shuts out the others for the few
+ * instructions it takes to move the indices:
+ *
+ *    ESP32   : a spinlock with interrupts off on this core
+ *    ESP8266 : interrupts off
+ *    host    : a spinlock (no interrupts there)
+ *    others  : interrupts off
+ *
+ * The methods are placed in IRAM where the platform has it, so they can be
+ * called from handlers that run while the flash cache is off.
+ *
+ * reserve()/commit() and peek()/release() hold the lock from the first
+ * call to the second, so keep what happens in between short.
+ *
+ * Example:
+ *
+ *    IsrQueue<uint16_t, 32> rainSamples;
+ *
+ *    void IRAM_ATTR rainTimerISR() {
+ *      rainSamples.push(analogReadRaw());
+ *    }
+ *
+ *    // in loop()
+ *    uint16_t batch[32];
+ *    uint16_t n = rainSamples.pop(batch, 32);
+ */
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ESP8266)
+#define QUEUE_ISR_ATTR IRAM_ATTR
+#else
+#define QUEUE_ISR_ATTR
+#endif
+
+template <typename T, uint16_t N>
+class IsrQueue {
+  static_assert(N && !(N & (N - 1)), "IsrQueue size must be a power of two");
+
+public:
+  /** push() - Adds an item. False (and counted) if the queue is full */
+  QUEUE_ISR_ATTR bool push(const T &item) {
+    lock();
+    bool ok = head - tail < N;
+    if (ok) {
+      items[head++ & (N - 1)] = item;
+      noteSize();
+    } else {
+      drops++;
+    }
+    unlock();
+    return ok;
+  }
+
+  /** push() - Adds up to count items in one go. Returns how many fit */
+  QUEUE_ISR_ATTR uint16_t push(const T *from, uint16_t count) {
+    lock();
+    uint16_t n = N - (head - tail);
+    if (n > count) {
+      n = count;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+      items[head++ & (N - 1)] = from[i];
+    }
+    drops += count - n;
+    noteSize();
+    unlock();
+    return n;
+  }
+
+  /** reserve() - The next free slot to fill in place, NULL (and unlocked)
+   *  if full. Locked until commit() */
+  QUEUE_ISR_ATTR T *reserve() {
+    lock();
+    if (head - tail == N) {
+      drops++;
+      unlock();
+      return NULL;
+    }
+    return &items[head & (N - 1)];
+  }
+
+  /** commit() - Hands the slot from reserve() to the consumers */
+  QUEUE_ISR_ATTR void commit(T *slot) {
+    (void)slot;
+    head++;
+    noteSize();
+    unlock();
+  }
+
+  /** pop() - Takes the oldest item. False if the queue is empty */
+  QUEUE_ISR_ATTR bool pop(T &item) {
+    lock();
+    bool ok = head != tail;
+    if (ok) {
+      item = items[tail++ & (N - 1)];
+    }
+    unlock();
+    return ok;
+  }
+
+  /** pop() - Takes up to count items in one go. Returns how many */
+  QUEUE_ISR_ATTR uint16_t pop(T *to, uint16_t count) {
+    lock();
+    uint16_t n = head - tail;
+    if (n > count) {
+      n = count;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+      to[i] = items[tail++ & (N - 1)];
+    }
+    unlock();
+    return n;
+  }
+
+  /** peek() - The oldest item, read in place, NULL (and unlocked) if the
+   *  queue is empty. Locked until release() */
+  QUEUE_ISR_ATTR const T *peek() {
+    lock();
+    if (head == tail) {
+      unlock();
+      return NULL;
+    }
+    return &items[tail & (N - 1)];
+  }
+
+  /** release() - Frees the slot peek() returned */
+  QUEUE_ISR_ATTR void release() {
+    tail++;
+    unlock();
+  }
+
+  uint16_t size() const { return (uint16_t)(head - tail); }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == N; }
+  static uint16_t capacity() { return N; }
+  uint16_t highWater() const { return peak; }
+  uint32_t dropped() const { return drops; }
+  void resetStats() {
+    lock();
+    peak = 0;
+    drops = 0;
+    unlock();
+  }
+
+private:
+#if defined(ARDUINO_ARCH_ESP32)
+  QUEUE_ISR_ATTR void lock() { portENTER_CRITICAL_SAFE(&mux); }
+  QUEUE_ISR_ATTR void unlock() { portEXIT_CRITICAL_SAFE(&mux); }
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#elif defined(ESP8266)
+  QUEUE_ISR_ATTR void lock() { saved = xt_rsil(15); }
+  QUEUE_ISR_ATTR void unlock() { xt_wsr_ps(saved); }
+  uint32_t saved;                     // Interrupt level to go back to
+#elif defined(QUEUE_HOST)
+  void lock() {
+    while (busy.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  void unlock() { busy.clear(std::memory_order_release); }
+  std::atomic_flag busy = ATOMIC_FLAG_INIT;
+#else
+  void lock() { noInterrupts(); }
+  void unlock() { interrupts(); }
+#endif
+
+  QUEUE_ISR_ATTR void noteSize() {
+    if ((uint16_t)(head - tail) > peak) {
+      peak = head - tail;
+    }
+  }
+
+  volatile uint32_t head = 0;         // Next slot to fill, free running
+  volatile uint32_t tail = 0;         // Next slot to empty
+  volatile uint16_t peak = 0;
+  volatile uint32_t drops = 0;
+  T items[N];
+};
+
+
+
+#endif // ISR_QUEUE_H
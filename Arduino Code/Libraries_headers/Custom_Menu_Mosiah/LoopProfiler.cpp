@@ -0,0 +1,238 @@
+// LoopProfiler.cpp
+#include "LoopProfiler.h"
+
+#ifdef LOOP_PROFILE
+
+#if defined(ARDUINO_ARCH_ESP32)
+static portMUX_TYPE loopProfilerMux = portMUX_INITIALIZER_UNLOCKED;
+#define LOOP_PROFILE_LOCK() portENTER_CRITICAL(&loopProfilerMux)
+#define LOOP_PROFILE_UNLOCK() portEXIT_CRITICAL(&loopProfilerMux)
+#else
+#define LOOP_PROFILE_LOCK()
+#define LOOP_PROFILE_UNLOCK()
+#endif
+
+
+LoopProfiler loopProfiler;
+
+
+/**
+ * begin() - Calibrates the clock, clears the stats and starts timing
+ *
+ * Phases already named keep their ids.
+ */
+void LoopProfiler::begin() {
+#if defined(ARDUINO_ARCH_ESP32)
+  ticksPerUs = getCpuFrequencyMhz();
+#elif defined(ESP8266)
+  ticksPerUs = ESP.getCpuFreqMHz();
+#elif defined(LOOP_PROFILE_CHRONO)
+  ticksPerUs = 1000;
+#else
+  ticksPerUs = 1;
+#endif
+
+  // What a scope with nothing in it reads as: the cheapest of a few tries
+  overhead = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < 16; i++) {
+    uint32_t start = now();
+    uint32_t ticks = now() - start;
+    if (ticks < overhead) {
+      overhead = ticks;
+    }
+  }
+
+  reset();
+  running = true;
+}
+
+/**
+ * reset() - Clears the stats of every phase
+ */
+void LoopProfiler::reset() {
+  for (uint8_t i = 0; i < phaseCount; i++) {
+    const char *name = phaseStats[i].name;
+    memset(&phaseStats[i], 0, sizeof(LoopPhaseStats));
+    phaseStats[i].name = name;
+  }
+  started = lastDue = millis();
+}
+
+/**
+ * end() - Stops timing; what was gathered stays for report()
+ */
+void LoopProfiler::end() {
+  running = false;
+}
+
+/**
+ * phase() - Looks up the id of a phase, adding it on first use
+ * @param name - Name of the phase, kept by pointer
+ *
+ * Returns LOOP_PROFILE_PHASES, which record() ignores, once all phases
+ * are in use.
+ */
+uint8_t LoopProfiler::phase(const char *name) {
+  LOOP_PROFILE_LOCK();
+  uint8_t id = LOOP_PROFILE_PHASES;
+  for (uint8_t i = 0; i < phaseCount; i++) {
+    if (phaseStats[i].name == name || !strcmp(phaseStats[i].name, name)) {
+      id = i;
+      break;
+    }
+  }
+  if (id == LOOP_PROFILE_PHASES && phaseCount < LOOP_PROFILE_PHASES) {
+    id = phaseCount;
+    phaseStats[id].name = name;
+    phaseCount++;
+  }
+  LOOP_PROFILE_UNLOCK();
+  return id;
+}
+
+/**
+ * record() - Adds one run of a phase
+ * @param id - The phase
+ * @param ticks - How long it took, in ticks of now()
+ */
+void LoopProfiler::record(uint8_t id, uint32_t ticks) {
+  if (!running || id >= phaseCount) {
+    return;
+  }
+  ticks = ticks > overhead ? ticks - overhead : 0;
+
+  LoopPhaseStats &p = phaseStats[id];
+  p.count++;
+  p.total += ticks;
+  if (ticks > p.worst) {
+    p.worst = ticks;
+    p.worstAt = millis();
+  }
+  uint32_t us = ticks / ticksPerUs;
+  uint8_t bucket = us ? 32 - __builtin_clz(us) : 0;
+  p.buckets[bucket < LOOP_PROFILE_BUCKETS ? bucket : LOOP_PROFILE_BUCKETS - 1]++;
+}
+
+/**
+ * percentile() - How long percent of the runs of a phase took at most
+ * @param id - The phase
+ * @param percent - 1..100
+ *
+ * Returns the upper end of the histogram bucket it falls in, in us, so
+ * it may be up to twice the real value, but never more than the worst
+ * time (which is also returned for the last bucket, having no upper end).
+ */
+uint32_t LoopProfiler::percentile(uint8_t id, uint8_t percent) const {
+  const LoopPhaseStats &p = phaseStats[id];
+  uint32_t target = ((uint64_t)p.count * percent + 99) / 100;
+  uint32_t worst = micros(p.worst);
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < LOOP_PROFILE_BUCKETS - 1; b++) {
+    seen += p.buckets[b];
+    if (seen >= target) {
+      return min(1UL << b, (unsigned long)worst);
+    }
+  }
+  return worst;
+}
+
+/**
+ * due() - Says when it is time to send a report
+ * @param interval - ms between reports
+ *
+ * Returns true once every interval ms.
+ */
+bool LoopProfiler::due(uint32_t interval) {
+  uint32_t ms = millis();
+  if (ms - lastDue < interval) {
+    return false;
+  }
+  lastDue = ms;
+  return true;
+}
+
+/**
+ * report() - Prints every phase with its times and histogram
+ * @param out - Where to, e.g. Serial
+ *
+ * One line per phase: runs, average, median, 99th percentile and worst
+ * time in us with the millis() of the worst run. Below it the histogram
+ * from the first to the last used bucket, each count labelled with the
+ * bucket's lower end in us.
+ */
+void LoopProfiler::report(Print &out) {
+  out.print("loop profile, ");
+  out.print(millis() - started);
+  out.println(" ms");
+  out.println("phase         runs    avg us    p50 us    p99 us  worst us    at ms");
+
+  for (uint8_t i = 0; i < phaseCount; i++) {
+    const LoopPhaseStats &p = phaseStats[i];
+    char line[80];
+    snprintf(line, sizeof(line), "%-10s %7lu %9lu %9lu %9lu %9lu %8lu",
+             p.name, (unsigned long)p.count,
+             (unsigned long)(p.count ? p.total / p.count / ticksPerUs : 0),
+             (unsigned long)percentile(i, 50), (unsigned long)percentile(i, 99),
+             (unsigned long)micros(p.worst), (unsigned long)p.worstAt);
+    out.println(line);
+
+    int8_t first = -1, last = -1;
+    for (uint8_t b = 0; b < LOOP_PROFILE_BUCKETS; b++) {
+      if (p.buckets[b]) {
+        if (first < 0) {
+          first = b;
+        }
+        last = b;
+      }
+    }
+    if (first < 0) {
+      continue;
+    }
+    out.print("          ");
+    for (int8_t b = first; b <= last; b++) {
+      out.print(' ');
+      out.print(b ? 1UL << (b - 1) : 0);
+      out.print(':');
+      out.print(p.buckets[b]);
+    }
+    out.println();
+  }
+}
+
+/**
+ * summary() - Writes one short line with the average and worst time of
+ *             every phase that ran, in ms
+ * @param buf - Where to, LOOP_PROFILE_SUMMARY bytes fit every phase
+ * @param len - Size of buf
+ *
+ * e.g. "loop 1.2/48.0 sinric 0.4/45.1 dht 0.0/4.9 oled 0.7/1.1"
+ * Phases that don't fit are left out. Returns the length written.
+ */
+size_t LoopProfiler::summary(char *buf, size_t len) {
+  size_t used = 0;
+  if (!len) {
+    return 0;
+  }
+  buf[0] = '\0';
+  for (uint8_t i = 0; i < phaseCount; i++) {
+    const LoopPhaseStats &p = phaseStats[i];
+    if (!p.count) {
+      continue;
+    }
+    // Tenths of a ms
+    uint32_t avg = p.total / p.count / ticksPerUs / 100;
+    uint32_t worst = micros(p.worst) / 100;
+    int n = snprintf(buf + used, len - used, "%s%s %lu.%lu/%lu.%lu",
+                     used ? " " : "", p.name,
+                     (unsigned long)avg / 10, (unsigned long)avg % 10,
+                     (unsigned long)worst / 10, (unsigned long)worst % 10);
+    if (n < 0 || used + n >= len) {
+      buf[used] = '\0';       // Didn't fit, drop the partial entry
+      break;
+    }
+    used += n;
+  }
+  return used;
+}
+
+#endif // LOOP_PROFILE
@@ -0,0 +1,148 @@
+// LoopProfiler.h
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(ESP8266) && \
+    (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#define LOOP_PROFILE_CHRONO           // Host bench: time with steady_clock
+#include <chrono>
+#endif
+
+
+/** Loop phase profiler:
+ *
+ * Times the phases of loop() (SinricPro.handle(), the DHT read, the OLED
+ * flush, the keypad poll, ...) with a scoped timer, so it shows which one
+ * is eating the loop budget. Per phase it keeps the count, the total and
+ * worst time with the millis() it happened at, and a histogram with one
+ * bucket per power of two microseconds:
+ *
+ *    bucket 0 : under 1 us
+ *    bucket n : 2^(n-1) us up to 2^n us
+ *    last     : everything longer
+ *
+ * Time is read from the CPU cycle counter on ESP32 and ESP8266, from
+ * steady_clock on the host bench, and from micros() elsewhere. begin()
+ * measures what an empty scope costs and takes it off every reading.
+ * A scope costs two counter reads and a few adds, well under 1% of a loop
+ * that does any I/O; without LOOP_PROFILE the scopes compile to nothing.
+ *
+ * The drivers time their own hot paths when LOOP_PROFILE is defined for
+ * the whole build: "sinric" (SinricPro.handle()), "dht" (a sensor read),
+ * "oled" (SH110X display()) and "keypad" (TCA8418 available() and
+ * drain()).
+ *
+ * report() prints the full table to Serial, summary() writes a line short
+ * enough for the Test menu screen or a SinricPro push notification.
+ *
+ * Example:
+ *
+ *    void setup() {
+ *    #ifdef LOOP_PROFILE
+ *      loopProfiler.begin();
+ *    #endif
+ *    }
+ *
+ *    void loop() {
+ *      LOOP_PROFILE_SCOPE("loop");       // the whole pass
+ *      SinricPro.handle();               // timed as "sinric"
+ *      {
+ *        LOOP_PROFILE_SCOPE("rain");     // a phase of the sketch's own
+ *        readRainSensor();
+ *      }
+ *    #ifdef LOOP_PROFILE
+ *      if (loopProfiler.due(3600000)) {  // once an hour
+ *        char line[LOOP_PROFILE_SUMMARY];
+ *        loopProfiler.summary(line, sizeof(line));
+ *        monitor.sendPushNotification(line);
+ *      }
+ *    #endif
+ *    }
+ *
+ * Phases are meant to be timed from one task each; two tasks timing the
+ * same phase at once can lose counts.
+ */
+
+#define LOOP_PROFILE_PHASES 8         // Phases that can be named
+#define LOOP_PROFILE_BUCKETS 20       // Histogram buckets, the last is >= 262 ms
+#define LOOP_PROFILE_SUMMARY 120      // Bytes summary() needs for every phase
+
+#ifdef LOOP_PROFILE
+#define LOOP_PROFILE_JOIN2(a, b) a##b
+#define LOOP_PROFILE_JOIN(a, b) LOOP_PROFILE_JOIN2(a, b)
+// The phase is looked up once, on the first pass through the scope
+#define LOOP_PROFILE_SCOPE(name)                                              \
+  static uint8_t LOOP_PROFILE_JOIN(loopPhase, __LINE__) = loopProfiler.phase(name); \
+  LoopProfileScope LOOP_PROFILE_JOIN(loopScope, __LINE__)(LOOP_PROFILE_JOIN(loopPhase, __LINE__))
+#else
+#define LOOP_PROFILE_SCOPE(name)
+#endif
+
+struct LoopPhaseStats {
+  const char *name;
+  uint32_t count;           // Times the phase ran
+  uint64_t total;           // Summed ticks
+  uint32_t worst;           // Longest run, ticks
+  uint32_t worstAt;         // millis() when the longest run ended
+  uint32_t buckets[LOOP_PROFILE_BUCKETS];
+};
+
+class LoopProfiler {
+public:
+  void begin();                         // Calibrate, clear the stats and start
+  void reset();                         // Clear the stats
+  void end();                           // Stop; stats stay for report()
+  bool active() const { return running; }
+
+  uint8_t phase(const char *name);      // Id of a phase, added on first use
+  uint8_t phases() const { return phaseCount; }
+  const LoopPhaseStats &stats(uint8_t id) const { return phaseStats[id]; }
+
+  static inline uint32_t now() {        // Ticks of the profiler clock
+#if defined(ARDUINO_ARCH_ESP32) || defined(ESP8266)
+    return ESP.getCycleCount();
+#elif defined(LOOP_PROFILE_CHRONO)
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    return ::micros();
+#endif
+  }
+  void record(uint8_t id, uint32_t ticks);
+  uint32_t micros(uint32_t ticks) const { return ticks / ticksPerUs; }
+  uint32_t percentile(uint8_t id, uint8_t percent) const;  // Upper bound, us
+
+  bool due(uint32_t interval);          // True once every interval ms
+  void report(Print &out);              // Full table
+  size_t summary(char *buf, size_t len);  // One line: phase avg/worst ms
+
+protected:
+  // No constructor, so phases named before begin() are kept. Phase ids
+  // are cached where they are used, so phases are never forgotten.
+  bool running;
+  uint32_t started;                     // millis() of begin()/reset()
+  uint32_t lastDue;
+  uint32_t ticksPerUs;
+  uint32_t overhead;                    // Ticks an empty scope reads as
+  LoopPhaseStats phaseStats[LOOP_PROFILE_PHASES];
+  uint8_t phaseCount;
+};
+
+extern LoopProfiler loopProfiler;
+
+/** Times its own lifetime as one run of a phase */
+class LoopProfileScope {
+public:
+  LoopProfileScope(uint8_t phase) : id(phase), start(LoopProfiler::now()) {}
+  ~LoopProfileScope() { loopProfiler.record(id, LoopProfiler::now() - start); }
+private:
+  uint8_t id;
+  uint32_t start;
+};
+
+
+
+#endif // LOOP_PROFILER_H
@@ -1,5 +1,6 @@
 // Menu.cpp
 #include "Menu.h"
+#include "HeapTrace.h"
 
 
 // Global pointer to the current menu
@@ -138,6 +139,7 @@ void back() {
  * 
  */
 void printMenuStatus(Menu* menu) {
+  HEAP_TRACE_SCOPE("menu");
   if (menu != NULL) {
     Serial.println("Menu Title: " + menu->title);
     Serial.println("Current Selection: " + String(menu->currentSelection));
@@ -152,6 +154,7 @@ void printMenuStatus(Menu* menu) {
 }
 
 void printMenu(Menu menu) {
+  HEAP_TRACE_SCOPE("menu");
   Serial.println("Title: " + menu.title);
   Serial.println("Choices:");
   for (const auto& choice : menu.choices) {
@@ -45,6 +45,7 @@
  *    Stepper Motor : Open/Close window
  *    Alarm : Trigger alarm
  *    LEDs : Toggle LEDs
+ *    Profiler : Show loop phase timings (LOOP_PROFILE builds, see LoopProfiler.h)
  *    Exit : Exit to main menu
  * 
  */
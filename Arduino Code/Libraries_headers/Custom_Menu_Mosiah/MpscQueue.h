@@ -0,0 +1,179 @@
+// MpscQueue.h
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "SpscQueue.h"
+
+
+/** Multiple producer, single consumer queue:
+ *
+ * Same interface as SpscQueue (see SpscQueue.h), for when several tasks
+ * feed one consumer, e.g. SinricPro's send queue, which every task that
+ * reports an event pushes to. Producers claim slots by moving head with a
+ * compare-and-swap; each slot carries a sequence number that says whether
+ * it is free, being filled or ready, so no producer waits on another and
+ * the consumer never takes a half written item.
+ *
+ * A slot taken by reserve() holds back the consumer at that point until it
+ * is committed, even if later slots are ready, so fill reserved slots
+ * without delay.
+ *
+ * Not for interrupt handlers: a producer interrupted between claiming and
+ * filling its slot would stall the consumer until it resumes. Use IsrQueue
+ * there.
+ */
+
+template <typename T, uint16_t N>
+class MpscQueue {
+  static_assert(N && !(N & (N - 1)), "MpscQueue size must be a power of two");
+
+public:
+  MpscQueue() {
+    for (uint16_t i = 0; i < N; i++) {
+      seq[i].store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /* Producer side, any task */
+
+  /** push() - Adds an item. False (and counted) if the queue is full */
+  bool push(const T &item) {
+    T *slot = claim(1);
+    if (!slot) {
+      drops.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    *slot = item;
+    commit(slot);
+    return true;
+  }
+
+  /** push() - Adds up to count items, next to each other in the queue.
+   *  Returns how many fit */
+  uint16_t push(const T *from, uint16_t count) {
+    uint16_t n = count < N ? count : N;
+    T *slot = NULL;
+    while (n && !(slot = claim(n))) {
+      n--;                    // Not that much room, try for less
+    }
+    uint32_t first = slot ? slot - items : 0;
+    for (uint16_t i = 0; i < n; i++) {
+      T *s = &items[(first + i) & (N - 1)];
+      *s = from[i];
+      commit(s);
+    }
+    if (n < count) {
+      drops.fetch_add(count - n, std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  /** reserve() - Claims the next free slot to fill in place, NULL if full */
+  T *reserve() {
+    T *slot = claim(1);
+    if (!slot) {
+      drops.fetch_add(1, std::memory_order_relaxed);
+    }
+    return slot;
+  }
+
+  /** commit() - Hands a slot from reserve() to the consumer */
+  void commit(T *slot) {
+    std::atomic<uint32_t> &s = seq[slot - items];
+    s.store(s.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /* Consumer side, one task */
+
+  /** pop() - Takes the oldest item. False if the queue is empty */
+  bool pop(T &item) {
+    const T *slot = peek();
+    if (!slot) {
+      return false;
+    }
+    item = *slot;
+    release();
+    return true;
+  }
+
+  /** pop() - Takes up to count items. Returns how many */
+  uint16_t pop(T *to, uint16_t count) {
+    uint16_t n = 0;
+    while (n < count && pop(to[n])) {
+      n++;
+    }
+    return n;
+  }
+
+  /** peek() - The oldest item, read in place, NULL if none is ready */
+  const T *peek() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (seq[t & (N - 1)].load(std::memory_order_acquire) != t + 1) {
+      return NULL;
+    }
+    return &items[t & (N - 1)];
+  }
+
+  /** release() - Frees the slot peek() returned */
+  void release() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    seq[t & (N - 1)].store(t + N, std::memory_order_release);
+    tail.store(t + 1, std::memory_order_release);
+  }
+
+  /* Either side */
+
+  uint16_t size() const {
+    return (uint16_t)(head.load(std::memory_order_acquire) -
+                      tail.load(std::memory_order_acquire));
+  }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == N; }
+  static uint16_t capacity() { return N; }
+  uint16_t highWater() const { return peak.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return drops.load(std::memory_order_relaxed); }
+  void resetStats() {
+    peak.store(0, std::memory_order_relaxed);
+    drops.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  // Claims count slots in a row for this producer, NULL if they are not
+  // all free. Slots are freed in order, so the last one being free means
+  // all are.
+  T *claim(uint16_t count) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    for (;;) {
+      uint32_t last = h + count - 1;
+      int32_t diff = (int32_t)(seq[last & (N - 1)].load(std::memory_order_acquire) - last);
+      if (diff == 0) {
+        if (head.compare_exchange_weak(h, h + count, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return NULL;          // Still in use from the last lap: full
+      } else {
+        h = head.load(std::memory_order_relaxed);   // Another producer got it
+      }
+    }
+
+    uint16_t used = h + count - tail.load(std::memory_order_relaxed);
+    uint16_t high = peak.load(std::memory_order_relaxed);
+    while (used > high &&
+           !peak.compare_exchange_weak(high, used, std::memory_order_relaxed)) {
+    }
+    return &items[h & (N - 1)];
+  }
+
+  alignas(QUEUE_CACHE_LINE) std::atomic<uint32_t> head{0};  // Next slot to claim, free running
+  std::atomic<uint16_t> peak{0};
+  std::atomic<uint32_t> drops{0};
+  alignas(QUEUE_CACHE_LINE) std::atomic<uint32_t> tail{0};  // Next slot to empty
+  alignas(QUEUE_CACHE_LINE) std::atomic<uint32_t> seq[N];   // pos: free, pos + 1: ready
+  T items[N];
+};
+
+
+
+#endif // MPSC_QUEUE_H
@@ -0,0 +1,322 @@
+// OtaUpdate.cpp
+#include "OtaUpdate.h"
+
+
+static inline uint32_t get32(const uint8_t *p) {
+  return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+         (uint32_t)p[3] << 24;
+}
+
+static inline void put32(uint8_t *p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+
+/* EspOtaFlash */
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+EspOtaFlash::EspOtaFlash()
+  : partition(NULL), handle(0) {}
+
+/**
+ * begin() - Opens the partition after the running one
+ * @param size - Bytes in the image
+ *
+ * Nothing is erased up front where the IDF can erase as it goes; erasing
+ * a whole 1.5 MB partition at once would stop everything for seconds.
+ */
+bool EspOtaFlash::begin(uint32_t size) {
+  partition = esp_ota_get_next_update_partition(NULL);
+  if (!partition || size > partition->size) {
+    return false;
+  }
+#if defined(OTA_WITH_SEQUENTIAL_WRITES)
+  return esp_ota_begin(partition, OTA_WITH_SEQUENTIAL_WRITES, &handle) == ESP_OK;
+#else
+  return esp_ota_begin(partition, size, &handle) == ESP_OK;
+#endif
+}
+
+bool EspOtaFlash::write(const uint8_t *data, size_t len) {
+  return esp_ota_write(handle, data, len) == ESP_OK;
+}
+
+/**
+ * activate() - Checks the image header and boots the partition next time
+ */
+bool EspOtaFlash::activate() {
+  esp_err_t err = esp_ota_end(handle);
+  handle = 0;
+  return err == ESP_OK && esp_ota_set_boot_partition(partition) == ESP_OK;
+}
+
+void EspOtaFlash::abort() {
+  if (handle) {
+#if defined(ESP_IDF_VERSION) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 3, 0)
+    esp_ota_abort(handle);
+#else
+    esp_ota_end(handle);
+#endif
+    handle = 0;
+  }
+}
+
+
+/* EspOtaVerifier */
+
+/**
+ * EspOtaVerifier() - Checks images against a public key
+ * @param publicKey - PEM text of an EC (P-256) or RSA key, kept by pointer
+ */
+EspOtaVerifier::EspOtaVerifier(const char *publicKey)
+  : publicKey(publicKey) {}
+
+/**
+ * verify() - Checks a DER ECDSA or PKCS#1 RSA signature of hash
+ *
+ * The key is parsed on each call; there is one call per update, and no
+ * mbedTLS context is held between updates.
+ */
+bool EspOtaVerifier::verify(const uint8_t hash[SHA256_SIZE],
+                            const uint8_t *signature, size_t len) {
+  mbedtls_pk_context pk;
+  mbedtls_pk_init(&pk);
+  int err = mbedtls_pk_parse_public_key(&pk, (const unsigned char *)publicKey,
+                                        strlen(publicKey) + 1);
+  if (!err) {
+    err = mbedtls_pk_verify(&pk, MBEDTLS_MD_SHA256, hash, SHA256_SIZE,
+                            signature, len);
+  }
+  mbedtls_pk_free(&pk);
+  return err == 0;
+}
+
+#endif
+
+
+/* OtaUpdate */
+
+/**
+ * OtaUpdate() - Nothing is accepted until begin()
+ * @param flash - Where images go
+ * @param verifier - Checks their signatures
+ */
+OtaUpdate::OtaUpdate(OtaFlash &flash, OtaVerifier &verifier)
+  : flash(flash), verifier(verifier), running(0), send(NULL),
+    interval(OTA_WRITE_INTERVAL), current(OTA_IDLE), lastError(OTA_OK),
+    imageSize(0), imageVersion(0), received(0), flashed(0), lastFrame(0),
+    lastWrite(0), pending(0) {}
+
+/**
+ * begin() - Starts taking updates
+ * @param version - Version of the running firmware; only newer images
+ *                  are taken
+ * @param send - Sends a binary frame back over the WebSocket
+ */
+void OtaUpdate::begin(uint32_t version, OtaSend send) {
+  running = version;
+  this->send = send;
+}
+
+/**
+ * setThrottle() - Sets the least time between two flash writes
+ * @param interval - ms; 0 writes each chunk as soon as it arrives
+ *
+ * The download then runs at no more than OTA_CHUNK bytes per interval.
+ */
+void OtaUpdate::setThrottle(uint16_t interval) {
+  this->interval = interval;
+}
+
+/**
+ * receive() - Takes a binary frame from the server
+ * @param frame - The frame, valid only during the call
+ * @param len - Its length
+ *
+ * Frames before begin() are ignored, so an image can't be pushed to a
+ * device that has not opted in.
+ */
+void OtaUpdate::receive(const uint8_t *frame, size_t len) {
+  if (!len || !send) {
+    return;
+  }
+  lastFrame = millis();
+
+  switch (frame[0]) {
+  case 'B':
+    if (len == 9) {
+      start(get32(frame + 1), get32(frame + 5));
+      return;
+    }
+    break;
+  case 'D':
+    if (len > 5) {
+      chunk(get32(frame + 1), frame + 5, len - 5);
+      return;
+    }
+    break;
+  case 'F':
+    if (len > 1 && len <= 1 + OTA_SIGNATURE_MAX) {
+      finish(frame + 1, len - 1);
+      return;
+    }
+    break;
+  case 'X':
+    if (current == OTA_RECEIVING) {
+      fail(OTA_ERR_ABORTED);
+    }
+    return;
+  }
+  fail(OTA_ERR_SEQUENCE);
+}
+
+/**
+ * update() - Writes the waiting chunk once the throttle allows
+ *
+ * Call it often from the loop that handles the WebSocket. Each call does
+ * at most one flash write of at most OTA_CHUNK bytes.
+ */
+void OtaUpdate::update() {
+  if (current != OTA_RECEIVING) {
+    return;
+  }
+  uint32_t now = millis();
+  if (now - lastFrame > OTA_TIMEOUT) {
+    fail(OTA_ERR_TIMEOUT);
+    return;
+  }
+  if (!pending || now - lastWrite < interval) {
+    return;
+  }
+
+  if (!flash.write(buffer, pending)) {
+    fail(OTA_ERR_FLASH);
+    return;
+  }
+  sha.update(buffer, pending);
+  flashed += pending;
+  pending = 0;
+  lastWrite = now;
+  acknowledge();
+}
+
+/**
+ * abort() - Abandons the update in progress and tells the server
+ */
+void OtaUpdate::abort() {
+  if (current == OTA_RECEIVING) {
+    fail(OTA_ERR_ABORTED);
+  }
+}
+
+// 'B': opens the free slot for a new image, dropping any unfinished one
+void OtaUpdate::start(uint32_t size, uint32_t version) {
+  if (current == OTA_RECEIVING) {
+    flash.abort();
+  }
+  if (version <= running) {
+    current = OTA_FAILED;
+    fail(OTA_ERR_VERSION);
+    return;
+  }
+  if (!size || !flash.begin(size)) {
+    current = OTA_FAILED;
+    fail(OTA_ERR_SIZE);
+    return;
+  }
+  current = OTA_RECEIVING;
+  lastError = OTA_OK;
+  imageSize = size;
+  imageVersion = version;
+  received = flashed = 0;
+  pending = 0;
+  lastWrite = millis() - interval;
+  sha.begin();
+  acknowledge();
+}
+
+// 'D': keeps the chunk for update(), or answers a repeat
+void OtaUpdate::chunk(uint32_t offset, const uint8_t *data, size_t len) {
+  if (current != OTA_RECEIVING) {
+    fail(OTA_ERR_SEQUENCE);
+    return;
+  }
+  if (offset + len == received) {
+    if (!pending) {
+      acknowledge();        // Our 'A' got lost, the chunk is in already
+    }
+    return;
+  }
+  if (offset != received || pending || len > OTA_CHUNK ||
+      len > imageSize - received) {
+    fail(OTA_ERR_SEQUENCE);
+    return;
+  }
+  memcpy(buffer, data, len);
+  pending = len;
+  received += len;
+}
+
+// 'F': checks the signature and switches slots if it is good
+void OtaUpdate::finish(const uint8_t *signature, size_t len) {
+  if (current != OTA_RECEIVING) {
+    fail(OTA_ERR_SEQUENCE);
+    return;
+  }
+  if (pending || flashed != imageSize) {
+    fail(OTA_ERR_LENGTH);
+    return;
+  }
+
+  uint8_t message[SHA256_SIZE + 8], hash[SHA256_SIZE];
+  sha.finish(message);
+  put32(message + SHA256_SIZE, imageSize);
+  put32(message + SHA256_SIZE + 4, imageVersion);
+  sha.begin();
+  sha.update(message, sizeof(message));
+  sha.finish(hash);
+
+  if (!verifier.verify(hash, signature, len)) {
+    fail(OTA_ERR_SIGNATURE);
+    return;
+  }
+  if (!flash.activate()) {
+    fail(OTA_ERR_FLASH);
+    return;
+  }
+
+  current = OTA_DONE;
+  uint8_t frame[1] = {'K'};
+  reply(frame, sizeof(frame));
+}
+
+// Drops the image and tells the server why
+void OtaUpdate::fail(OtaError error) {
+  if (current == OTA_RECEIVING) {
+    flash.abort();
+    current = OTA_FAILED;
+  }
+  lastError = error;
+  pending = 0;
+  uint8_t frame[2] = {'E', (uint8_t)error};
+  reply(frame, sizeof(frame));
+}
+
+// 'A': everything below flashed is written, send the next chunk
+void OtaUpdate::acknowledge() {
+  uint8_t frame[7] = {'A'};
+  put32(frame + 1, flashed);
+  frame[5] = OTA_CHUNK & 0xFF;
+  frame[6] = OTA_CHUNK >> 8;
+  reply(frame, sizeof(frame));
+}
+
+void OtaUpdate::reply(const uint8_t *frame, size_t len) {
+  if (send) {
+    send(frame, len);
+  }
+}
@@ -0,0 +1,217 @@
+// OtaUpdate.h
+
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <Arduino.h>
+#include "Sha256.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_ota_ops.h>
+#include <mbedtls/pk.h>
+#endif
+
+
+/** Firmware update over the WebSocket:
+ *
+ * Takes a new firmware image in binary frames over the connection
+ * SinricPro already keeps open, and writes it chunk by chunk into the
+ * flash slot that is not running. Each chunk is hashed as it is written;
+ * at the end the image's signature is checked and only then is the new
+ * slot made the one to boot. A failed or abandoned update leaves the
+ * running firmware as it was.
+ *
+ * What is signed is the image, its size and its version number:
+ *
+ *    SHA-256( SHA-256(image) size:4 version:4 )
+ *
+ * On the ESP32, EspOtaVerifier checks an ECDSA (or RSA) signature against
+ * a public key built into the firmware, so nothing on the device can sign
+ * an image. Only images newer than the running firmware are taken, which
+ * stops an old signed image from being replayed to downgrade a device.
+ *
+ * Never more than one chunk (OTA_CHUNK bytes) of the image is in RAM: the
+ * server sends a chunk only after the device has acknowledged the one
+ * before, and the device only acknowledges once the chunk is in flash.
+ * update() writes at most one chunk per call, and no more often than
+ * every setThrottle() ms, so the download never holds up the rest of the
+ * loop for longer than one flash write. (On the ESP32 a write also stalls
+ * the other core while it runs code from flash; the gap between writes is
+ * what keeps sensing and the stepper going.)
+ *
+ * Frames, all numbers little endian:
+ *
+ *    server -> device
+ *      'B' size:4 version:4   begin an image of size bytes
+ *      'D' offset:4 data      the next chunk, at most OTA_CHUNK bytes,
+ *                             sent only after 'A' with that offset
+ *      'F' signature          end: signature of the above, at most
+ *                             OTA_SIGNATURE_MAX bytes (DER for ECDSA)
+ *      'X'                    abandon the update
+ *
+ *    device -> server
+ *      'A' offset:4 chunk:2   all bytes below offset are in flash; send
+ *                             the next chunk of at most chunk bytes
+ *      'K'                    signature good, new image will boot next
+ *      'E' error:1            update abandoned (see OtaError)
+ *
+ * A chunk sent again (its 'A' was lost) is answered with 'A' again. No
+ * frame for OTA_TIMEOUT ms abandons the update.
+ *
+ * Signing a build, with the private key kept off the devices:
+ *
+ *    openssl ecparam -name prime256v1 -genkey -out ota_private.pem
+ *    openssl ec -in ota_private.pem -pubout -out ota_public.pem
+ *    # signed.bin: SHA-256 of firmware.bin, then size and version
+ *    openssl dgst -sha256 -binary firmware.bin > signed.bin
+ *    python3 -c "import struct, sys; sys.stdout.buffer.write(
+ *      struct.pack('<II', $SIZE, $VERSION))" >> signed.bin
+ *    openssl dgst -sha256 -sign ota_private.pem -out signature.der signed.bin
+ *
+ * After 'K' the sketch restarts when it suits it.
+ *
+ * Example:
+ *
+ *    #define FIRMWARE_VERSION 7
+ *    const char otaPublicKey[] = "-----BEGIN PUBLIC KEY-----\n...";
+ *
+ *    EspOtaFlash otaFlash;
+ *    EspOtaVerifier otaVerifier(otaPublicKey);
+ *    OtaUpdate ota(otaFlash, otaVerifier);
+ *
+ *    void setup() {
+ *      ...
+ *      SinricPro.onBinary([](const uint8_t *frame, size_t len) {
+ *        ota.receive(frame, len);
+ *      });
+ *      ota.begin(FIRMWARE_VERSION, [](const uint8_t *frame, size_t len) {
+ *        return SinricPro.sendBinary(frame, len);
+ *      });
+ *    }
+ *
+ *    void network() {                    // CoreSplit network loop
+ *      SinricPro.handle();
+ *      ota.update();
+ *      if (ota.state() == OTA_DONE) ESP.restart();
+ *    }
+ */
+
+#define OTA_CHUNK 1024              // Largest 'D' frame payload; all the image RAM used
+#define OTA_WRITE_INTERVAL 20       // ms between flash writes unless throttled otherwise
+#define OTA_TIMEOUT 30000           // ms without a frame before giving up
+#define OTA_SIGNATURE_MAX 256       // RSA-2048; ECDSA P-256 takes at most 72
+#define OTA_FRAME_MAX (5 + OTA_CHUNK) // Largest frame from the server
+
+enum OtaState {
+  OTA_IDLE,                 // No update yet
+  OTA_RECEIVING,            // Image coming in
+  OTA_DONE,                 // New image verified and set to boot
+  OTA_FAILED                // Last update abandoned, see error()
+};
+
+enum OtaError {
+  OTA_OK,
+  OTA_ERR_SIZE,             // Empty, or too big for the free slot
+  OTA_ERR_FLASH,            // Flash write or switch failed
+  OTA_ERR_SEQUENCE,         // Frame out of order or malformed
+  OTA_ERR_LENGTH,           // Ended before the whole image was written
+  OTA_ERR_SIGNATURE,        // Image does not match its signature
+  OTA_ERR_TIMEOUT,          // Server went quiet
+  OTA_ERR_ABORTED,          // Server abandoned the update
+  OTA_ERR_VERSION           // Not newer than the running firmware
+};
+
+/** Where the image goes. Bytes are written in order, exactly size of them */
+class OtaFlash {
+public:
+  virtual ~OtaFlash() {}
+  virtual bool begin(uint32_t size) = 0;                    // Open the free slot
+  virtual bool write(const uint8_t *data, size_t len) = 0;  // Next bytes
+  virtual bool activate() = 0;                              // Boot it next time
+  virtual void abort() = 0;                                 // Forget it
+};
+
+/** Checks the signature of an image */
+class OtaVerifier {
+public:
+  virtual ~OtaVerifier() {}
+  // hash: SHA-256 of SHA-256(image) size:4 version:4
+  virtual bool verify(const uint8_t hash[SHA256_SIZE], const uint8_t *signature,
+                      size_t len) = 0;
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+/** The next OTA partition, erased sector by sector as it is written */
+class EspOtaFlash : public OtaFlash {
+public:
+  EspOtaFlash();
+  bool begin(uint32_t size) override;
+  bool write(const uint8_t *data, size_t len) override;
+  bool activate() override;
+  void abort() override;
+
+protected:
+  const esp_partition_t *partition;
+  esp_ota_handle_t handle;
+};
+
+/** ECDSA or RSA signature against a PEM public key, with mbedTLS */
+class EspOtaVerifier : public OtaVerifier {
+public:
+  EspOtaVerifier(const char *publicKey);
+  bool verify(const uint8_t hash[SHA256_SIZE], const uint8_t *signature,
+              size_t len) override;
+
+protected:
+  const char *publicKey;    // PEM, kept by pointer
+};
+#endif
+
+typedef bool (*OtaSend)(const uint8_t *frame, size_t len);
+
+class OtaUpdate {
+public:
+  OtaUpdate(OtaFlash &flash, OtaVerifier &verifier);
+
+  void begin(uint32_t version, OtaSend send);
+  void setThrottle(uint16_t interval);  // ms between flash writes
+  void receive(const uint8_t *frame, size_t len);  // A binary frame from the server
+  void update();                        // Writes the waiting chunk when due
+  void abort();                         // Abandon the update from this side
+
+  OtaState state() const { return current; }
+  OtaError error() const { return lastError; }
+  uint32_t size() const { return imageSize; }
+  uint32_t version() const { return imageVersion; }  // Of the image coming in
+  uint32_t written() const { return flashed; }  // Bytes in flash so far
+
+protected:
+  void start(uint32_t size, uint32_t version);
+  void chunk(uint32_t offset, const uint8_t *data, size_t len);
+  void finish(const uint8_t *signature, size_t len);
+  void fail(OtaError error);
+  void acknowledge();
+  void reply(const uint8_t *frame, size_t len);
+
+  OtaFlash &flash;
+  OtaVerifier &verifier;
+  uint32_t running;         // Version of this firmware
+  OtaSend send;
+  uint16_t interval;
+
+  OtaState current;
+  OtaError lastError;
+  uint32_t imageSize;
+  uint32_t imageVersion;
+  uint32_t received;        // Bytes taken from the server
+  uint32_t flashed;         // Of those, written and hashed
+  uint32_t lastFrame;       // millis() of the last frame from the server
+  uint32_t lastWrite;       // millis() of the last flash write
+  Sha256 sha;
+  uint16_t pending;         // Bytes in buffer waiting for update()
+  uint8_t buffer[OTA_CHUNK];
+};
+
+
+
+#endif // OTA_UPDATE_H
@@ -0,0 +1,169 @@
+// Sha256.cpp
+#include "Sha256.h"
+
+
+static const uint32_t roundConstants[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static inline uint32_t rotr(uint32_t x, uint8_t n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+
+/**
+ * begin() - Starts a new digest
+ */
+void Sha256::begin() {
+  static const uint32_t initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                      0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                      0x1f83d9ab, 0x5be0cd19};
+  memcpy(state, initial, sizeof(state));
+  length = 0;
+}
+
+/**
+ * update() - Hashes the next part of the message
+ * @param data - The bytes
+ * @param len - How many
+ *
+ * Whole blocks are hashed straight from data; only the odd bytes at either
+ * end go through the buffer.
+ */
+void Sha256::update(const void *data, size_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint8_t used = length % SHA256_BLOCK;
+  length += len;
+
+  if (used) {
+    size_t n = min((size_t)(SHA256_BLOCK - used), len);
+    memcpy(buffer + used, p, n);
+    p += n;
+    len -= n;
+    if (used + n < SHA256_BLOCK) {
+      return;
+    }
+    compress(buffer);
+  }
+  for (; len >= SHA256_BLOCK; p += SHA256_BLOCK, len -= SHA256_BLOCK) {
+    compress(p);
+  }
+  memcpy(buffer, p, len);
+}
+
+/**
+ * finish() - Pads the message and gives out the digest
+ * @param digest - SHA256_SIZE bytes
+ *
+ * Call begin() again before hashing anything else.
+ */
+void Sha256::finish(uint8_t digest[SHA256_SIZE]) {
+  uint8_t used = length % SHA256_BLOCK;
+  uint64_t bits = (uint64_t)length * 8;
+
+  buffer[used++] = 0x80;
+  if (used > SHA256_BLOCK - 8) {
+    memset(buffer + used, 0, SHA256_BLOCK - used);
+    compress(buffer);
+    used = 0;
+  }
+  memset(buffer + used, 0, SHA256_BLOCK - 8 - used);
+  for (uint8_t i = 0; i < 8; i++) {
+    buffer[SHA256_BLOCK - 1 - i] = bits >> (8 * i);
+  }
+  compress(buffer);
+
+  for (uint8_t i = 0; i < 8; i++) {
+    digest[4 * i] = state[i] >> 24;
+    digest[4 * i + 1] = state[i] >> 16;
+    digest[4 * i + 2] = state[i] >> 8;
+    digest[4 * i + 3] = state[i];
+  }
+}
+
+/**
+ * hmac() - HMAC-SHA256 of a message (RFC 2104)
+ * @param key - The secret
+ * @param keyLen - Its length; keys longer than a block are hashed first
+ * @param data - The message
+ * @param len - Its length
+ * @param mac - SHA256_SIZE bytes
+ */
+void Sha256::hmac(const uint8_t *key, size_t keyLen, const void *data,
+                  size_t len, uint8_t mac[SHA256_SIZE]) {
+  uint8_t pad[SHA256_BLOCK];
+  Sha256 sha;
+
+  memset(pad, 0, sizeof(pad));
+  if (keyLen > SHA256_BLOCK) {
+    sha.begin();
+    sha.update(key, keyLen);
+    sha.finish(pad);
+  } else {
+    memcpy(pad, key, keyLen);
+  }
+
+  for (uint8_t i = 0; i < SHA256_BLOCK; i++) {
+    pad[i] ^= 0x36;
+  }
+  sha.begin();
+  sha.update(pad, SHA256_BLOCK);
+  sha.update(data, len);
+  sha.finish(mac);
+
+  for (uint8_t i = 0; i < SHA256_BLOCK; i++) {
+    pad[i] ^= 0x36 ^ 0x5c;
+  }
+  sha.begin();
+  sha.update(pad, SHA256_BLOCK);
+  sha.update(mac, SHA256_SIZE);
+  sha.finish(mac);
+}
+
+// One 64 byte block into the state
+void Sha256::compress(const uint8_t *block) {
+  uint32_t w[64];
+  for (uint8_t i = 0; i < 16; i++) {
+    w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 |
+           (uint32_t)block[4 * i + 2] << 8 | block[4 * i + 3];
+  }
+  for (uint8_t i = 16; i < 64; i++) {
+    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (uint8_t i = 0; i < 64; i++) {
+    uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    uint32_t t1 = h + s1 + ((e & f) ^ (~e & g)) + roundConstants[i] + w[i];
+    uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    uint32_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
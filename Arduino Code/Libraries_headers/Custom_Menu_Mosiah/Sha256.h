@@ -0,0 +1,49 @@
+// Sha256.h
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <Arduino.h>
+
+
+/** SHA-256 and HMAC-SHA256:
+ *
+ * Incremental, so a firmware image can be hashed chunk by chunk as it is
+ * written, with a 100 byte state and no allocation. Plain C++ so the
+ * device and the host bench compute the same thing.
+ *
+ * Example:
+ *
+ *    Sha256 sha;
+ *    uint8_t digest[SHA256_SIZE];
+ *    sha.begin();
+ *    while (...) sha.update(chunk, len);
+ *    sha.finish(digest);
+ *
+ *    uint8_t mac[SHA256_SIZE];
+ *    Sha256::hmac(key, keyLen, message, len, mac);
+ */
+
+#define SHA256_SIZE 32              // Bytes in a digest
+#define SHA256_BLOCK 64             // Bytes hashed at a time
+
+class Sha256 {
+public:
+  void begin();
+  void update(const void *data, size_t len);
+  void finish(uint8_t digest[SHA256_SIZE]);
+
+  static void hmac(const uint8_t *key, size_t keyLen, const void *data,
+                   size_t len, uint8_t mac[SHA256_SIZE]);
+
+protected:
+  void compress(const uint8_t *block);
+
+  uint32_t state[8];
+  uint32_t length;          // Bytes hashed so far (images stay below 4 GB)
+  uint8_t buffer[SHA256_BLOCK];
+};
+
+
+
+#endif // SHA256_H
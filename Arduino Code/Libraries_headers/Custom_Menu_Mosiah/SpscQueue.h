@@ -0,0 +1,221 @@
+// SpscQueue.h
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+
+/** Bounded lock-free queues:
+ *
+ * The transport between ISRs, cores and subsystems. All three are rings of
+ * N items (a power of two), copy items in and out, never allocate, and
+ * have the same interface:
+ *
+ *    SpscQueue : one producer, one consumer, no locks at all
+ *    MpscQueue : any number of producers, one consumer, no locks
+ *                (MpscQueue.h)
+ *    IsrQueue  : anyone, ISRs included, under a few instructions of
+ *                interrupts off (IsrQueue.h)
+ *
+ *    push(item) / pop(item)          one item, false if full / empty
+ *    push(items, n) / pop(items, n)  up to n items, returns how many
+ *    reserve() / commit(slot)        producer fills a slot in place
+ *    peek() / release()              consumer reads a slot in place
+ *    size(), highWater(), dropped()  occupancy now, the most there ever
+ *                                    was, pushes that found it full
+ *
+ * Pick the cheapest one that fits: SpscQueue between two tasks (or from
+ * loop() to a task), MpscQueue where several tasks feed one, IsrQueue
+ * where an interrupt handler is one of the producers or consumers.
+ *
+ * SpscQueue keeps the producer's and the consumer's index on separate
+ * cache lines, each next to its copy of the other side's index, so on the
+ * host the two threads only touch each other's line when the copy runs
+ * out. (The ESP32's internal RAM is not cached; there the padding is a few
+ * bytes.)
+ *
+ * Example:
+ *
+ *    SpscQueue<Reading, 8> readings;
+ *
+ *    // sensing task
+ *    if (!readings.push(r)) {
+ *      // full: the consumer is behind, r is dropped and counted
+ *    }
+ *
+ *    // or, filling the slot in place
+ *    Reading *slot = readings.reserve();
+ *    if (slot) {
+ *      slot->temperature = dht.getTemperature();
+ *      readings.commit(slot);
+ *    }
+ *
+ *    // network task
+ *    Reading batch[8];
+ *    uint16_t n = readings.pop(batch, 8);
+ */
+
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(ESP8266) && \
+    (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#define QUEUE_HOST
+#define QUEUE_CACHE_LINE 64           // Host: keep the two ends apart
+#else
+#define QUEUE_CACHE_LINE 4            // No data cache to share
+#endif
+
+template <typename T, uint16_t N>
+class SpscQueue {
+  static_assert(N && !(N & (N - 1)), "SpscQueue size must be a power of two");
+
+public:
+  /* Producer side */
+
+  /** push() - Adds an item. False (and counted) if the queue is full */
+  bool push(const T &item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (!room(h, 1)) {
+      drops.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    items[h & (N - 1)] = item;
+    publish(h + 1);
+    return true;
+  }
+
+  /** push() - Adds up to count items in one go. Returns how many fit */
+  uint16_t push(const T *from, uint16_t count) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint16_t n = room(h, count);
+    for (uint16_t i = 0; i < n; i++) {
+      items[(h + i) & (N - 1)] = from[i];
+    }
+    if (n < count) {
+      drops.fetch_add(count - n, std::memory_order_relaxed);
+    }
+    if (n) {
+      publish(h + n);
+    }
+    return n;
+  }
+
+  /** reserve() - The next free slot to fill in place, NULL if full */
+  T *reserve() {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (!room(h, 1)) {
+      drops.fetch_add(1, std::memory_order_relaxed);
+      return NULL;
+    }
+    return &items[h & (N - 1)];
+  }
+
+  /** commit() - Hands the slot from reserve() to the consumer */
+  void commit(T *slot) {
+    (void)slot;               // Always the slot at head
+    publish(head.load(std::memory_order_relaxed) + 1);
+  }
+
+  /* Consumer side */
+
+  /** pop() - Takes the oldest item. False if the queue is empty */
+  bool pop(T &item) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (!waiting(t, 1)) {
+      return false;
+    }
+    item = items[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** pop() - Takes up to count items in one go. Returns how many */
+  uint16_t pop(T *to, uint16_t count) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint16_t n = waiting(t, count);
+    for (uint16_t i = 0; i < n; i++) {
+      to[i] = items[(t + i) & (N - 1)];
+    }
+    if (n) {
+      tail.store(t + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  /** peek() - The oldest item, read in place, NULL if the queue is empty */
+  const T *peek() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    return waiting(t, 1) ? &items[t & (N - 1)] : NULL;
+  }
+
+  /** release() - Frees the slot peek() returned */
+  void release() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /* Either side */
+
+  uint16_t size() const {
+    return (uint16_t)(head.load(std::memory_order_acquire) -
+                      tail.load(std::memory_order_acquire));
+  }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == N; }
+  static uint16_t capacity() { return N; }
+  uint16_t highWater() const { return peak.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return drops.load(std::memory_order_relaxed); }
+  void resetStats() {
+    peak.store(0, std::memory_order_relaxed);
+    drops.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  // Free slots from h on, at most want; only looks at tail if the last
+  // look doesn't show enough
+  uint16_t room(uint32_t h, uint16_t want) {
+    if (N - (h - tailSeen) < want) {
+      tailSeen = tail.load(std::memory_order_acquire);
+    }
+    uint32_t free = N - (h - tailSeen);
+    return free < want ? free : want;
+  }
+
+  // Items from t on, at most want
+  uint16_t waiting(uint32_t t, uint16_t want) {
+    if (headSeen - t < want) {
+      headSeen = head.load(std::memory_order_acquire);
+    }
+    uint32_t used = headSeen - t;
+    return used < want ? used : want;
+  }
+
+  // Publishes up to h. A stale tailSeen only ever overstates how full the
+  // queue is, so tail is only looked at when that could be a new peak
+  void publish(uint32_t h) {
+    head.store(h, std::memory_order_release);
+    uint16_t high = peak.load(std::memory_order_relaxed);
+    if ((uint16_t)(h - tailSeen) > high) {
+      tailSeen = tail.load(std::memory_order_acquire);
+      uint16_t used = h - tailSeen;
+      if (used > high) {
+        peak.store(used, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Producer's line
+  alignas(QUEUE_CACHE_LINE) std::atomic<uint32_t> head{0};  // Next slot to fill, free running
+  uint32_t tailSeen = 0;              // tail as the producer last saw it
+  std::atomic<uint16_t> peak{0};
+  std::atomic<uint32_t> drops{0};
+
+  // Consumer's line
+  alignas(QUEUE_CACHE_LINE) std::atomic<uint32_t> tail{0};  // Next slot to empty
+  uint32_t headSeen = 0;              // head as the consumer last saw it
+
+  alignas(QUEUE_CACHE_LINE) T items[N];
+};
+
+
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,356 @@
+// Widgets.cpp
+#include "Widgets.h"
+
+
+/* Widget */
+Widget::Widget(int16_t x, int16_t y, int16_t w, int16_t h)
+  : x(x), y(y), w(w), h(h), dirty(true) {}
+
+/**
+ * render() - Repaints the widget
+ * @param gfx - The display (or canvas) to draw on
+ *
+ * Clears the widget's bounds, lets the widget draw itself and marks it clean.
+ * Only the bounds are touched, so the display only has to send those columns.
+ */
+void Widget::render(Adafruit_GFX &gfx) {
+  gfx.fillRect(x, y, w, h, SH110X_BLACK);
+  gfx.setFont(NULL);
+  gfx.setTextSize(1);
+  gfx.setTextWrap(false);
+  draw(gfx);
+  dirty = false;
+}
+
+// Prints as much of text as fits between px and the right edge of the widget
+void Widget::printClipped(Adafruit_GFX &gfx, int16_t px, int16_t py,
+                          const String &text, uint16_t color) {
+  int fit = (x + w - px) / 6;
+  if (fit <= 0) {
+    return;
+  }
+  gfx.setTextColor(color);
+  gfx.setCursor(px, py);
+  if ((int)text.length() > fit) {
+    gfx.print(text.substring(0, fit));
+  } else {
+    gfx.print(text);
+  }
+}
+
+
+/* Label */
+Label::Label(int16_t x, int16_t y, int16_t w, int16_t h, const String &text)
+  : Widget(x, y, w, h), text(text) {}
+
+void Label::setText(const String &new_text) {
+  if (new_text != text) {
+    text = new_text;
+    invalidate();
+  }
+}
+
+void Label::draw(Adafruit_GFX &gfx) {
+  printClipped(gfx, x, y, text, SH110X_WHITE);
+}
+
+
+/* ValueField */
+ValueField::ValueField(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const float *value, uint8_t decimals, const char *unit)
+  : Widget(x, y, w, h), value(value), decimals(decimals), unit(unit) {}
+
+void ValueField::bind(const float *new_value) {
+  value = new_value;
+  invalidate();
+}
+
+String ValueField::format() const {
+  if (value == NULL || isnan(*value)) {
+    return String("--") + unit;
+  }
+  return String(*value, (unsigned int)decimals) + unit;
+}
+
+/**
+ * update() - Invalidates the field if the bound value prints differently
+ *
+ * Changes smaller than the shown precision do not cause a repaint.
+ */
+void ValueField::update() {
+  if (!dirty && format() != shown) {
+    invalidate();
+  }
+}
+
+void ValueField::draw(Adafruit_GFX &gfx) {
+  shown = format();
+  printClipped(gfx, x, y, shown, SH110X_WHITE);
+}
+
+
+/* Sparkline */
+Sparkline::Sparkline(int16_t x, int16_t y, int16_t w, int16_t h)
+  : Widget(x, y, w, h), head(0), count(0) {
+  samples = (float *)malloc(w * sizeof(float));
+}
+
+Sparkline::~Sparkline() {
+  free(samples);
+}
+
+/**
+ * push() - Adds a sample, dropping the oldest once the graph is full
+ * @param sample - The new reading
+ */
+void Sparkline::push(float sample) {
+  if (samples == NULL) {
+    return;
+  }
+  samples[head] = sample;
+  head = (head + 1) % w;
+  if (count < w) {
+    count++;
+  }
+  invalidate();
+}
+
+void Sparkline::clear() {
+  head = count = 0;
+  invalidate();
+}
+
+float Sparkline::sample(uint16_t i) const {
+  return samples[(head + w - count + i) % w];
+}
+
+/**
+ * draw() - Plots the samples right-aligned, newest at the right edge
+ *
+ * The vertical scale is fitted to the lowest and highest sample held.
+ */
+void Sparkline::draw(Adafruit_GFX &gfx) {
+  if (count == 0) {
+    return;
+  }
+
+  float lo = sample(0), hi = lo;
+  for (uint16_t i = 1; i < count; i++) {
+    lo = min(lo, sample(i));
+    hi = max(hi, sample(i));
+  }
+  float scale = (hi > lo) ? (h - 1) / (hi - lo) : 0;
+
+  int16_t left = x + w - count;
+  int16_t prev = y + h - 1 - (int16_t)((sample(0) - lo) * scale);
+  gfx.drawPixel(left, prev, SH110X_WHITE);
+  for (uint16_t i = 1; i < count; i++) {
+    int16_t py = y + h - 1 - (int16_t)((sample(i) - lo) * scale);
+    gfx.drawLine(left + i - 1, prev, left + i, py, SH110X_WHITE);
+    prev = py;
+  }
+}
+
+
+/* StripChart */
+StripChart::StripChart(int16_t x, int16_t y, int16_t w, int16_t h, float lo,
+                       float hi)
+  : Widget(x, y, w, h), lo(lo), hi(hi), head(0), count(0), pending(0) {
+  // One sample more than columns, so the leftmost column can still be
+  // joined to the sample that has scrolled off
+  samples = (float *)malloc((w + 1) * sizeof(float));
+}
+
+StripChart::~StripChart() {
+  free(samples);
+}
+
+/**
+ * push() - Adds a sample, to be drawn as one new column on the next refresh
+ * @param sample - The new reading, clamped to the chart's range when drawn
+ */
+void StripChart::push(float sample) {
+  if (samples == NULL) {
+    return;
+  }
+  samples[head] = sample;
+  head = (head + 1) % (w + 1);
+  if (count < w + 1) {
+    count++;
+  }
+  if (++pending >= w) {
+    invalidate();  // Whole graph is new, repaint it
+  }
+}
+
+void StripChart::clear() {
+  head = count = pending = 0;
+  invalidate();
+}
+
+// Changing the scale moves every column, so the graph is repainted
+void StripChart::setRange(float new_lo, float new_hi) {
+  lo = new_lo;
+  hi = new_hi;
+  invalidate();
+}
+
+int16_t StripChart::sampleY(uint16_t i) const {
+  float v = samples[(head + w + 1 - count + i) % (w + 1)];
+  v = constrain(v, lo, hi);
+  float scale = (hi > lo) ? (h - 1) / (hi - lo) : 0;
+  return y + h - 1 - (int16_t)((v - lo) * scale);
+}
+
+/**
+ * drawColumn() - Draws one sample as a vertical run joining it to the one before
+ * @param gfx - The display to draw on
+ * @param i - Column index, 0 being the leftmost
+ *
+ * A column only depends on its own sample and the previous one, which is
+ * what lets the chart scroll and draw a single new column.
+ */
+void StripChart::drawColumn(Adafruit_GFX &gfx, uint16_t i) {
+  uint16_t k = count - shown() + i;
+  int16_t py = sampleY(k);
+  int16_t prev = (k > 0) ? sampleY(k - 1) : py;
+  int16_t cx = x + w - shown() + i;
+  gfx.drawFastVLine(cx, min(py, prev), abs(py - prev) + 1, SH110X_WHITE);
+}
+
+void StripChart::draw(Adafruit_GFX &gfx) {
+  for (uint16_t i = 0; i < shown(); i++) {
+    drawColumn(gfx, i);
+  }
+  pending = 0;
+}
+
+/**
+ * renderChanges() - Scrolls the chart left by the samples pushed since the
+ * last paint and draws only their columns
+ * @param oled - The display the chart is on
+ * @return true if anything was drawn
+ */
+bool StripChart::renderChanges(Adafruit_GrayOLED &oled) {
+  if (pending == 0) {
+    return false;
+  }
+  oled.scrollRect(x, y, w, h, pending);
+  for (uint16_t i = shown() - pending; i < shown(); i++) {
+    drawColumn(oled, i);
+  }
+  pending = 0;
+  return true;
+}
+
+
+/* MenuList */
+MenuList::MenuList(int16_t x, int16_t y, int16_t w, int16_t h, Menu **menu)
+  : Widget(x, y, w, h), menu(menu), shownMenu(NULL), shownSelection(-1),
+    shownChoices(0), top(0) {}
+
+void MenuList::bind(Menu **new_menu) {
+  menu = new_menu;
+  invalidate();
+}
+
+/**
+ * update() - Invalidates the list if the menu, its selection or its choices
+ * changed since it was painted
+ */
+void MenuList::update() {
+  Menu *m = (menu != NULL) ? *menu : NULL;
+  if (m != shownMenu
+  || (m != NULL && (m->currentSelection != shownSelection
+                    || m->choices.size() != shownChoices))) {
+    invalidate();
+  }
+}
+
+/**
+ * draw() - Paints the menu title on the first line and the choices below it
+ *
+ * The selected choice is drawn inverted with a ">" in front of it. When there
+ * are more choices than lines the list scrolls to keep the selection visible.
+ */
+void MenuList::draw(Adafruit_GFX &gfx) {
+  Menu *m = (menu != NULL) ? *menu : NULL;
+  if (m != shownMenu) {
+    top = 0;
+  }
+  shownMenu = m;
+  if (m == NULL) {
+    shownSelection = -1;
+    shownChoices = 0;
+    printClipped(gfx, x, y, "No menu", SH110X_WHITE);
+    return;
+  }
+  shownSelection = m->currentSelection;
+  shownChoices = m->choices.size();
+
+  printClipped(gfx, x, y, m->title, SH110X_WHITE);
+
+  int rows = h / 8 - 1;
+  if (rows <= 0) {
+    return;
+  }
+  if (shownSelection < top) {
+    top = shownSelection;
+  } else if (shownSelection >= top + rows) {
+    top = shownSelection - rows + 1;
+  }
+  if (top < 0) {
+    top = 0;
+  }
+
+  for (int r = 0; r < rows && top + r < (int)shownChoices; r++) {
+    int i = top + r;
+    int16_t ry = y + 8 * (r + 1);
+    if (i == shownSelection) {
+      gfx.fillRect(x, ry, w, 8, SH110X_WHITE);
+      printClipped(gfx, x, ry, ">" + m->choices[i], SH110X_BLACK);
+    } else {
+      printClipped(gfx, x, ry, " " + m->choices[i], SH110X_WHITE);
+    }
+  }
+}
+
+
+/* WidgetScreen */
+void WidgetScreen::add(Widget &widget) {
+  widgets.push_back(&widget);
+  widget.invalidate();
+}
+
+// Forces every widget to repaint, e.g. after switching to this screen
+void WidgetScreen::invalidateAll() {
+  for (size_t i = 0; i < widgets.size(); i++) {
+    widgets[i]->invalidate();
+  }
+}
+
+/**
+ * refresh() - Repaints changed widgets and pushes them to the display
+ * @param display - The OLED the screen is shown on
+ * @return true if anything was repainted
+ *
+ * Widgets that did not change are neither drawn nor sent, and display() is
+ * not called at all when nothing changed. Widgets that can update in place
+ * (StripChart) get renderChanges() instead of a full repaint.
+ */
+bool WidgetScreen::refresh(Adafruit_SH110X &display) {
+  bool drawn = false;
+  for (size_t i = 0; i < widgets.size(); i++) {
+    widgets[i]->update();
+    if (widgets[i]->isDirty()) {
+      widgets[i]->render(display);
+      drawn = true;
+    } else if (widgets[i]->renderChanges(display)) {
+      drawn = true;
+    }
+  }
+  if (drawn) {
+    display.display();
+  }
+  return drawn;
+}
@@ -0,0 +1,178 @@
+// Widgets.h
+
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <Arduino.h>
+#include <vector>
+#include <Adafruit_SH110X.h>
+#include "Menu.h"
+
+
+/** Retained widgets for the OLED:
+ *
+ * Instead of clearing and redrawing the whole screen every pass of loop(),
+ * the screen is built once out of widgets that each own a rectangle:
+ *
+ *    Label      : fixed or occasionally changing text ("Temp", messages)
+ *    ValueField : a float bound by pointer, shown with N decimals and a unit
+ *    Sparkline  : a line graph of the last samples pushed into it
+ *    StripChart : a fixed-scale graph that scrolls by one column per sample
+ *    MenuList   : the current Menu (title, choices, ">" on the selection)
+ *
+ * A WidgetScreen polls its widgets and only repaints the ones whose bound
+ * value changed since they were last drawn. Together with the partial
+ * refresh in Adafruit_SH110X::display() the cost of a frame follows what
+ * changed on screen, not how much is on it.
+ *
+ * Example:
+ *
+ *    Label tempLabel(0, 0, 36, 8, "Temp");
+ *    ValueField tempValue(40, 0, 48, 8, &temperature, 1, "C");
+ *    Sparkline tempGraph(0, 16, 128, 32);
+ *    WidgetScreen readings;
+ *
+ *    readings.add(tempLabel);
+ *    readings.add(tempValue);
+ *    readings.add(tempGraph);
+ *
+ *    // in loop()
+ *    tempGraph.push(temperature);   // when a new reading comes in
+ *    readings.refresh(display);     // cheap when nothing changed
+ *
+ * Widgets draw with the classic 6x8 font and leave text size 1, no wrap and
+ * no custom font set on the display.
+ */
+
+// Base class: a rectangle on screen that knows when it needs repainting
+class Widget {
+public:
+  Widget(int16_t x, int16_t y, int16_t w, int16_t h);
+  virtual ~Widget() {}
+
+  void invalidate() { dirty = true; }
+  bool isDirty() const { return dirty; }
+
+  virtual void update() {}  // Check bound values, invalidate() if changed
+  void render(Adafruit_GFX &gfx);
+  virtual bool renderChanges(Adafruit_GrayOLED &) { return false; }  // Paint changes without a full repaint
+
+protected:
+  virtual void draw(Adafruit_GFX &gfx) = 0;  // Paint into the cleared bounds
+  void printClipped(Adafruit_GFX &gfx, int16_t px, int16_t py, const String &text,
+                    uint16_t color);
+
+  int16_t x, y, w, h;   // Bounds, in display coordinates
+  bool dirty;           // Needs to be repainted on the next refresh
+};
+
+
+// Text that changes only when setText() is given something different
+class Label : public Widget {
+public:
+  Label(int16_t x, int16_t y, int16_t w, int16_t h, const String &text = "");
+  void setText(const String &text);
+  const String &getText() const { return text; }
+
+protected:
+  void draw(Adafruit_GFX &gfx) override;
+  String text;
+};
+
+
+// A number bound by pointer, repainted when its printed form changes
+class ValueField : public Widget {
+public:
+  ValueField(int16_t x, int16_t y, int16_t w, int16_t h, const float *value,
+             uint8_t decimals = 1, const char *unit = "");
+  void bind(const float *value);
+  void update() override;
+
+protected:
+  void draw(Adafruit_GFX &gfx) override;
+  String format() const;
+
+  const float *value;   // Bound value, may be NULL ("--" is shown)
+  uint8_t decimals;     // Digits after the decimal point
+  const char *unit;     // Suffix such as "C" or "%"
+  String shown;         // Text last painted
+};
+
+
+// Line graph of the most recent samples, one sample per column, autoscaled
+class Sparkline : public Widget {
+public:
+  Sparkline(int16_t x, int16_t y, int16_t w, int16_t h);
+  ~Sparkline();
+  void push(float sample);
+  void clear();
+  uint16_t size() const { return count; }
+
+protected:
+  void draw(Adafruit_GFX &gfx) override;
+  float sample(uint16_t i) const;  // i = 0 is the oldest kept sample
+
+  float *samples;       // Ring buffer of w samples
+  uint16_t head;        // Next slot to write
+  uint16_t count;       // Samples held, up to w
+};
+
+
+// Graph with a fixed scale that scrolls left as samples arrive. Each sample
+// only draws its own column; the rest of the graph is shifted in the
+// display buffer instead of being redrawn.
+class StripChart : public Widget {
+public:
+  StripChart(int16_t x, int16_t y, int16_t w, int16_t h, float lo, float hi);
+  ~StripChart();
+  void push(float sample);
+  void clear();
+  void setRange(float lo, float hi);
+  bool renderChanges(Adafruit_GrayOLED &oled) override;
+
+protected:
+  void draw(Adafruit_GFX &gfx) override;
+  void drawColumn(Adafruit_GFX &gfx, uint16_t i);  // i = 0 is the leftmost column
+  int16_t sampleY(uint16_t i) const;               // i = 0 is the oldest sample
+  uint16_t shown() const { return min(count, (uint16_t)w); }
+
+  float *samples;       // Circular buffer of the last w + 1 samples
+  float lo, hi;         // Values at the bottom and top edge
+  uint16_t head;        // Next slot to write
+  uint16_t count;       // Samples held, up to w + 1
+  uint16_t pending;     // Samples pushed since the last paint
+};
+
+
+// The menu a Menu* points at, following navigation and selection changes
+class MenuList : public Widget {
+public:
+  MenuList(int16_t x, int16_t y, int16_t w, int16_t h, Menu **menu);
+  void bind(Menu **menu);
+  void update() override;
+
+protected:
+  void draw(Adafruit_GFX &gfx) override;
+
+  Menu **menu;          // Usually &current_menu
+  Menu *shownMenu;      // Menu last painted
+  int shownSelection;   // Its selection when painted
+  size_t shownChoices;  // Its number of choices when painted
+  int top;              // First choice visible, scrolled to keep selection in view
+};
+
+
+// A set of widgets shown together, refreshed as a unit
+class WidgetScreen {
+public:
+  void add(Widget &widget);
+  void invalidateAll();
+  bool refresh(Adafruit_SH110X &display);
+
+protected:
+  std::vector<Widget *> widgets;
+};
+
+
+
+#endif // WIDGETS_H
@@ -39,6 +39,16 @@ using DisconnectedCallbackHandler = std::function<void(void)>;
 
 using PongCallback = std::function<void(uint32_t)>;
 
+/**
+ * @brief Callback definition for onBinary function
+ *
+ * Gets called when a binary frame arrives from the server (e.g. firmware updates)
+ * @param data pointer to the frame, valid only during the call
+ * @param length length of the frame in bytes
+ * @return void
+ */
+using BinaryCallbackHandler = std::function<void(const uint8_t*, size_t)>;
+
 /**
  * @class SinricProClass
  * @ingroup SinricPro
@@ -58,6 +68,8 @@ class SinricProClass : public SinricProInterface {
     void          onConnected(ConnectedCallbackHandler cb);
     void          onDisconnected(DisconnectedCallbackHandler cb);
     void          onPong(PongCallback cb);
+    void          onBinary(BinaryCallbackHandler cb);
+    bool          sendBinary(const uint8_t* data, size_t length);
     void          restoreDeviceStates(bool flag);
     void          setResponseMessage(String&& message);
     unsigned long getTimestamp() override;
@@ -103,10 +115,10 @@ class SinricProClass : public SinricProInterface {
     String appSecret;
     String serverURL;
 
-    WebsocketListener _websocketListener;
-    UdpListener       _udpListener;
-    SinricProQueue_t  receiveQueue;
-    SinricProQueue_t  sendQueue;
+    WebsocketListener    _websocketListener;
+    UdpListener          _udpListener;
+    SinricProQueue_t     receiveQueue;
+    SinricProSendQueue_t sendQueue;
 
     Timestamp timestamp;
 
@@ -232,6 +244,8 @@ __attribute__((deprecated("Please use DeviceType& myDevice = SinricPro.add<Devic
  * @endcode
  **/
 void SinricProClass::handle() {
+    SINRICPRO_HEAP_SCOPE("sinric");
+    SINRICPRO_PROFILE_SCOPE("sinric");
     static bool begin_error = false;
     if (!_begin) {
         if (!begin_error) {  // print this only once!
@@ -317,16 +331,17 @@ void SinricProClass::handleRequest(DynamicJsonDocument& requestMessage, interfac
 
     String responseString;
     serializeJson(responseMessage, responseString);
-    sendQueue.push(new SinricProMessage(Interface, responseString.c_str()));
+    if (!sendQueue.push(new SinricProMessage(Interface, responseString.c_str()))) {
+        DEBUG_SINRIC("[SinricPro.handleRequest()]: sendQueue is full, response has been dropped\r\n");
+    }
 }
 
 void SinricProClass::handleReceiveQueue() {
     if (receiveQueue.size() == 0) return;
 
     DEBUG_SINRIC("[SinricPro.handleReceiveQueue()]: %i message(s) in receiveQueue\r\n", receiveQueue.size());
-    while (receiveQueue.size() > 0) {
-        SinricProMessage* rawMessage = receiveQueue.front();
-        receiveQueue.pop();
+    SinricProMessage* rawMessage;
+    while (receiveQueue.pop(rawMessage)) {
         DynamicJsonDocument jsonMessage(1024);
         deserializeJson(jsonMessage, rawMessage->getMessage());
 
@@ -358,13 +373,11 @@ void SinricProClass::handleReceiveQueue() {
 void SinricProClass::handleSendQueue() {
     if (!isConnected()) return;
     if (!timestamp.getTimestamp()) return;
-    while (sendQueue.size() > 0) {
-        DEBUG_SINRIC("[SinricPro:handleSendQueue()]: %i message(s) in sendQueue\r\n", sendQueue.size());
+    SinricProMessage* rawMessage;
+    while (sendQueue.pop(rawMessage)) {
+        DEBUG_SINRIC("[SinricPro:handleSendQueue()]: %i message(s) in sendQueue\r\n", sendQueue.size() + 1);
         DEBUG_SINRIC("[SinricPro:handleSendQueue()]: Sending message...\r\n");
 
-        SinricProMessage* rawMessage = sendQueue.front();
-        sendQueue.pop();
-
         DynamicJsonDocument jsonMessage(1024);
         deserializeJson(jsonMessage, rawMessage->getMessage());
         jsonMessage[FSTR_SINRICPRO_payload][FSTR_SINRICPRO_createdAt] = timestamp.getTimestamp();
@@ -448,6 +461,35 @@ void SinricProClass::onPong(PongCallback cb) {
     _websocketListener.onPong(cb);
 }
 
+/**
+ * @brief Set callback function for binary frames from the server
+ *
+ * Binary frames are not SinricPro messages; they go straight to the callback,
+ * from inside handle(), without being queued.
+ * @param cb Function pointer to a `BinaryCallbackHandler` function
+ * @return void
+ * @see BinaryCallbackHandler
+ **/
+void SinricProClass::onBinary(BinaryCallbackHandler cb) {
+    _websocketListener.onBinary(cb);
+}
+
+/**
+ * @brief Send a binary frame to the server
+ *
+ * Sent right away over the websocket, bypassing the send queue.
+ * @param data pointer to the frame
+ * @param length length of the frame in bytes
+ * @return true if the frame was sent, false if offline
+ **/
+bool SinricProClass::sendBinary(const uint8_t* data, size_t length) {
+    if (!isConnected()) {
+        DEBUG_SINRIC("[SinricPro:sendBinary()]: device is offline, frame has been dropped\r\n");
+        return false;
+    }
+    return _websocketListener.sendBinary(data, length);
+}
+
 void SinricProClass::reconnect() {
     DEBUG_SINRIC("SinricPro:reconnect(): disconnecting\r\n");
     stop();
@@ -490,7 +532,9 @@ void SinricProClass::sendMessage(JsonDocument& jsonMessage) {
     DEBUG_SINRIC("[SinricPro:sendMessage()]: pushing message into sendQueue\r\n");
     String messageString;
     serializeJson(jsonMessage, messageString);
-    sendQueue.push(new SinricProMessage(IF_WEBSOCKET, messageString.c_str()));
+    if (!sendQueue.push(new SinricProMessage(IF_WEBSOCKET, messageString.c_str()))) {
+        DEBUG_SINRIC("[SinricPro:sendMessage()]: sendQueue is full, message has been dropped\r\n");
+    }
 }
 
 /**
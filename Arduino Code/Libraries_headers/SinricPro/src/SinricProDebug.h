@@ -19,4 +19,20 @@
 #ifndef DEBUG_SINRIC
 #define DEBUG_SINRIC(...)
 #define NODEBUG_SINRIC
-#endif
\ No newline at end of file
+#endif
+
+// Charges heap allocations to a subsystem when built with HEAP_TRACE
+#ifdef HEAP_TRACE
+#include <HeapTrace.h>
+#define SINRICPRO_HEAP_SCOPE(name) HEAP_TRACE_SCOPE(name)
+#else
+#define SINRICPRO_HEAP_SCOPE(name)
+#endif
+
+// Times a loop phase when built with LOOP_PROFILE
+#ifdef LOOP_PROFILE
+#include <LoopProfiler.h>
+#define SINRICPRO_PROFILE_SCOPE(name) LOOP_PROFILE_SCOPE(name)
+#else
+#define SINRICPRO_PROFILE_SCOPE(name)
+#endif
@@ -7,7 +7,9 @@
 
 #pragma once
 
-#include <queue>
+// The queues are MpscQueue from this project's Custom_Menu_Mosiah library,
+// which must be installed next to SinricPro
+#include <MpscQueue.h>
 
 #include "SinricProNamespace.h"
 namespace SINRICPRO_NAMESPACE {
@@ -47,6 +49,30 @@ interface_t SinricProMessage::getInterface() const {
 };
 
 
-typedef std::queue<SinricProMessage*> SinricProQueue_t;
+// Requests waiting for handle()
+#ifndef SINRICPRO_QUEUE_SIZE
+#define SINRICPRO_QUEUE_SIZE 16
+#endif
+
+// Events and responses waiting to be sent. Nothing is sent while offline,
+// so this has to hold everything reported during a WiFi or server outage
+#ifndef SINRICPRO_SEND_QUEUE_SIZE
+#define SINRICPRO_SEND_QUEUE_SIZE 64
+#endif
+
+// Bounded and lock-free, so any task may send while handle() runs in another
+template <uint16_t N>
+class SinricProQueue : public MpscQueue<SinricProMessage*, N> {
+public:
+  // Takes the message over: one that doesn't fit is deleted
+  bool push(SinricProMessage* message) {
+    if (MpscQueue<SinricProMessage*, N>::push(message)) return true;
+    delete message;
+    return false;
+  }
+};
+
+typedef SinricProQueue<SINRICPRO_QUEUE_SIZE>      SinricProQueue_t;
+typedef SinricProQueue<SINRICPRO_SEND_QUEUE_SIZE> SinricProSendQueue_t;
 
 } // SINRICPRO_NAMESPACE
\ No newline at end of file
@@ -55,7 +55,9 @@ void UdpListener::handle() {
     SinricProMessage* request = new SinricProMessage(IF_UDP, buf);
     DEBUG_SINRIC("[SinricPro:UDP]: receiving request\r\n%s\r\n", buf);
     free(buf);
-    receiveQueue->push(request);
+    if (!receiveQueue->push(request)) {
+      DEBUG_SINRIC("[SinricPro:UDP]: receiveQueue is full, request has been dropped\r\n");
+    }
   }
 }
 
@@ -30,6 +30,7 @@ namespace SINRICPRO_NAMESPACE {
 using wsConnectedCallback    = std::function<void(void)>;
 using wsDisconnectedCallback = std::function<void(void)>;
 using wsPongCallback         = std::function<void(uint32_t)>;
+using wsBinaryCallback       = std::function<void(const uint8_t*, size_t)>;
 
 class WebsocketListener : protected WebSocketsClient {
   public:
@@ -42,10 +43,12 @@ class WebsocketListener : protected WebSocketsClient {
     void setRestoreDeviceStates(bool flag);
 
     void sendMessage(String& message);
+    bool sendBinary(const uint8_t* data, size_t length);
 
     void onConnected(wsConnectedCallback callback);
     void onDisconnected(wsDisconnectedCallback callback);
     void onPong(wsPongCallback callback);
+    void onBinary(wsBinaryCallback callback);
     
     using WebSocketsClient::disconnect;
     using WebSocketsClient::isConnected;
@@ -57,6 +60,7 @@ class WebsocketListener : protected WebSocketsClient {
     wsConnectedCallback    _wsConnectedCb;
     wsDisconnectedCallback _wsDisconnectedCb;
     wsPongCallback         _wsPongCb;
+    wsBinaryCallback       _wsBinaryCb;
 
     virtual void runCbEvent(WStype_t type, uint8_t* payload, size_t length) override;
 
@@ -71,13 +75,15 @@ WebsocketListener::WebsocketListener()
     , restoreDeviceStates(false)
     , _wsConnectedCb(nullptr)
     , _wsDisconnectedCb(nullptr)
-    , _wsPongCb(nullptr) {}
+    , _wsPongCb(nullptr)
+    , _wsBinaryCb(nullptr) {}
 
 WebsocketListener::~WebsocketListener() {
     stop();
 }
 
 void WebsocketListener::setExtraHeaders() {
+    SINRICPRO_HEAP_SCOPE("sinric");
 #if defined(ESP8266)
     const char* platform = "ESP8266";
 #elif defined(ESP32)
@@ -143,6 +149,10 @@ void WebsocketListener::sendMessage(String& message) {
     sendTXT(message);
 }
 
+bool WebsocketListener::sendBinary(const uint8_t* data, size_t length) {
+    return sendBIN(data, length);
+}
+
 void WebsocketListener::onConnected(wsConnectedCallback callback) {
     _wsConnectedCb = callback;
 }
@@ -155,9 +165,11 @@ void WebsocketListener::onPong(wsPongCallback callback) {
     _wsPongCb = callback;
 }
 
-void WebsocketListener::runCbEvent(WStype_t type, uint8_t* payload, size_t length) {
-    (void)length;
+void WebsocketListener::onBinary(wsBinaryCallback callback) {
+    _wsBinaryCb = callback;
+}
 
+void WebsocketListener::runCbEvent(WStype_t type, uint8_t* payload, size_t length) {
     switch (type) {
         case WStype_DISCONNECTED: {
                 DEBUG_SINRIC("[SinricPro:Websocket]: disconnected\r\n");
@@ -175,9 +187,18 @@ void WebsocketListener::runCbEvent(WStype_t type, uint8_t* payload, size_t lengt
             break;
 
         case WStype_TEXT: {
+            SINRICPRO_HEAP_SCOPE("sinric");
             SinricProMessage* request = new SinricProMessage(IF_WEBSOCKET, (char*)payload);
             DEBUG_SINRIC("[SinricPro:Websocket]: receiving data\r\n");
-            receiveQueue->push(request);
+            if (!receiveQueue->push(request)) {
+                DEBUG_SINRIC("[SinricPro:Websocket]: receiveQueue is full, request has been dropped\r\n");
+            }
+            break;
+        }
+
+        case WStype_BIN: {
+            DEBUG_SINRIC("[SinricPro:Websocket]: receiving %u bytes of binary data\r\n", (unsigned)length);
+            if (_wsBinaryCb) _wsBinaryCb(payload, length);
             break;
         }
 
@@ -28,6 +28,13 @@
 
 #include "DHT.h"
 
+// Sensor reads show up as the "dht" phase when built with LOOP_PROFILE
+#ifdef LOOP_PROFILE
+#include <LoopProfiler.h>
+#else
+#define LOOP_PROFILE_SCOPE(name)
+#endif
+
 void DHT::setup(uint8_t pin, DHT_MODEL_t model)
 {
   DHT::pin = pin;
@@ -118,6 +125,7 @@ void DHT::readSensor()
     return;
   }
   lastReadTime = startTime;
+  LOOP_PROFILE_SCOPE("dht");
 
   temperature = NAN;
   humidity = NAN;
@@ -198,6 +198,7 @@ bool WebSockets::sendFrameHeader(WSclient_t * client, WSopcode_t opcode, size_t
  * @return true if ok
  */
 bool WebSockets::sendFrame(WSclient_t * client, WSopcode_t opcode, uint8_t * payload, size_t length, bool fin, bool headerToPayload) {
+    WEBSOCKETS_HEAP_SCOPE();
     if(client->tcp && !client->tcp->connected()) {
         DEBUG_WEBSOCKETS("[WS][%d][sendFrame] not Connected!?\n", client->num);
         return false;
@@ -381,6 +382,7 @@ bool WebSockets::handleWebsocketWaitFor(WSclient_t * client, size_t size) {
 }
 
 void WebSockets::handleWebsocketCb(WSclient_t * client) {
+    WEBSOCKETS_HEAP_SCOPE();
     if(!client->tcp || !client->tcp->connected()) {
         return;
     }
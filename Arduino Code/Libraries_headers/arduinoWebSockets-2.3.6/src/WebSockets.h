@@ -61,6 +61,14 @@
 #endif
 #endif
 
+// charge heap allocations to the websocket when built with HEAP_TRACE
+#ifdef HEAP_TRACE
+#include <HeapTrace.h>
+#define WEBSOCKETS_HEAP_SCOPE() HEAP_TRACE_SCOPE("websocket")
+#else
+#define WEBSOCKETS_HEAP_SCOPE()
+#endif
+
 #if defined(ESP8266) || defined(ESP32)
 
 #define WEBSOCKETS_MAX_DATA_SIZE (15 * 1024)
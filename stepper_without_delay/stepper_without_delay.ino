@@ -11,38 +11,94 @@
   The motor should revolve one revolution in one direction, then
   one revolution in the other direction.
 
+  The motor is stepped one step per pass of loop(), so loop() never
+  blocks for a whole revolution. On the ESP32 CoreSplit runs network()
+  on core 0 (WiFi, SinricPro and Serial go there) and loop() keeps
+  core 1 for the motor. On one-core boards cores.poll() runs network()
+  from loop() instead.
+
+  Send 'p' over Serial to pause after the current revolution, 'r' to
+  resume.
+
 */
 
 #include <Stepper.h>
+#include <CoreSplit.h>
 
 const int stepsPerRevolution = 2048;  // change this to fit the number of steps per revolution
 const int rolePerMinute = 15;         // Adjustable range of 28BYJ-48 stepper is 0~17 rpm
-unsigned long previousMillis = 0;        // will store last time LED was updated
-const long interval = 5000;           // interval at which to blink (milliseconds)
+const unsigned long stepDelay = 60000000UL / stepsPerRevolution / rolePerMinute;  // us per step
+unsigned long previousMillis = 0;     // will store last time a revolution ended
+unsigned long previousStep = 0;       // micros() of the last step
+const long interval = 5000;           // pause between revolutions (milliseconds)
+
+// CoreSplit message types
+enum {
+  TURN_DONE,                          // loop() -> network: arg is the direction
+  PAUSE,                              // network -> loop()
+  RESUME                              // network -> loop()
+};
 
 // initialize the stepper library on pins 8 through 11:
 // For ESP32, pins are 33, 27, 12, 13
 Stepper myStepper(stepsPerRevolution, 33, 27, 12, 13);
+CoreSplit cores;
+
+long stepsLeft = 0;                   // Of the current revolution
+int direction = -1;                   // Of the last revolution
+bool paused = false;
+
+// Network side: reports finished revolutions and takes commands
+void network() {
+  CoreMessage m;
+  while (cores.receiveEvent(m)) {
+    if (m.type == TURN_DONE) {
+      Serial.println(m.arg > 0 ? "clockwise" : "counterclockwise");
+    }
+  }
+  while (Serial.available()) {
+    char c = Serial.read();
+    if (c == 'p') {
+      cores.sendCommand(PAUSE);
+    } else if (c == 'r') {
+      cores.sendCommand(RESUME);
+    }
+  }
+}
 
 void setup() {
   myStepper.setSpeed(rolePerMinute);
   // initialize the serial port:
   Serial.begin(9600);
+  cores.begin(network);
 }
 
 void loop() {
-    // Check to see if it's time to rotate the stepper motor
+  cores.poll();                       // only does work on one core
+  CoreMessage m;
+  while (cores.receiveCommand(m)) {
+    paused = (m.type == PAUSE);
+  }
+
   unsigned long currentMillis = millis();
+  if (!stepsLeft) {
+    // Check to see if it's time to rotate the stepper motor
+    if (paused || currentMillis - previousMillis < interval) {
+      return;
+    }
+    // Step one revolution, the other way from last time
+    direction = -direction;
+    stepsLeft = stepsPerRevolution;
+  }
 
-  if (currentMillis - previousMillis >= interval) {
-    // Save the last time the motor was rotated
-    previousMillis = currentMillis;
-} 
-// Step one revolution in one direction
-    Serial.println("clockwise");
-  myStepper.step(stepsPerRevolution);
-  
-// Step one revolution in the other direction
-  Serial.println("counterclockwise");
-  myStepper.step(-stepsPerRevolution);
+  unsigned long now = micros();
+  if (now - previousStep >= stepDelay) {
+    previousStep = now;
+    myStepper.step(direction);
+    if (--stepsLeft == 0) {
+      // Save the last time the motor was rotated
+      previousMillis = currentMillis;
+      cores.sendEvent(TURN_DONE, direction);
+    }
   }
+}